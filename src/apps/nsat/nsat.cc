@@ -2,27 +2,64 @@
 // File: nsat.cc
 //
 // Purpose: Front-end for the GRASP SAT algorithmic framework. Instances of
-//          CNF are specified in CNF format (from DIMACS).
+//          CNF are specified in CNF format (from DIMACS), or as circuits in
+//          AIGER format. Instances of MaxSAT are specified in wcnf format.
 //
-// Remarks: Eventually interactive use will be allowed.
+// Remarks: Without file names, or with option +U, nsat runs in on-line
+//          mode, ie serves the commands of its clients (see nsat_Server.hh).
+//          With option +E, nsat enumerates solutions (see nsat_Enum.hh),
+//          and with option +Y, it computes the backbone (see
+//          nsat_Backbone.hh).
 //
 // History: 06/16/95 - JPMS - created.
 //          03/17/96 - JPMS - repackaged for the new version of GRASP.
+//          10/19/26 - agent - circuits in AIGER format.
+//          10/19/26 - agent - cache of preprocessed instances.
+//          10/19/26 - agent - learnt clauses kept across runs.
+//          10/19/26 - agent - checkpoints of the search.
+//          10/19/26 - agent - on-line mode.
+//          10/19/26 - agent - SIGINT interrupts the search.
+//          10/19/26 - agent - MaxSAT mode.
+//          10/19/26 - agent - enumeration of projected solutions.
+//          10/19/26 - agent - backbone mode.
+//          10/19/26 - agent - solutions trimmed to minimal assignments.
+//          10/19/26 - agent - solutions not trimmed are reported.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <signal.h>
 #include <iostream.h>
 
 #include "time.hh"
 #include "memory.hh"
 #include "cnf_Parser.hh"
+#include "aig_Parser.hh"
 #include "grp_Cmds.hh"
 #include "grp_SAT.hh"
+#include "grp_Trim.hh"
+#include "nsat_Batch.hh"
+#include "nsat_Server.hh"
+#include "nsat_MaxSAT.hh"
+#include "nsat_Enum.hh"
+#include "nsat_Backbone.hh"
 
 
+//-----------------------------------------------------------------------------
+// Local functions. SIGINT interrupts the search, which reports its stats as
+// once limits are exceeded. SIGINT given again terminates nsat.
+//-----------------------------------------------------------------------------
+
+static SAT_Governor *interrupted_governor = NULL;
+
+static void catch_interrupt (int signo)
+{
+    interrupted_governor->interrupt();
+    signal (SIGINT, SIG_DFL);
+}
+
 
 //-----------------------------------------------------------------------------
 // Function: main
@@ -48,41 +85,118 @@ main( int argc, char *argv[] )
     SAT_Mode mode;                                    // Configuration of GRASP
     mode.setup();                                // Setup mode for future usage
 
+    SAT_Cache cache (mode);               // Outlives the names of variables
     SAT_ClauseDatabase database (mode);               // Create clause database
     GRASP_SAT sat (mode);                                // Create a SAT solver
     SAT_Cmds scmd  (mode);
+    SAT_Learnt learnt (mode);
+    SAT_Checkpoint checkpoint (mode);
+    SAT_Trimmer trimmer;
     CNF_Parser parser;
-
-    char *fname;
-    if( fname = scmd.cmdLineParse (argc, argv) ) {
-	DBG1(cout<<"Filename: "<<fname<<endl;);
-	if( !parser.load_CDB (fname, database) ) {
+    AIG_Parser aig_parser;
+
+    char *fname = scmd.cmdLineParse (argc, argv);
+    learnt.set_files (scmd.import_name(), scmd.export_name());
+    checkpoint.set_file (scmd.checkpoint_name());
+    parser.set_threads (mode[_LOAD_THREADS_]);
+    aig_parser.set_output (mode[_AIG_OUTPUT_]);
+    if (mode[_WRITE_IMAGE_]) {
+	ListItem<char*> *pname = scmd.file_names().first();
+	if (!pname || !pname->next()) {
+	    Abort("Option +I requires input and image file names");
+	}
+	if( !(AIG_Parser::is_aiger (fname) ?
+	      aig_parser.load_CDB (fname, database) :
+	      parser.load_CDB (fname, database)) ) {
 	    cout << "\n    File name: " << fname << endl;
 	    Abort("Cannot open input file");
 	}
+	if (!CNF_Image::write (pname->next()->data(), database, fname,
+			       mode[_WRITE_IMAGE_] == _CHECKED_IMAGE_)) {
+	    cout << "\n    File name: " << pname->next()->data() << endl;
+	    Abort("Cannot write image file");
+	}
+	printTime ("Done writing image", time.elapsedTime(), "Elapsed");
+    } else if (scmd.server_name() || !fname) {
+	ServerDriver server (mode);               // Serve commands on-line
+	server.run (scmd.server_name());
+    } else if (BatchDriver::is_batch (scmd.file_names())) {
+	BatchDriver batch (mode);                 // Solve instances in batch
+	ListItem<char*> *pname = scmd.file_names().first();
+	for (; pname; pname = pname->next()) {
+	    batch.add_path (pname->data());
+	}
+	batch.run (mode[_BATCH_WORKERS_]);
+    } else if (MaxSATDriver::is_maxsat (fname)) {
+	MaxSATDriver maxsat (mode);               // Optimize MaxSAT instance
+	interrupted_governor = &maxsat.governor();
+	signal (SIGINT, catch_interrupt);
+	maxsat.run (fname);
+	signal (SIGINT, SIG_DFL);
+    } else if (mode[_ENUM_LIMIT_] != NONE) {
+	EnumDriver enumerator (mode);             // Enumerate solutions
+	interrupted_governor = &enumerator.governor();
+	signal (SIGINT, catch_interrupt);
+	enumerator.run (fname);
+	signal (SIGINT, SIG_DFL);
+    } else if (mode[_BACKBONE_CHUNK_] != NONE) {
+	BackboneDriver backbone (mode);           // Compute backbone
+	interrupted_governor = &backbone.governor();
+	signal (SIGINT, catch_interrupt);
+	backbone.run (fname);
+	signal (SIGINT, SIG_DFL);
+    } else {
+	DBG1(cout<<"Filename: "<<fname<<endl;);
+	if (!cache.load_CDB (fname, database)) {
+	    if( !(AIG_Parser::is_aiger (fname) ?
+		  aig_parser.load_CDB (fname, database) :
+		  parser.load_CDB (fname, database)) ) {
+		cout << "\n    File name: " << fname << endl;
+		Abort("Cannot open input file");
+	    }
+	    cache.find_CDB (database);
+	}
+	sat.set_cache (&cache);
+	if (learnt.enabled()) {
+	    sat.set_learnt (&learnt);
+	}
+	if (checkpoint.enabled()) {
+	    sat.set_checkpoint (&checkpoint);
+	}
 	sat.setup (database);
 	sat.init (database);
 	printTime ("Done creating structures", time.elapsedTime(), "Elapsed");
 
+	interrupted_governor = &sat.governor();
+	signal (SIGINT, catch_interrupt);
 	int status = sat.solve (database); 	          // Solve SAT instance
+	signal (SIGINT, SIG_DFL);
 
 	if( status == SATISFIABLE ) {
 	    printTime ("Done searching.... SATISFIABLE INSTANCE",
 		       time.elapsedTime(), "Elapsed");
+	    int trimmed = FALSE;
 	    if (mode[_TRIM_SOLUTIONS_]) {
-		int tot_dec, req_dec;
-		if (database.can_trim_solution (tot_dec, req_dec)) {
-		    cout << "\n\tSolution can be trimmed from ";
-		    cout << tot_dec << " to " << req_dec << " decisions\n";
+		int size = trimmer.trim (database,
+					 (mode[_ELIM_THREADS_] != NONE) ?
+					 &sat.elimination_engine() : NULL);
+		trimmed = (size != NONE);
+		if (trimmed) {
+		    cout << "\n\tSolution trimmed from ";
+		    cout << trimmer.assigned_number() << " to ";
+		    cout << trimmer.literal_number() << " assignments\n";
 		    cout << endl;
-		}
-		else {
-		    cout << "\n\t Solution cannot be trimmed\n" << endl;
+		} else {
+		    Warn("Solution does not satisfy the clauses, not trimmed");
 		}
 	    }
 	    if (mode[_VERBOSE_]) {
 		Info("Solution found");
-		database.output_assignments (cout);
+		if (trimmed) {
+		    trimmer.output_assignments (cout);
+		} else {
+		    database.output_assignments (cout);
+		}
 	    }
 	} else if( status == UNSATISFIABLE ) {
 	    printTime ("Done searching.... UNSATISFIABLE INSTANCE",
@@ -98,12 +212,11 @@ main( int argc, char *argv[] )
 	    }
 	}
 
-	// Output relevant stats.
+	// Keep learnt clauses for later runs, then output relevant stats.
 
+	learnt.export_file (database);
 	sat.output_stats (database);
 	sat.reset (database);
-    } else {
-	Abort( "Unable to enter on-line mode... Under construction" );
     }
     printTime ("Terminating NSAT", time.totalTime(), "Total");
     CHECK(database.check_final_consistency(););
@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Backbone.cc
+//
+// Purpose: Member functions of the backbone driver of nsat.
+//
+// Remarks: --
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "time.hh"
+#include "cnf_Parser.hh"
+#include "aig_Parser.hh"
+#include "grp_CDB.hh"
+#include "nsat_Backbone.hh"
+
+
+//-----------------------------------------------------------------------------
+// Function: run()
+//
+// Purpose: Computes the backbone of the instance of a file, testing the
+//          number of candidates at once given by option Y.
+//
+// Side-effects: The backbone is printed, then the outcome and stats.
+//-----------------------------------------------------------------------------
+
+void BackboneDriver::run (char *fname)
+{
+    Timer time;
+    SAT_ClauseDatabase database (_mode);
+    CNF_Parser parser;
+    AIG_Parser aig_parser;
+    parser.set_threads (_mode[_LOAD_THREADS_]);
+    aig_parser.set_output (_mode[_AIG_OUTPUT_]);
+    if( !(AIG_Parser::is_aiger (fname) ?
+	  aig_parser.load_CDB (fname, database) :
+	  parser.load_CDB (fname, database)) ) {
+	cout << "\n    File name: " << fname << endl;
+	Abort("Cannot open input file");
+    }
+
+    // Variables are given to the engine as their IDs plus 1, which are the
+    // indices of CNF files.
+
+    _names.resize (database.variables().size() + 1);
+    VariableListPtr pvar;
+    for (pvar = database.variables().first(); pvar; pvar = pvar->next()) {
+	VariablePtr var = pvar->data();
+	_names[var->ID()+1] = var->name();
+    }
+    SAT_ClauseListPtr pcl;
+    for (pcl = (SAT_ClauseListPtr) database.clauses().first(); pcl;
+	 pcl = pcl->next()) {
+	SAT_ClausePtr cl = pcl->data();
+	for_each(plit, cl->literals(), LiteralPtr) {
+	    LiteralPtr lit = plit->data();
+	    int idx = lit->variable()->ID() + 1;
+	    _backbone.add ((lit->sign()) ? -idx : idx);
+	}
+	_backbone.add (0);
+    }
+    for (int k = 0; k < parser.projection_size(); k++) {
+	if (parser.projection (k) >= _names.size()) {
+	    Abort("Projection variable exceeds number of variables");
+	}
+	_backbone.restrict (parser.projection (k));
+    }
+    printTime ("Done creating structures", time.elapsedTime(), "Elapsed");
+
+    int status = _backbone.compute (_mode[_BACKBONE_CHUNK_]);
+
+    if (status == UNSATISFIABLE) {
+	printTime ("Done searching.... UNSATISFIABLE INSTANCE",
+		   time.elapsedTime(), "Elapsed");
+    } else if (status == SATISFIABLE) {
+	report();
+	printTime ("Done computing.... BACKBONE FOUND",
+		   time.elapsedTime(), "Elapsed");
+    } else {
+	report();
+	printTime ("Done computing.... RESOURCES EXCEEDED",
+		   time.elapsedTime(), "Elapsed");
+    }
+    printItem();
+    printItem ("Number of backbone literals", _backbone.backbone_size());
+    printItem ("Number of literals fixed at level 0",
+	       _backbone.fixed_number());
+    printItem ("Number of calls of the solver", _backbone.call_number());
+    printItem();
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: report()
+//
+// Purpose: Prints the literals of the backbone, with the names of their
+//          variables, in the order of the variables.
+//-----------------------------------------------------------------------------
+
+void BackboneDriver::report()
+{
+    int size = _backbone.backbone_size();
+    Array<int> values (_names.size());
+    for (int k = 0; k < _names.size(); k++) {
+	values[k] = UNKNOWN;
+    }
+    for (int k = 0; k < size; k++) {
+	int lit = _backbone.backbone_literal (k);
+	values[(lit > 0) ? lit : -lit] = (lit > 0);
+    }
+    for (int k = 1; k < _names.size(); k++) {
+	if (values[k] != UNKNOWN) {
+	    cout << ((values[k]) ? "b " : "b -") << _names[k] << endl;
+	}
+    }
+    cout << "b 0" << endl;
+}
+
+/*****************************************************************************/
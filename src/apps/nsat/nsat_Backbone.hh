@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Backbone.hh
+//
+// Purpose: Backbone mode of nsat. With option Y, the literals true in all
+//          the solutions of an instance are computed by one incremental
+//          solver (see grp_Backbone.hh), over the variables of its
+//          projection lines (see cnf_Parser.hh), if any.
+//
+// Remarks: The backbone is printed once computed, one literal per line
+//          "b <lit>", followed by a line "b 0".
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __NSAT_BACKBONE__
+#define __NSAT_BACKBONE__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_Backbone.hh"
+
+
+//-----------------------------------------------------------------------------
+// Class: BackboneDriver
+//
+// Purpose: Loads an instance into the backbone engine, and reports its
+//          backbone and stats.
+//
+// Notes: The instance is loaded into a clause database, as when solving,
+//        whose clauses are then given to the engine. Once the limits are
+//        exceeded, the literals found so far are printed.
+//-----------------------------------------------------------------------------
+
+class BackboneDriver {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    BackboneDriver (SAT_Mode &nmode) :
+	_mode (nmode), _backbone (nmode), _names(0) {}
+    virtual ~BackboneDriver() { _names.resize(0); }
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    virtual void run (char *fname);
+    inline SAT_Governor &governor() { return _backbone.governor(); }
+
+  protected:
+    virtual void report();                               // Prints the backbone
+
+    SAT_Mode &_mode;                                   // Configuration options
+    SAT_Backbone _backbone;
+    Array<char*> _names;                             // Variable names by index
+};
+
+#endif // __NSAT_BACKBONE__
+
+/*****************************************************************************/
@@ -0,0 +1,585 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Batch.cc
+//
+// Purpose: Member functions of the batch driver of nsat. The driver hands
+//          file names to the worker processes through pipes and reads back
+//          one outcome for each instance.
+//
+// Remarks: Each worker sets up the engines once, and then uses erase(),
+//          clear() and init() for switching to the next instance.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - prefetch of instances.
+//          10/19/26 - agent - cache of preprocessed instances.
+//          10/19/26 - agent - solver recycled between instances.
+//          10/19/26 - agent - CPU time measured by thread.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <iostream.h>
+
+#include "cnf_Parser.hh"
+#include "aig_Parser.hh"
+#include "grp_SAT.hh"
+#include "grp_Governor.hh"
+#include "nsat_Batch.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static char *copy_path (char *path)
+{
+    char *npath = new char[strlen (path)+1];
+    strcpy (npath, path);
+    return npath;
+}
+
+static int is_directory (char *path)
+{
+    struct stat st;
+    return (stat (path, &st) == 0 && S_ISDIR (st.st_mode));
+}
+
+static int read_line (int fd, char *line, int size)
+{
+    int length = 0;
+    char ch;
+    int n;
+    while ((n = read (fd, &ch, 1)) == 1 || (n < 0 && errno == EINTR)) {
+	if (n < 0) { continue; }
+	if (ch == '\n') {
+	    line[length] = '\0';
+	    return TRUE;
+	}
+	if (length < size-1) { line[length++] = ch; }
+    }
+    return FALSE;
+}
+
+static int line_ready (int fd)
+{
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return (poll (&pfd, 1, 0) > 0);
+}
+
+static void *load_thread (void *arg)
+{
+    ((BatchLoad*) arg)->load();
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+BatchDriver::BatchDriver (SAT_Mode &nmode) :
+_mode (nmode), _paths(), _workers(0)
+{
+    _solved_number = 0;
+    _failed_number = 0;
+}
+
+BatchDriver::~BatchDriver()
+{
+    ListItem<char*> *ppath;
+    while ((ppath = _paths.first())) {
+	delete[] ppath->data();
+	_paths.remove (ppath);
+    }
+    for (int k = 0; k < _workers.size(); k++) {
+	if (_workers[k]) { kill_worker (_workers[k]); delete _workers[k]; }
+    }
+    _workers.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: is_batch()
+//
+// Purpose: Batch execution is required if more than one file name is given,
+//          if a directory is given or if file names are read from stdin.
+//-----------------------------------------------------------------------------
+
+int BatchDriver::is_batch (List<char*> &names)
+{
+    if (names.size() > 1) {
+	return TRUE;
+    }
+    else if (names.size() == 1) {
+	char *name = names.first()->data();
+	return (!strcmp (name, STDIN_PATH) || is_directory (name));
+    }
+    return FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_path()
+//
+// Purpose: Schedules the instances denoted by path. The regular files of a
+//          directory are scheduled by alphabetical order.
+//
+// Notes: File names are only read from stdin when workers become available.
+//-----------------------------------------------------------------------------
+
+void BatchDriver::add_path (char *path)
+{
+    if (!strcmp (path, STDIN_PATH) || !is_directory (path)) {
+	_paths.append (copy_path (path));
+	return;
+    }
+    struct dirent **entries;
+    int entry_number = scandir (path, &entries, NULL, alphasort);
+    if (entry_number < 0) {
+	cout << "\n    Directory name: " << path << endl;
+	Warn("Cannot read directory");
+	return;
+    }
+    for (int k = 0; k < entry_number; k++) {
+	char fname[MAX_PATH_LENGTH];
+	if (entries[k]->d_name[0] != '.' &&
+	    snprintf (fname, sizeof (fname), "%s/%s", path,
+		      entries[k]->d_name) < (int) sizeof (fname)) {
+	    struct stat st;
+	    if (stat (fname, &st) == 0 && S_ISREG (st.st_mode)) {
+		_paths.append (copy_path (fname));
+	    }
+	}
+	free (entries[k]);
+    }
+    free (entries);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: run()
+//
+// Purpose: Solves all scheduled instances with (at most) the specified
+//          number of workers. If no number is given, one worker is used
+//          for each available processor.
+//
+// Side-effects: One line is printed for each instance, as soon as it is
+//               solved.
+//-----------------------------------------------------------------------------
+
+int BatchDriver::run (int workers)
+{
+    if (workers <= 0) {
+	workers = (int) sysconf (_SC_NPROCESSORS_ONLN);
+	if (workers <= 0) { workers = 1; }
+    }
+    signal (SIGPIPE, SIG_IGN);                  // Dead workers are detected
+    _workers.resize (workers);                  // when reading the outcome
+    for (int k = 0; k < workers; k++) {
+	_workers[k] = new BatchWorker();
+    }
+    int busy = 0;                               // Instances handed, not solved
+    for (int k = 0; k < workers; k++) {
+	busy += dispatch (_workers[k]);
+    }
+    struct pollfd *fds = new struct pollfd[workers];
+    BatchWorkerPtr *polled = new BatchWorkerPtr[workers];
+    while (busy) {
+	int fd_number = 0;
+	for (int k = 0; k < workers; k++) {
+	    if (_workers[k]->task()) {
+		fds[fd_number].fd = _workers[k]->result_fd();
+		fds[fd_number].events = POLLIN;
+		fds[fd_number].revents = 0;
+		polled[fd_number++] = _workers[k];
+	    }
+	}
+	if (poll (fds, fd_number, -1) < 0) {
+	    if (errno == EINTR) { continue; }
+	    Abort("Unable to wait for batch workers");
+	}
+	for (int k = 0; k < fd_number; k++) {
+	    if (fds[k].revents && collect (polled[k])) {
+		busy--;
+		busy += dispatch (polled[k]);
+	    }
+	}
+    }
+    delete[] fds;
+    delete[] polled;
+
+    for (int k = 0; k < workers; k++) {
+	kill_worker (_workers[k]);
+    }
+    if (_mode[_VERBOSE_]) {
+	printItem();
+	printItem ("Number of instances solved", _solved_number);
+	printItem ("Number of instances not solved", _failed_number);
+	printItem();
+    }
+    return _failed_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: next_instance()
+//
+// Purpose: Returns the next file name to be solved, or NULL if none exists.
+//-----------------------------------------------------------------------------
+
+char *BatchDriver::next_instance()
+{
+    ListItem<char*> *ppath;
+    while ((ppath = _paths.first())) {
+	char *path = ppath->data();
+	if (strcmp (path, STDIN_PATH)) {
+	    _paths.remove (ppath);
+	    return path;
+	}
+	char line[MAX_PATH_LENGTH];
+	if (cin.getline (line, MAX_PATH_LENGTH)) {
+	    int length = strlen (line);
+	    while (length && (line[length-1] == ' ' || line[length-1] == '\t' ||
+			      line[length-1] == '\r')) {
+		line[--length] = '\0';
+	    }
+	    if (length) {
+		return copy_path (line);
+	    }
+	}
+	else {                                   // No more file names in stdin
+	    _paths.remove (ppath);
+	    delete[] path;
+	}
+    }
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: spawn_worker()
+//
+// Purpose: Creates a worker process, connected to the driver by two pipes.
+//
+// Notes: The worker closes the pipes of the other workers. Otherwise,
+//        these workers would not terminate when their pipes are closed.
+//-----------------------------------------------------------------------------
+
+void BatchDriver::spawn_worker (BatchWorkerPtr worker)
+{
+    int task_pipe[2];
+    int result_pipe[2];
+    if (pipe (task_pipe) < 0 || pipe (result_pipe) < 0) {
+	Abort("Unable to create pipes for batch worker");
+    }
+    cout << flush;
+    int pid = fork();
+    if (pid < 0) {
+	Abort("Unable to create batch worker");
+    }
+    else if (pid == 0) {                                      // Worker process
+	for (int k = 0; k < _workers.size(); k++) {
+	    if (_workers[k] != worker && _workers[k]->pid() != NONE) {
+		close (_workers[k]->task_fd());
+		close (_workers[k]->result_fd());
+	    }
+	}
+	close (task_pipe[1]);
+	close (result_pipe[0]);
+	worker_loop (task_pipe[0], result_pipe[1]);
+	_exit (0);
+    }
+    close (task_pipe[0]);
+    close (result_pipe[1]);
+    worker->pid() = pid;
+    worker->task_fd() = task_pipe[1];
+    worker->result_fd() = result_pipe[0];
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: kill_worker()
+//
+// Purpose: Closes the pipes of a worker, which then terminates.
+//-----------------------------------------------------------------------------
+
+void BatchDriver::kill_worker (BatchWorkerPtr worker)
+{
+    if (worker->pid() != NONE) {
+	close (worker->task_fd());
+	close (worker->result_fd());
+	waitpid (worker->pid(), NULL, 0);
+	worker->pid() = NONE;
+	worker->task_fd() = worker->result_fd() = NONE;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: dispatch()
+//
+// Purpose: Hands the next instances to a worker, ie one instance to solve
+//          and, with prefetch, the instance to load while solving it.
+//          Returns the number of instances handed.
+//
+// Side-effects: Dead workers are replaced, and are handed again the
+//               instance that was being solved, if it was not reported.
+//-----------------------------------------------------------------------------
+
+int BatchDriver::dispatch (BatchWorkerPtr worker)
+{
+    if (worker->pid() == NONE && worker->task()) {
+	spawn_worker (worker);
+	send_task (worker, worker->task());
+    }
+    int handed = 0;
+    while (!worker->task() ||
+	   (_mode[_PREFETCH_] && !worker->solo() && !worker->next_task())) {
+	char *fname = next_instance();
+	if (!fname) {
+	    break;
+	}
+	if (worker->pid() == NONE) {
+	    spawn_worker (worker);
+	}
+	if (!worker->task()) {
+	    worker->task() = fname;
+	    worker->length() = 0;
+	}
+	else {
+	    worker->next_task() = fname;
+	}
+	send_task (worker, fname);
+	handed++;
+    }
+    return handed;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: send_task()
+//
+// Purpose: Writes a file name to the task pipe of a worker.
+//-----------------------------------------------------------------------------
+
+void BatchDriver::send_task (BatchWorkerPtr worker, char *fname)
+{
+    write (worker->task_fd(), fname, strlen (fname));
+    write (worker->task_fd(), "\n", 1);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: collect()
+//
+// Purpose: Reads the outcome of a worker. Returns TRUE if the outcome is
+//          complete or if the worker died, ie if one instance is no longer
+//          handed to the worker.
+//
+// Notes: The instance being prefetched, if any, becomes the instance being
+//        solved. If the worker dies while prefetching, the instance being
+//        prefetched is scheduled again, and the instance being solved is
+//        solved again without prefetch. Outcomes are read one char
+//        at a time, since the next outcome may already be in the pipe. Reads
+//        do not block within an outcome, as it is written at once.
+//-----------------------------------------------------------------------------
+
+int BatchDriver::collect (BatchWorkerPtr worker)
+{
+    char *buffer = worker->buffer();
+    int n;
+    do {                         // Next outcome may follow, if prefetching
+	n = read (worker->result_fd(), buffer + worker->length(), 1);
+    } while (n > 0 && buffer[worker->length()++] != '\n' &&
+	     worker->length() < MAX_PATH_LENGTH-1);
+    if (n < 0 && errno == EINTR) {
+	return FALSE;
+    }
+    if (n > 0) {
+	buffer[worker->length()] = '\0';
+	cout << worker->task() << " " << buffer << flush;
+
+	if (!strncmp (buffer, "SATISFIABLE", 11) ||
+	    !strncmp (buffer, "UNSATISFIABLE", 13)) { _solved_number++; }
+	else                                         { _failed_number++; }
+    }
+    else if (worker->next_task()) {       // Either instance may have killed it
+	kill_worker (worker);
+	_paths.prepend (worker->next_task());
+	worker->next_task() = NULL;
+	worker->solo() = TRUE;                 // Instance is solved again alone
+	worker->length() = 0;
+	return TRUE;
+    }
+    else {                             // Worker died while solving instance
+	cout << worker->task() << " ERROR -" << endl;
+	_failed_number++;
+	kill_worker (worker);
+    }
+    delete[] worker->task();
+    worker->task() = worker->next_task();
+    worker->next_task() = NULL;
+    worker->solo() = FALSE;
+    worker->length() = 0;
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: worker_loop()
+//
+// Purpose: Solves the instances handed by the driver, until the task pipe
+//          is closed. The engines are reused for all instances, and each of
+//          the two clause databases for every other instance.
+//
+// Notes: The outcome is written with a single write(), and so it is never
+//        interleaved with the outcomes of other workers. With prefetch,
+//        the next instance is loaded only after the engines are set up for
+//        the current one, such that the engines no longer use the pool of
+//        the database being loaded.
+//-----------------------------------------------------------------------------
+
+void BatchDriver::worker_loop (int task_fd, int result_fd)
+{
+    SAT_Cache cache (_mode);              // Outlive the names of variables
+    SAT_Cache next_cache (_mode);
+    SAT_ClauseDatabase database (_mode);
+    SAT_ClauseDatabase next_database (_mode);
+    GRASP_SAT sat (_mode);
+    CNF_Parser parsers[2];
+    AIG_Parser aig_parsers[2];
+    BatchLoad loads[2];
+    for (int k = 0; k < 2; k++) {
+	parsers[k].set_threads (_mode[_LOAD_THREADS_]);
+	aig_parsers[k].set_output (_mode[_AIG_OUTPUT_]);
+	loads[k].database() = (k == 0) ? &database : &next_database;
+	loads[k].parser() = &parsers[k];
+	loads[k].aig_parser() = &aig_parsers[k];
+	loads[k].cache() = (k == 0) ? &cache : &next_cache;
+    }
+    char outcome[MAX_PATH_LENGTH];
+
+    int cur = 0;
+    int pending = read_line (task_fd, loads[cur].fname(), MAX_PATH_LENGTH);
+    if (pending) {
+	loads[cur].load();
+    }
+    while (pending) {
+	BatchLoad &load = loads[cur];
+	BatchLoad &next = loads[1-cur];
+	SAT_ClauseDatabase &clDB = *load.database();
+	const char *result = "ERROR";
+	double start = SAT_Governor::thread_clock();
+
+	if (load.loaded()) {
+	    sat.setup (clDB);                    // Engines allocated once
+	    sat.clear (clDB);
+	    sat.init (clDB);
+	}
+	int prefetch = (_mode[_PREFETCH_] && line_ready (task_fd) &&
+			read_line (task_fd, next.fname(), MAX_PATH_LENGTH));
+	if (prefetch) {
+	    next.start();
+	}
+	if (load.loaded()) {
+	    sat.set_cache (load.cache());
+	    int status = sat.solve (clDB);
+	    result = (status == SATISFIABLE) ? "SATISFIABLE" :
+		(status == UNSATISFIABLE) ? "UNSATISFIABLE" : "ABORTED";
+	    sat.recycle (clDB);
+	} else {
+	    clDB.erase();
+	}
+
+	double cpu = load.load_time() + SAT_Governor::thread_clock() - start;
+	sprintf (outcome, "%s %.3f\n", result, cpu);
+	write (result_fd, outcome, strlen (outcome));
+
+	if (prefetch) {
+	    next.finish();
+	}
+	else if (read_line (task_fd, next.fname(), MAX_PATH_LENGTH)) {
+	    next.load();
+	}
+	else {
+	    pending = FALSE;
+	}
+	cur = 1-cur;
+    }
+    close (task_fd);
+    close (result_fd);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: load()
+//
+// Purpose: Loads the instance named fname() into the clause database,
+//          from the cache if the instance has an entry.
+//
+// Side-effects: The CPU time of the running thread is kept as load time.
+//
+// Notes: Items are allocated from the pool of the database, since the
+//        default pool may be used by another thread.
+//-----------------------------------------------------------------------------
+
+void BatchLoad::load()
+{
+    MEM_POOL_SCOPE(_database->pool());
+    double start = SAT_Governor::thread_clock();
+    _loaded = _cache->load_CDB (_fname, *_database);
+    if (!_loaded) {
+	_loaded = (AIG_Parser::is_aiger (_fname)) ?
+	    _aig_parser->load_CDB (_fname, *_database) :
+	    _parser->load_CDB (_fname, *_database);
+	if (_loaded) {
+	    _cache->find_CDB (*_database);
+	}
+    }
+    _load_time = SAT_Governor::thread_clock() - start;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: start()
+//
+// Purpose: Creates a thread for loading the instance.
+//-----------------------------------------------------------------------------
+
+void BatchLoad::start()
+{
+    _loaded = FALSE;
+    _running = !pthread_create (&_thread, NULL, load_thread, (void*) this);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: finish()
+//
+// Purpose: Waits for the thread loading the instance. If the thread could
+//          not be created, the instance is loaded instead.
+//-----------------------------------------------------------------------------
+
+void BatchLoad::finish()
+{
+    if (_running) {
+	pthread_join (_thread, NULL);
+	_running = FALSE;
+    }
+    else {
+	load();
+    }
+}
+
+/*****************************************************************************/
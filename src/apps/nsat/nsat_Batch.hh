@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Batch.hh
+//
+// Purpose: Batch execution of nsat. A (possibly large) number of instances
+//          of SAT is solved by a fixed-size pool of workers, each of which
+//          reuses its clause database and engines between instances.
+//
+// Remarks: Workers are processes and not threads, such that an instance
+//          that aborts (or crashes) the solver does not affect the other
+//          workers. With prefetch, each worker is handed two instances,
+//          and loads the second one with a thread while solving the first.
+//          Workers given the same image of a CNF formula share the pages
+//          of the image, but each one builds its own clause database from
+//          it, ie the memory of the formula is not shared by the workers.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - prefetch of instances.
+//          10/19/26 - agent - cache of preprocessed instances.
+//          10/19/26 - agent - CPU time of the threads loading instances.
+//-----------------------------------------------------------------------------
+
+#ifndef __NSAT_BATCH__
+#define __NSAT_BATCH__
+
+#include <pthread.h>
+
+#include "defs.hh"
+#include "array.hh"
+#include "list.hh"
+#include "grp_Mode.hh"
+
+class SAT_ClauseDatabase;
+class CNF_Parser;
+class AIG_Parser;
+class SAT_Cache;
+
+
+//-----------------------------------------------------------------------------
+// Defines for batch execution.
+//-----------------------------------------------------------------------------
+
+# define MAX_PATH_LENGTH    1024
+# define STDIN_PATH         "-"
+
+
+//-----------------------------------------------------------------------------
+// Class: BatchWorker
+//
+// Purpose: Information kept by the driver about each worker process.
+//-----------------------------------------------------------------------------
+
+class BatchWorker {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    BatchWorker() { _pid = NONE; _task_fd = _result_fd = NONE; _task = NULL;
+		    _next_task = NULL; _solo = FALSE; _length = 0; }
+    virtual ~BatchWorker() {
+	if (_task) { delete[] _task; }
+	if (_next_task) { delete[] _next_task; }
+    }
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    inline int &pid() { return _pid; }
+    inline int &task_fd() { return _task_fd; }
+    inline int &result_fd() { return _result_fd; }
+    inline char *&task() { return _task; }
+    inline char *&next_task() { return _next_task; }
+    inline int &solo() { return _solo; }
+    inline int &length() { return _length; }
+    inline char *buffer() { return _buffer; }
+
+  protected:
+
+    int _pid;                                 // Process ID, or NONE if dead
+    int _task_fd;                             // Pipe for sending file names
+    int _result_fd;                           // Pipe for receiving outcomes
+    char *_task;                              // Instance being solved, if any
+    char *_next_task;                         // Instance being prefetched
+    int _solo;                                // Whether prefetch is disabled
+    char _buffer[MAX_PATH_LENGTH];            // Outcome read from the worker
+    int _length;                              // Number of chars in _buffer
+};
+
+typedef BatchWorker *BatchWorkerPtr;
+
+
+//-----------------------------------------------------------------------------
+// Class: BatchLoad
+//
+// Purpose: Loading of an instance into a clause database of a worker,
+//          possibly by a thread while another instance is solved.
+//
+// Notes: Each load has its own parsers, since parsers are not shared by
+//        threads. The CPU time of the load is that of the thread which
+//        loads the instance, ie not of the threads scanning chunks.
+//-----------------------------------------------------------------------------
+
+class BatchLoad {
+  public:
+    BatchLoad() { _database = NULL; _parser = NULL; _aig_parser = NULL;
+		  _cache = NULL; _fname[0] = '\0';
+		  _loaded = _running = FALSE; _load_time = 0.0; }
+    virtual ~BatchLoad() {}
+
+    inline SAT_ClauseDatabase *&database() { return _database; }
+    inline CNF_Parser *&parser() { return _parser; }
+    inline AIG_Parser *&aig_parser() { return _aig_parser; }
+    inline SAT_Cache *&cache() { return _cache; }
+    inline char *fname() { return _fname; }
+    inline int loaded() { return _loaded; }
+    inline double load_time() { return _load_time; }    // CPU time, in seconds
+
+    virtual void load();                 // Loads the instance named fname()
+    virtual void start();               // Loads the instance with a thread
+    virtual void finish();                 // Waits for the thread, if any
+
+  protected:
+    SAT_ClauseDatabase *_database;
+    CNF_Parser *_parser;
+    AIG_Parser *_aig_parser;
+    SAT_Cache *_cache;
+    char _fname[MAX_PATH_LENGTH];
+    int _loaded;                              // Whether instance was loaded
+    int _running;                             // Whether thread was created
+    double _load_time;
+    pthread_t _thread;
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: BatchDriver
+//
+// Purpose: Dispatches instances of SAT to the workers and prints one line
+//          for each solved instance, ie file name, outcome and CPU time.
+//
+// Notes: The CPU time of an instance is that of its load, plus that of the
+//        worker's main thread while solving it. Hence the thread that
+//        prefetches the next instance is not counted.
+//-----------------------------------------------------------------------------
+
+class BatchDriver {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    BatchDriver (SAT_Mode &nmode);
+    virtual ~BatchDriver();
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    static int is_batch (List<char*> &names);    // Batch execution required?
+
+    virtual void add_path (char *path);    // File, directory or STDIN_PATH
+    virtual int run (int workers);       // Returns number of failed instances
+
+  protected:
+
+    //-------------------------------------------------------------------------
+    // Functions used by the driver (parent) process.
+    //-------------------------------------------------------------------------
+
+    virtual char *next_instance();
+    virtual void spawn_worker (BatchWorkerPtr worker);
+    virtual void kill_worker (BatchWorkerPtr worker);
+    virtual int dispatch (BatchWorkerPtr worker);
+    virtual void send_task (BatchWorkerPtr worker, char *fname);
+    virtual int collect (BatchWorkerPtr worker);
+
+    //-------------------------------------------------------------------------
+    // Function executed by each worker process.
+    //-------------------------------------------------------------------------
+
+    virtual void worker_loop (int task_fd, int result_fd);
+
+    //-------------------------------------------------------------------------
+    // Internal variable definition.
+    //-------------------------------------------------------------------------
+
+    SAT_Mode &_mode;                                   // Configuration options
+
+    List<char*> _paths;                  // Instances (or STDIN_PATH) to solve
+    Array<BatchWorkerPtr> _workers;
+
+  protected:                                   // Variables for stats gathering
+    int _solved_number;
+    int _failed_number;
+
+  private:
+
+};
+
+#endif // __NSAT_BATCH__
+
+/*****************************************************************************/
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Enum.cc
+//
+// Purpose: Member functions of the enumeration driver of nsat.
+//
+// Remarks: --
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "time.hh"
+#include "cnf_Parser.hh"
+#include "aig_Parser.hh"
+#include "grp_CDB.hh"
+#include "nsat_Enum.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static void report_solution (void *state, int *lits, int size)
+{
+    ((EnumDriver*) state)->report (lits, size);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: run()
+//
+// Purpose: Enumerates the solutions of the instance of a file, up to the
+//          limit given by option E.
+//
+// Side-effects: Solutions are printed as found, then the outcome and stats.
+//-----------------------------------------------------------------------------
+
+void EnumDriver::run (char *fname)
+{
+    Timer time;
+    SAT_ClauseDatabase database (_mode);
+    CNF_Parser parser;
+    AIG_Parser aig_parser;
+    parser.set_threads (_mode[_LOAD_THREADS_]);
+    aig_parser.set_output (_mode[_AIG_OUTPUT_]);
+    if( !(AIG_Parser::is_aiger (fname) ?
+	  aig_parser.load_CDB (fname, database) :
+	  parser.load_CDB (fname, database)) ) {
+	cout << "\n    File name: " << fname << endl;
+	Abort("Cannot open input file");
+    }
+
+    // Variables are given to the enumerator as their IDs plus 1, which are
+    // the indices of CNF files.
+
+    _names.resize (database.variables().size() + 1);
+    VariableListPtr pvar;
+    for (pvar = database.variables().first(); pvar; pvar = pvar->next()) {
+	VariablePtr var = pvar->data();
+	_names[var->ID()+1] = var->name();
+    }
+    SAT_ClauseListPtr pcl;
+    for (pcl = (SAT_ClauseListPtr) database.clauses().first(); pcl;
+	 pcl = pcl->next()) {
+	SAT_ClausePtr cl = pcl->data();
+	for_each(plit, cl->literals(), LiteralPtr) {
+	    LiteralPtr lit = plit->data();
+	    int idx = lit->variable()->ID() + 1;
+	    _enum.add ((lit->sign()) ? -idx : idx);
+	}
+	_enum.add (0);
+    }
+    for (int k = 0; k < parser.projection_size(); k++) {
+	if (parser.projection (k) >= _names.size()) {
+	    Abort("Projection variable exceeds number of variables");
+	}
+	_enum.project (parser.projection (k));
+    }
+    if (!parser.projection_size()) {
+	for (int k = 1; k < _names.size(); k++) {
+	    _enum.project (k);
+	}
+    }
+    printTime ("Done creating structures", time.elapsedTime(), "Elapsed");
+
+    _enum.set_report ((void*) this, report_solution);
+    int status = _enum.enumerate (_mode[_ENUM_LIMIT_]);
+
+    if (status == UNSATISFIABLE && !_enum.solution_number()) {
+	printTime ("Done searching.... UNSATISFIABLE INSTANCE",
+		   time.elapsedTime(), "Elapsed");
+    } else if (status == UNSATISFIABLE) {
+	printTime ("Done enumerating.... ALL SOLUTIONS FOUND",
+		   time.elapsedTime(), "Elapsed");
+    } else if (status == SATISFIABLE) {
+	printTime ("Done enumerating.... SOLUTION LIMIT REACHED",
+		   time.elapsedTime(), "Elapsed");
+    } else {
+	printTime ("Done enumerating.... RESOURCES EXCEEDED",
+		   time.elapsedTime(), "Elapsed");
+    }
+    printItem();
+    printItem ("Number of solutions enumerated", _enum.solution_number());
+    printItem ("Number of projected models", _enum.model_number());
+    printItem();
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: report()
+//
+// Purpose: Prints a solution, with the names of its variables.
+//-----------------------------------------------------------------------------
+
+void EnumDriver::report (int *lits, int size)
+{
+    cout << "v";
+    for (int k = 0; k < size; k++) {
+	int idx = (lits[k] > 0) ? lits[k] : -lits[k];
+	cout << ((lits[k] > 0) ? " " : " -") << _names[idx];
+    }
+    cout << " 0" << endl;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,62 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Enum.hh
+//
+// Purpose: Enumeration mode of nsat. With option E, the solutions of an
+//          instance, projected onto the variables of its projection lines
+//          (see cnf_Parser.hh), are enumerated by one incremental solver
+//          (see grp_Enum.hh).
+//
+// Remarks: Each solution is printed once found, as a line "v <lits> 0" of
+//          the variables of a partial assignment, whose extensions to the
+//          other projection variables are all solutions.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __NSAT_ENUM__
+#define __NSAT_ENUM__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_Enum.hh"
+
+
+//-----------------------------------------------------------------------------
+// Class: EnumDriver
+//
+// Purpose: Loads an instance into the enumerator, and reports its solutions
+//          and stats.
+//
+// Notes: The instance is loaded into a clause database, as when solving,
+//        whose clauses are then given to the enumerator. Without projection
+//        lines, all the variables are projected.
+//-----------------------------------------------------------------------------
+
+class EnumDriver {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    EnumDriver (SAT_Mode &nmode) : _mode (nmode), _enum (nmode), _names(0) {}
+    virtual ~EnumDriver() { _names.resize(0); }
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    virtual void run (char *fname);
+    virtual void report (int *lits, int size);             // Prints a solution
+    inline SAT_Governor &governor() { return _enum.governor(); }
+
+  protected:
+    SAT_Mode &_mode;                                   // Configuration options
+    SAT_Enumerator _enum;
+    Array<char*> _names;                             // Variable names by index
+};
+
+#endif // __NSAT_ENUM__
+
+/*****************************************************************************/
@@ -0,0 +1,117 @@
+//-----------------------------------------------------------------------------
+// File: nsat_MaxSAT.cc
+//
+// Purpose: Member functions of the MaxSAT driver of nsat.
+//
+// Remarks: --
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "time.hh"
+#include "wcnf_Parser.hh"
+#include "nsat_MaxSAT.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static void report_cost (void *state, long cost)
+{
+    cout << "o " << cost << endl;
+}
+
+static void print_weight (const char *str, long weight)  // As printItem() does
+{
+    cout << "  ";
+    cout.setf(ios::left,ios::adjustfield);
+    cout.width(60);
+    cout.fill(' ');
+    cout << str;
+    cout.setf(ios::right,ios::adjustfield);
+    cout.width(10);
+    cout << weight << endl;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: is_maxsat()
+//
+// Purpose: Returns TRUE if the file is a MaxSAT instance, ie its name has
+//          the extension .wcnf.
+//-----------------------------------------------------------------------------
+
+int MaxSATDriver::is_maxsat (char *fname)
+{
+    return WCNF_Parser::is_wcnf (fname);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: run()
+//
+// Purpose: Optimizes the MaxSAT instance of a file.
+//
+// Side-effects: The outcome is printed, and the best solution found if
+//               verbose, as a line "v <lits>".
+//-----------------------------------------------------------------------------
+
+void MaxSATDriver::run (char *fname)
+{
+    Timer time;
+    WCNF_Parser parser;
+    if (!parser.load (fname, _maxsat)) {
+	cout << "\n    File name: " << fname << endl;
+	Abort("Cannot open input file");
+    }
+    printTime ("Done creating structures", time.elapsedTime(), "Elapsed");
+
+    _maxsat.set_report (NULL, report_cost);
+    int status = _maxsat.solve();
+
+    if (status == SATISFIABLE) {
+	printTime ("Done searching.... OPTIMUM FOUND",
+		   time.elapsedTime(), "Elapsed");
+    } else if (status == UNSATISFIABLE) {
+	printTime ("Done searching.... UNSATISFIABLE INSTANCE",
+		   time.elapsedTime(), "Elapsed");
+    } else {
+	printTime ("Done searching.... RESOURCES EXCEEDED",
+		   time.elapsedTime(), "Elapsed");
+    }
+    if (_mode[_VERBOSE_] && _maxsat.cost() != NONE) {
+	Info("Best solution found");
+	cout << "v";
+	for (int k = 1; k <= _maxsat.variable_number(); k++) {
+	    cout << " " << ((_maxsat.value (k) == FALSE) ? -k : k);
+	}
+	cout << endl;
+    }
+    output_stats();
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: output_stats()
+//
+// Purpose: Prints the bounds on the cost, and the stats of the search.
+//-----------------------------------------------------------------------------
+
+void MaxSATDriver::output_stats()
+{
+    printItem();
+    if (_maxsat.cost() != NONE) {
+	print_weight ("Cost of best solution", _maxsat.cost());
+    }
+    print_weight ("Lower bound on cost", _maxsat.lower_bound());
+    printItem ("Number of soft clauses", _maxsat.soft_number());
+    printItem ("Number of cores", _maxsat.core_number());
+    printItem();
+}
+
+/*****************************************************************************/
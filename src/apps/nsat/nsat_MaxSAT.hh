@@ -0,0 +1,58 @@
+//-----------------------------------------------------------------------------
+// File: nsat_MaxSAT.hh
+//
+// Purpose: MaxSAT mode of nsat. Instances in wcnf format are optimized by
+//          the core-guided MaxSAT engine of GRASP (see grp_MaxSAT.hh).
+//
+// Remarks: The cost of each better solution is reported as found, on a
+//          line "o <cost>", hence the best solution is known even if the
+//          search is later interrupted.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __NSAT_MAXSAT__
+#define __NSAT_MAXSAT__
+
+#include "defs.hh"
+#include "grp_Mode.hh"
+#include "grp_MaxSAT.hh"
+
+
+//-----------------------------------------------------------------------------
+// Class: MaxSATDriver
+//
+// Purpose: Loads a wcnf file into the MaxSAT engine, optimizes it, and
+//          reports the outcome and stats.
+//
+// Notes: The limits of nsat apply to the whole optimization.
+//-----------------------------------------------------------------------------
+
+class MaxSATDriver {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    MaxSATDriver (SAT_Mode &nmode) : _mode (nmode), _maxsat (nmode) {}
+    virtual ~MaxSATDriver() {}
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    static int is_maxsat (char *fname);                 // Whether file is wcnf
+    virtual void run (char *fname);
+    inline SAT_Governor &governor() { return _maxsat.governor(); }
+
+  protected:
+    virtual void output_stats();
+
+    SAT_Mode &_mode;                                   // Configuration options
+    SAT_MaxSAT _maxsat;
+};
+
+#endif // __NSAT_MAXSAT__
+
+/*****************************************************************************/
@@ -0,0 +1,652 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Server.cc
+//
+// Purpose: Member functions of the on-line mode of nsat, ie of the sessions
+//          serving the commands of clients and of the driver creating them.
+//
+// Remarks: Commands are read with getline(), hence lines of any length are
+//          accepted. Each answer is written at once, when the command is
+//          served. Files loaded are read by CNF_Parser, as in other modes.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - files loaded by the CNF parser.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <iostream.h>
+
+#include "memory.hh"
+#include "grp_Cmds.hh"
+#include "grp_Incr.hh"
+#include "cnf_Parser.hh"
+#include "nsat_Server.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static double wall_time()
+{
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static int is_blank (char ch)
+{
+    return (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n');
+}
+
+static char *next_word (char *&pos)                   // Word is ended in place
+{
+    while (is_blank (*pos)) { pos++; }
+    char *word = pos;
+    while (*pos && !is_blank (*pos)) { pos++; }
+    if (*pos) { *pos++ = '\0'; }
+    return word;
+}
+
+static void copy_options (SAT_Mode &from, SAT_Mode &to, int all)
+{
+    for (int k = 0; k < SAT_OPTION_NUMBER; k++) {
+	switch (k) {
+	  case _BACKTRACK_LIMIT_:             // Not used by incremental solver
+	  case _CONFLICT_LIMIT_:
+	  case _TIME_LIMIT_:
+	  case _SPACE_LIMIT_:
+	  case _PREPROC_LEVEL_:
+	  case _ELIM_THREADS_:
+	  case _LOCAL_THREADS_:
+	  case _WALL_LIMIT_:
+	  case _MEMORY_LIMIT_:
+	    if (all) { to[k] = from[k]; }
+	    break;
+	  default:
+	    to[k] = from[k];
+	}
+    }
+}
+
+static int session_terminate (void *state)
+{
+    return ((ServerSessionPtr) state)->expired();
+}
+
+static void *session_thread (void *arg)
+{
+    ServerSessionPtr session = (ServerSessionPtr) arg;
+    session->run();
+    delete session;
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+ServerSession::ServerSession (SAT_Mode &nmode, int in_fd, int out_fd) :
+_mode (nmode), _options(), _lits(0), _assumed(0), _last_assumed(0),
+_reply(0)
+{
+    _options.setup();
+    _solver = NULL;
+    _in_fd = in_fd;
+    _out_fd = out_fd;
+    _solved = FALSE;
+    _outcome = NONE;
+    _lit_number = 0;
+    _assumed_number = 0;
+    _last_number = 0;
+    _conflict_limit = 0;
+    _time_limit = 0;
+    _deadline = 0.0;
+    _reply_length = 0;
+    _parser = new CNF_Parser();
+}
+
+ServerSession::~ServerSession()
+{
+    if (_solver) { delete _solver; }
+    delete _parser;
+    _lits.resize (0);
+    _assumed.resize (0);
+    _last_assumed.resize (0);
+    _reply.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: run()
+//
+// Purpose: Serves the commands of the client, until it quits or closes its
+//          end of the session. Both descriptors are closed afterwards.
+//
+// Notes: The session is bound to its own pool, since the default pool is
+//        not shared by threads. The solver is created and deleted while
+//        bound to it.
+//-----------------------------------------------------------------------------
+
+void ServerSession::run()
+{
+    MemPool pool;
+    MEM_POOL_SCOPE(pool);
+
+    FILE *in = fdopen (_in_fd, "r");
+    if (!in) {
+	close (_in_fd);
+	if (_out_fd != _in_fd) { close (_out_fd); }
+	return;
+    }
+    clear (FALSE);
+    char *line = NULL;
+    size_t size = 0;
+    int length;
+    int active = TRUE;
+    while (active && (length = getline (&line, &size, in)) >= 0) {
+	while (length && is_blank (line[length-1])) {
+	    line[--length] = '\0';
+	}
+	active = serve (line);
+	flush_reply();
+    }
+    free (line);
+    delete _solver;
+    _solver = NULL;
+    fclose (in);
+    if (_out_fd != _in_fd) { close (_out_fd); }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: expired()
+//
+// Purpose: Tells the solver whether the time limit of the running solve
+//          expired, ie whether the search must be aborted.
+//-----------------------------------------------------------------------------
+
+int ServerSession::expired()
+{
+    return (_deadline > 0.0 && wall_time() > _deadline);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: serve()
+//
+// Purpose: Serves one command. Lines starting with a literal are clauses,
+//          and are only answered if invalid.
+//-----------------------------------------------------------------------------
+
+int ServerSession::serve (char *line)
+{
+    while (is_blank (*line)) { line++; }
+    if (*line == '-' || isdigit (*line)) {
+	if (!add_literals (line)) {
+	    reply ("error invalid literal");
+	}
+	return TRUE;
+    }
+    char *args = line;
+    char *cmd = next_word (args);
+
+    if (!*cmd || !strcmp (cmd, "c") || !strcmp (cmd, "p")) {
+	return TRUE;
+    }
+    else if (!strcmp (cmd, "load")) {
+	load (args);
+    }
+    else if (!strcmp (cmd, "add")) {
+	reply ((add_literals (args)) ? "ok" : "error invalid literal");
+    }
+    else if (!strcmp (cmd, "assume")) {
+	if (!read_literals (args)) {
+	    reply ("error invalid literal");
+	    return TRUE;
+	}
+	for (int k = 0; k < _lit_number; k++) {
+	    if (!_lits[k]) { continue; }
+	    if (_assumed_number >= _assumed.size()) {
+		_assumed.resize ((_assumed.size()) ? 2*_assumed.size() : 16);
+	    }
+	    _assumed[_assumed_number++] = _lits[k];
+	}
+	reply ("ok");
+    }
+    else if (!strcmp (cmd, "push") || !strcmp (cmd, "pop")) {
+	char *name = next_word (args);
+	int groups = (!strcmp (cmd, "push")) ? _solver->push (name) :
+	    _solver->pop ((*name) ? name : (char*) NULL);
+	reply ("ok");
+	reply_literal (groups);
+    }
+    else if (!strcmp (cmd, "limit")) {
+	set_limit (args);
+    }
+    else if (!strcmp (cmd, "option")) {
+	set_options (args);
+    }
+    else if (!strcmp (cmd, "solve")) {
+	solve (args);
+    }
+    else if (!strcmp (cmd, "model")) {
+	model();
+    }
+    else if (!strcmp (cmd, "core")) {
+	core (args);
+    }
+    else if (!strcmp (cmd, "reset")) {
+	clear (FALSE);
+	reply ("ok");
+    }
+    else if (!strcmp (cmd, "quit")) {
+	reply ("ok");
+	return FALSE;
+    }
+    else {
+	reply ("error unknown command");
+    }
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: load()
+//
+// Purpose: Replaces the formula by the clauses of a CNF file, once the
+//          options given are set.
+//
+// Notes: Options are kept for later formulas. The formula is left empty if
+//        the file cannot be read. Files are loaded by the CNF parser into a
+//        database of their own, hence compressed files and images are
+//        accepted, and clauses are normalized, as in other modes. As there,
+//        nsat aborts if the file is not a valid CNF file.
+//-----------------------------------------------------------------------------
+
+void ServerSession::load (char *args)
+{
+    SAT_Mode options;
+    options.setup();
+    copy_options (_options, options, TRUE);
+    SAT_Cmds cmds (options);
+    char *fname = cmds.cmdParse (args);
+    if (!fname || !cmds.valid()) {
+	reply ("error invalid arguments");
+	return;
+    }
+    copy_options (options, _options, TRUE);
+    clear (TRUE);
+
+    SAT_ClauseDatabase database (options);
+    _parser->set_threads (options[_LOAD_THREADS_]);
+    if (!_parser->load_CDB (fname, database)) {
+	reply ("error cannot open file");
+	return;
+    }
+    SAT_ClauseListPtr pcl;
+    for (pcl = (SAT_ClauseListPtr) database.clauses().first(); pcl;
+	 pcl = pcl->next()) {
+	for_each(plit, pcl->data()->literals(), LiteralPtr) {
+	    LiteralPtr lit = plit->data();
+	    int idx = lit->variable()->ID() + 1;       // Index of the CNF file
+	    _solver->add ((lit->sign()) ? -idx : idx);
+	}
+	_solver->add (0);
+    }
+    reply ("ok");
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: set_limit()
+//
+// Purpose: Sets the limit on the conflicts, or on the seconds, of each
+//          solve. A limit of 0 removes it.
+//-----------------------------------------------------------------------------
+
+void ServerSession::set_limit (char *args)
+{
+    char *kind = next_word (args);
+    char *value = next_word (args);
+    char *end;
+    long limit = strtol (value, &end, 10);
+    if (!strcmp (kind, "none") && !*value) {
+	_conflict_limit = _time_limit = 0;
+    }
+    else if (!*value || *end || limit < 0 || limit >= INFINITY) {
+	reply ("error invalid limit");
+	return;
+    }
+    else if (!strcmp (kind, "conflicts")) {
+	_conflict_limit = (int) limit;
+    }
+    else if (!strcmp (kind, "time")) {
+	_time_limit = (int) limit;
+    }
+    else {
+	reply ("error invalid limit");
+	return;
+    }
+    reply ("ok");
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: set_options()
+//
+// Purpose: Sets options as in the command line of nsat, before the solver
+//          is set up by the first solve of the formula.
+//-----------------------------------------------------------------------------
+
+void ServerSession::set_options (char *args)
+{
+    if (_solved) {
+	reply ("error options are fixed once solved");
+	return;
+    }
+    SAT_Mode options;
+    options.setup();
+    copy_options (_options, options, TRUE);
+    SAT_Cmds cmds (options);
+    if (cmds.cmdParse (args) || !cmds.valid()) {
+	reply ("error invalid option");
+	return;
+    }
+    copy_options (options, _options, TRUE);
+    copy_options (_options, _solver->mode(), FALSE);
+    reply ("ok");
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: solve()
+//
+// Purpose: Solves the formula under the assumptions given since the last
+//          solve, and those given with the command.
+//
+// Side-effects: Assumptions are kept for identifying the failed ones.
+//-----------------------------------------------------------------------------
+
+void ServerSession::solve (char *args)
+{
+    if (!read_literals (args)) {
+	reply ("error invalid literal");
+	return;
+    }
+    int number = _assumed_number + _lit_number;
+    if (number > _last_assumed.size()) {
+	_last_assumed.resize (number);
+    }
+    _last_number = 0;
+    for (int k = 0; k < number; k++) {
+	int lit = (k < _assumed_number) ? _assumed[k] :
+	    _lits[k - _assumed_number];
+	if (lit) {
+	    _solver->assume (lit);
+	    _last_assumed[_last_number++] = lit;
+	}
+    }
+    _assumed_number = 0;
+
+    _solver->set_conflict_limit ((_conflict_limit) ? _conflict_limit :
+				 INFINITY);
+    _deadline = (_time_limit) ? wall_time() + _time_limit : 0.0;
+    _outcome = _solver->solve();
+    _deadline = 0.0;
+    _solved = TRUE;
+
+    reply ((_outcome == SATISFIABLE) ? "s SATISFIABLE" :
+	   (_outcome == UNSATISFIABLE) ? "s UNSATISFIABLE" : "s UNKNOWN");
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: model()
+//
+// Purpose: Answers the literals of the last solution found, once the last
+//          solve was satisfiable. Unassigned variables are left out.
+//-----------------------------------------------------------------------------
+
+void ServerSession::model()
+{
+    if (_outcome != SATISFIABLE) {
+	reply ("error no model");
+	return;
+    }
+    reply ("v");
+    for (int k = 1; k <= _solver->variable_number(); k++) {
+	int value = _solver->value (k);
+	if (value != UNKNOWN) {
+	    reply_literal ((value == TRUE) ? k : -k);
+	}
+    }
+    reply (" 0");
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: core()
+//
+// Purpose: Answers the assumptions required for the last solve to be
+//          unsatisfiable, ie none if the formula is unsatisfiable. With
+//          argument min, these are first minimized within the limits.
+//-----------------------------------------------------------------------------
+
+void ServerSession::core (char *args)
+{
+    char *arg = next_word (args);
+    if (_outcome != UNSATISFIABLE) {
+	reply ("error no core");
+	return;
+    }
+    else if (*arg && strcmp (arg, "min")) {
+	reply ("error invalid argument");
+	return;
+    }
+    if (*arg) {
+	_solver->set_conflict_limit ((_conflict_limit) ? _conflict_limit :
+				     INFINITY);
+	_deadline = (_time_limit) ? wall_time() + _time_limit : 0.0;
+	_solver->minimize_core();
+	_deadline = 0.0;
+    }
+    reply ("f");
+    for (int k = 0; k < _last_number; k++) {
+	if (_solver->failed (_last_assumed[k])) {
+	    reply_literal (_last_assumed[k]);
+	}
+    }
+    reply (" 0");
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: clear()
+//
+// Purpose: Replaces the solver by an empty one, with the options of the
+//          session, or else with the options of nsat.
+//-----------------------------------------------------------------------------
+
+void ServerSession::clear (int keep_options)
+{
+    if (_solver) {
+	delete _solver;
+    }
+    if (!keep_options) {
+	copy_options (_mode, _options, TRUE);
+    }
+    _solver = new SAT_Incremental();
+    copy_options (_options, _solver->mode(), FALSE);
+    _solver->set_terminate ((void*) this, session_terminate);
+    _solved = FALSE;
+    _outcome = NONE;
+    _assumed_number = 0;
+    _last_number = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_literals()
+//
+// Purpose: Adds the literals of a line to the clause being given, where
+//          literal 0 ends the clause. Nothing is added if some literal is
+//          invalid, in which case FALSE is returned.
+//-----------------------------------------------------------------------------
+
+int ServerSession::add_literals (char *args)
+{
+    if (!read_literals (args)) {
+	return FALSE;
+    }
+    for (int k = 0; k < _lit_number; k++) {
+	_solver->add (_lits[k]);
+    }
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: read_literals()
+//
+// Purpose: Reads the literals of a line into _lits. Returns FALSE if some
+//          word is not a literal, or if its variable is too large.
+//-----------------------------------------------------------------------------
+
+int ServerSession::read_literals (char *args)
+{
+    _lit_number = 0;
+    char *pos = args;
+    while (TRUE) {
+	while (is_blank (*pos)) { pos++; }
+	if (!*pos) {
+	    return TRUE;
+	}
+	char *end;
+	long lit = strtol (pos, &end, 10);
+	if (end == pos || (*end && !is_blank (*end)) ||
+	    lit > SERVER_MAX_VARIABLE || lit < -SERVER_MAX_VARIABLE) {
+	    return FALSE;
+	}
+	if (_lit_number >= _lits.size()) {
+	    _lits.resize ((_lits.size()) ? 2*_lits.size() : 64);
+	}
+	_lits[_lit_number++] = (int) lit;
+	pos = end;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Functions for building answers, which are written once complete.
+//-----------------------------------------------------------------------------
+
+void ServerSession::reply (const char *answer)
+{
+    int length = strlen (answer);
+    if (_reply_length + length + 2 > _reply.size()) {
+	int size = 2*_reply.size();
+	_reply.resize ((size > _reply_length + length + 2) ? size :
+		       _reply_length + length + 256);
+    }
+    strcpy (&_reply[_reply_length], answer);
+    _reply_length += length;
+}
+
+void ServerSession::reply_literal (int lit)
+{
+    char buffer[16];
+    sprintf (buffer, " %d", lit);
+    reply (buffer);
+}
+
+void ServerSession::flush_reply()
+{
+    if (!_reply_length) {
+	return;
+    }
+    _reply[_reply_length++] = '\n';
+    char *pos = &_reply[0];
+    while (_reply_length > 0) {
+	int n = write (_out_fd, pos, _reply_length);
+	if (n < 0 && errno == EINTR) { continue; }
+	if (n <= 0) { break; }                                // Client is gone
+	pos += n;
+	_reply_length -= n;
+    }
+    _reply_length = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: run()
+//
+// Purpose: Serves the session of stdin if no path is given. Otherwise
+//          serves the connections to the Unix domain socket named path,
+//          which replaces any file of that name, until accept() fails.
+//
+// Notes: Answers on stdin are written to stdout, while any other output
+//        of nsat is sent to stderr. Sessions of the socket are served by
+//        detached threads, which delete them.
+//-----------------------------------------------------------------------------
+
+void ServerDriver::run (char *path)
+{
+    signal (SIGPIPE, SIG_IGN);                           // Clients may be gone
+    if (!path) {
+	cout << flush;
+	int out_fd = dup (1);
+	dup2 (2, 1);
+	ServerSession session (_mode, 0, out_fd);
+	session.run();
+	return;
+    }
+    struct sockaddr_un addr;
+    memset (&addr, 0, sizeof (addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen (path) >= sizeof (addr.sun_path)) {
+	cout << "\n    Socket name: " << path << endl;
+	Abort("Socket name is too long");
+    }
+    strcpy (addr.sun_path, path);
+    unlink (path);
+    int fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind (fd, (struct sockaddr*) &addr, sizeof (addr)) < 0 ||
+	listen (fd, SERVER_BACKLOG) < 0) {
+	cout << "\n    Socket name: " << path << endl;
+	Abort("Unable to enter on-line mode");
+    }
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+    while (TRUE) {
+	int session_fd = accept (fd, NULL, NULL);
+	if (session_fd < 0) {
+	    if (errno == EINTR || errno == ECONNABORTED) { continue; }
+	    break;
+	}
+	ServerSessionPtr session =
+	    new ServerSession (_mode, session_fd, session_fd);
+	pthread_t thread;
+	if (pthread_create (&thread, &attr, session_thread, session)) {
+	    delete session;
+	    close (session_fd);
+	}
+    }
+    pthread_attr_destroy (&attr);
+    close (fd);
+    unlink (path);
+}
+
+/*****************************************************************************/
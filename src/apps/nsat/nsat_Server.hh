@@ -0,0 +1,172 @@
+//-----------------------------------------------------------------------------
+// File: nsat_Server.hh
+//
+// Purpose: On-line mode of nsat. nsat runs as a persistent process that
+//          solves the formulas given by its clients, through a line
+//          protocol on stdin/stdout or on a Unix domain socket.
+//
+// Remarks: Each session, ie stdin or each connection to the socket, has
+//          its own incremental solver (see grp_Incr.hh), which keeps the
+//          clauses learnt by all calls. Sessions of the socket are served
+//          concurrently, each by its own thread. Commands are one for each
+//          line, and are answered by one line, except for clauses:
+//
+//            load [options] file   Clears the formula, then adds the
+//                                  clauses of a CNF file (DIMACS format).
+//            <lits> 0              Adds a clause. Clauses may span lines.
+//            add <lits> 0          Adds a clause, answered by "ok".
+//            assume <lits>         Assumes literals for the next solve.
+//            push [name]           Pushes a group of clauses.
+//            pop [name]            Pops the last group (of that name).
+//            limit conflicts <n>   Conflicts of each solve (0 if none).
+//            limit time <n>        Seconds of each solve (0 if none).
+//            option <options>      Options given as in the command line,
+//                                  before the formula is first solved.
+//            solve [<lits>]        Solves under the assumptions given.
+//            model                 Values of the last solution found.
+//            core [min]            Failed assumptions of the last solve,
+//                                  minimized if min is given.
+//            reset                 Clears the formula and the options.
+//            quit                  Ends the session.
+//
+//          Answers are "ok [groups]", "s SATISFIABLE", "s UNSATISFIABLE",
+//          "s UNKNOWN", "v <lits> 0", "f <lits> 0" or "error <message>".
+//          Lines whose first word is c or p are ignored, as in CNF files.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - minimized cores.
+//          10/19/26 - agent - files loaded by the CNF parser.
+//-----------------------------------------------------------------------------
+
+#ifndef __NSAT_SERVER__
+#define __NSAT_SERVER__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+
+class SAT_Incremental;
+class CNF_Parser;
+
+
+//-----------------------------------------------------------------------------
+// Defines for on-line mode.
+//-----------------------------------------------------------------------------
+
+# define SERVER_BACKLOG     16                    // Connections waiting accept
+# define SERVER_MAX_VARIABLE (1 << 26)            // Largest index of variables
+
+
+//-----------------------------------------------------------------------------
+// Class: ServerSession
+//
+// Purpose: Serves the commands of one client, read from in_fd and answered
+//          on out_fd, until the client quits or closes in_fd.
+//
+// Notes: Sessions start from the options of nsat, except for the limits,
+//        preprocessing, variable elimination and local search, which the
+//        incremental solver does not use. Limits of the session apply to
+//        each solve instead. The time limit is wall-clock time, since the
+//        CPU time of the process counts all sessions.
+//-----------------------------------------------------------------------------
+
+class ServerSession {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    ServerSession (SAT_Mode &nmode, int in_fd, int out_fd);
+    virtual ~ServerSession();
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    virtual void run();                   // Serves commands until client quits
+    virtual int expired();                    // Whether the time limit expired
+
+  protected:
+
+    //-------------------------------------------------------------------------
+    // Functions for serving each command.
+    //-------------------------------------------------------------------------
+
+    virtual int serve (char *line);          // Returns FALSE once client quits
+    virtual void load (char *args);
+    virtual void set_limit (char *args);
+    virtual void set_options (char *args);
+    virtual void solve (char *args);
+    virtual void model();
+    virtual void core (char *args);
+    virtual void clear (int keep_options);
+
+    int add_literals (char *args);                   // Adds literals to clause
+    int read_literals (char *args);                     // Into _lits, or FALSE
+    void reply (const char *answer);
+    void reply_literal (int lit);
+    void flush_reply();
+
+    //-------------------------------------------------------------------------
+    // Internal variable definition.
+    //-------------------------------------------------------------------------
+
+    SAT_Mode &_mode;                                         // Options of nsat
+    SAT_Mode _options;                                    // Options of session
+    SAT_Incremental *_solver;
+    int _in_fd;
+    int _out_fd;
+    int _solved;                             // Whether formula was solved once
+    int _outcome;                                 // Of the last solve, or NONE
+
+    Array<int> _lits;                              // Literals of the last line
+    int _lit_number;
+    Array<int> _assumed;                           // Assumptions of next solve
+    int _assumed_number;
+    Array<int> _last_assumed;                      // Assumptions of last solve
+    int _last_number;
+
+    int _conflict_limit;                             // Conflicts of each solve
+    int _time_limit;                                   // Seconds of each solve
+    double _deadline;                                   // Of the running solve
+
+    Array<char> _reply;                                   // Answer being built
+    int _reply_length;
+
+    CNF_Parser *_parser;                  // Of files loaded, reusing its names
+};
+
+typedef ServerSession *ServerSessionPtr;
+
+
+//-----------------------------------------------------------------------------
+// Class: ServerDriver
+//
+// Purpose: Runs the session of stdin, or accepts connections to a Unix
+//          domain socket and creates a thread for the session of each.
+//-----------------------------------------------------------------------------
+
+class ServerDriver {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    ServerDriver (SAT_Mode &nmode) : _mode (nmode) {}
+    virtual ~ServerDriver() {}
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    virtual void run (char *path);            // Socket path, or NULL for stdin
+
+  protected:
+    SAT_Mode &_mode;                                   // Configuration options
+};
+
+#endif // __NSAT_SERVER__
+
+/*****************************************************************************/
@@ -11,6 +11,8 @@
 //          that must become unassigned. In the end all tags are cleared.
 //
 // History: 03/15/96 - JPMS - created.
+//          10/19/26 - agent - final conflict analysis of assumptions.
+//          10/19/26 - agent - failed assumptions cleared with the engine.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -47,10 +49,14 @@ void BRE::reset (SAT_ClauseDatabase &clDB, int l_level, int h_level)
 // Function: clear()
 //
 // Purpose: Clear structure for subsequent search.
+//
+// Notes: Failed assumptions are kept by the IDs of their variables, hence
+//        can be cleared once the variables are deleted.
 //-----------------------------------------------------------------------------
 
 void BRE::clear (SAT_ClauseDatabase &clDB)
 {
+    clear_failed();
     _CLevel = NONE;
     _conf_clause = NULL;
     _tagged_vars = NONE;
@@ -255,6 +261,99 @@ void BRE::unset_clauses_state (SAT_ClauseDatabase &clDB, SAT_VariablePtr var)
 }
 
 
+//-----------------------------------------------------------------------------
+// Function: analyze_final()
+//
+// Purpose: Traces the assignment that falsifies an assumption to the
+//          decision assignments, ie to the assumptions that imply it. These
+//          assumptions, and the assumption falsified, are failed.
+//
+// Side-effects: Failed assumptions are marked. BLACK tags are set and then
+//               cleared, hence must not be in use by other traversals.
+//
+// Notes: Assumptions are decided before any other variable, hence all
+//        decision assignments traced are assumptions. Assignments at
+//        decision level 0 are implied by the instance, and are not traced.
+//        Each variable is queued once, hence the analysis is linear in the
+//        size of the antecedents traced.
+//-----------------------------------------------------------------------------
+
+void BRE::analyze_final (SAT_ClauseDatabase &clDB,
+			 SAT_VariablePtr var, int value)
+{
+    mark_failed (var, value);
+    if (var->value() == UNKNOWN || var->DLevel() == 0) {
+	return;
+    }
+    if (_trace.size() == 0) {
+	_trace.resize (64);
+    }
+    int head = 0, tail = 0;
+    var->set_tag (BLACK);
+    _trace[tail++] = var;
+    while (head < tail) {
+	var = _trace[head++];
+	if (!var->antecedent()) {
+	    mark_failed (var, var->value());
+	    continue;
+	}
+	for_each(plit,var->antecedent()->literals(),LiteralPtr) {
+	    SAT_VariablePtr avar = (SAT_VariablePtr) plit->data()->variable();
+	    if (avar->DLevel() > 0 && !avar->test_tag (BLACK)) {
+		if (tail >= _trace.size()) {
+		    _trace.resize (2*_trace.size());
+		}
+		avar->set_tag (BLACK);
+		_trace[tail++] = avar;
+	    }
+	}
+    }
+    for (register int k = 0; k < tail; k++) {
+	_trace[k]->unset_tag (BLACK);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: mark_failed()
+//
+// Purpose: Records a failed assumption.
+//-----------------------------------------------------------------------------
+
+void BRE::mark_failed (SAT_VariablePtr var, int value)
+{
+    int size = _failed.size();
+    if (var->ID() >= size) {                    // Grow by doubling the size
+	_failed.resize ((var->ID() < 2*size) ? 2*size : var->ID() + 1);
+	for (register int k = size; k < _failed.size(); k++) {
+	    _failed[k] = 0;
+	}
+    }
+    if (!_failed[var->ID()]) {
+	if (_failed_number >= _failed_IDs.size()) {
+	    _failed_IDs.resize ((_failed_number) ? 2*_failed_number : 16);
+	}
+	_failed_IDs[_failed_number++] = var->ID();
+    }
+    _failed[var->ID()] |= (1 << value);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: clear_failed()
+//
+// Purpose: Forgets the failed assumptions, in time linear in their number.
+//-----------------------------------------------------------------------------
+
+void BRE::clear_failed()
+{
+    for (register int k = 0; k < _failed_number; k++) {
+	_failed[_failed_IDs[k]] = 0;
+    }
+    _failed_number = 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // Function: resources_exceeded()
 //
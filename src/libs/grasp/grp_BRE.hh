@@ -9,6 +9,11 @@
 // Remarks: --
 //
 // History: 03/15/96 - JPMS - created.
+//          10/19/26 - agent - LBD of conflicting clauses.
+//          10/19/26 - agent - counters restored from checkpoints.
+//          10/19/26 - agent - final conflict analysis of assumptions.
+//          10/19/26 - agent - failed assumptions kept by variable IDs.
+//          10/19/26 - agent - export of conflicting clauses.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -33,11 +38,17 @@ class BRE {
     // Constructor/destructor.
     //-------------------------------------------------------------------------
 
-    BRE (SAT_Mode &nmode) : _mode(nmode) {
+    BRE (SAT_Mode &nmode) :
+    _level_marks(0), _failed(0), _failed_IDs(0), _trace(0), _mode(nmode) {
 	_CLevel = NONE;
+	_failed_number = 0;
+	_level_mark = 0;
 	_conf_clause = NULL;
 	_tagged_vars = NONE;
 	_skip_UIP = FALSE;
+	_learn = NULL;
+	_learn_state = NULL;
+	_learn_length = 0;
 
 	_tot_conf_number = 0;
 	_large_conf_diff = 0;
@@ -69,8 +80,45 @@ class BRE {
 
     virtual void output_stats (SAT_ClauseDatabase &clDB);
 
+    // Counters of the search, eg restored from checkpoints.
+
+    inline int &conf_number() { return _tot_conf_number; }
+    inline int &conf_cl_number() { return _tot_conf_cl_number; }
+    inline int &back_number() { return _tot_back_number; }
+    inline int &uip_number() { return _tot_uip_number; }
+
+    //-------------------------------------------------------------------------
+    // Final conflict analysis. analyze_final() traces an assumption implied
+    // false to the assumptions that imply it, which are then failed() with
+    // the assumption itself. These are kept until clear_failed().
+    //-------------------------------------------------------------------------
+
+    virtual void analyze_final (SAT_ClauseDatabase &clDB,
+				SAT_VariablePtr var, int value);
+    virtual void clear_failed();
+
+    inline int failed (SAT_VariablePtr var, int value) {
+	return (var->ID() < _failed.size() &&
+		(_failed[var->ID()] & (1 << value)));
+    }
+    inline int failed_number() { return _failed_number; }
+
+    //-------------------------------------------------------------------------
+    // Export of conflicting clauses. Once set, learn() is invoked with each
+    // conflicting clause created with at most max_length literals.
+    //-------------------------------------------------------------------------
+
+    inline void set_learn (void *state, int max_length,
+			   void (*learn)(void *state, SAT_ClausePtr cl)) {
+	_learn_state = state;
+	_learn_length = max_length;
+	_learn = learn;                                      // Or NULL if none
+    }
+
   protected:
 
+    void mark_failed (SAT_VariablePtr var, int value);
+
     //-------------------------------------------------------------------------
     // Resetting the state of the clause database.
     //-------------------------------------------------------------------------
@@ -157,9 +205,33 @@ class BRE {
 	    _small_cl_size = _conf_clause->size();
 	}
 	_tot_conf_cl_number++;
+	set_clause_LBD (_conf_clause);
+	if (_learn && _conf_clause->size() <= _learn_length) {
+	    _learn (_learn_state, _conf_clause);
+	}
 	CHECK(if(_mode[_DEBUG_])
 	      {cout << "CONFLICTING ";_conf_clause->dump(cout);cout<<endl;});
     }
+    inline void set_clause_LBD (SAT_ClausePtr cl) {
+	int lbd = 0;
+	_level_mark++;
+	for_each(plit,cl->literals(),LiteralPtr) {
+	    SAT_VariablePtr var = (SAT_VariablePtr) plit->data()->variable();
+	    int level = (var->value() != UNKNOWN) ? var->DLevel() : _CLevel;
+	    if (level >= _level_marks.size()) {
+		int orig_size = _level_marks.size();
+		_level_marks.resize (2 * level + 1);
+		for (int k = orig_size; k < _level_marks.size(); k++) {
+		    _level_marks[k] = 0;
+		}
+	    }
+	    if (_level_marks[level] != _level_mark) {
+		_level_marks[level] = _level_mark;
+		lbd++;
+	    }
+	}
+	cl->LBD() = lbd;
+    }
     inline void tag_clause_vars (SAT_ClauseDatabase &clDB,
 				 SAT_VariablePtr nvar,
 				 SAT_ClausePtr cl, int level) {
@@ -222,10 +294,22 @@ class BRE {
 
     int _CLevel;
 
+    Array<int> _level_marks;               // Last mark of each DLevel, for LBD
+    int _level_mark;
+
     SAT_ClausePtr _conf_clause;
     int _skip_UIP;
     int _tagged_vars;
 
+    Array<int> _failed;                // Values of failed assumptions, as bits
+    Array<int> _failed_IDs;                        // Variable IDs of the above
+    int _failed_number;
+    Array<SAT_VariablePtr> _trace;          // Queue of final conflict analysis
+
+    void (*_learn)(void *state, SAT_ClausePtr cl);            // Export, if any
+    void *_learn_state;
+    int _learn_length;
+
     SAT_Mode &_mode;
 
   protected:                                   // Variables for stats gathering
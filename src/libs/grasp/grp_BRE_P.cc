@@ -8,6 +8,7 @@
 //          indicates that the clause can be deleted.
 //
 // History: 03/14/96 - JPMS - created.
+//          10/19/26 - agent - LBD of repacked clauses.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -244,6 +245,7 @@ void BRE_P::conf_clause_repack (SAT_ClauseDatabase &clDB)
 
     clDB.del_clause (_conf_clause);
     _conf_clause = new_clause;
+    set_clause_LBD (_conf_clause);
 }
 
 
@@ -0,0 +1,305 @@
+//-----------------------------------------------------------------------------
+// File: grp_Backbone.cc
+//
+// Purpose: Member functions of the computation of backbones.
+//
+// Remarks: --
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - limits set on each call of the solver.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "grp_Backbone.hh"
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_Backbone::SAT_Backbone (SAT_Mode &nmode) : _mode(nmode), _solver(),
+    _restricted(0), _cands(0), _singles(0), _chunk(0), _backbone(0)
+{
+    _solver.set_options (nmode);
+    _var_number = 0;
+    _restrict_number = 0;
+    _cand_number = 0;
+    _single_number = 0;
+    _backbone_size = 0;
+    _call_number = 0;
+    _fixed_number = 0;
+}
+
+SAT_Backbone::~SAT_Backbone()
+{
+    _restricted.resize (0);
+    _cands.resize (0);
+    _singles.resize (0);
+    _chunk.resize (0);
+    _backbone.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add()
+//
+// Purpose: Adds a literal to the clause being given, or ends it if 0.
+//-----------------------------------------------------------------------------
+
+void SAT_Backbone::add (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (idx > _var_number) {
+	_var_number = idx;
+    }
+    _solver.add (lit);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: restrict()
+//
+// Purpose: Adds a variable to those whose literals may be in the backbone.
+//          Variables that are not in clauses are free in all solutions.
+//-----------------------------------------------------------------------------
+
+void SAT_Backbone::restrict (int var)
+{
+    if (var <= 0) {
+	return;
+    }
+    if (var >= _restricted.size()) {
+	int size = _restricted.size();
+	_restricted.resize ((var < 2*size) ? 2*size : var + 1);
+	for (int k = size; k < _restricted.size(); k++) {
+	    _restricted[k] = FALSE;
+	}
+    }
+    if (!_restricted[var]) {
+	_restricted[var] = TRUE;
+	_restrict_number++;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: compute()
+//
+// Purpose: Finds a first solution, whose literals are the candidates, and
+//          tests the candidates until none is left.
+//
+// Side-effects: Literals of the backbone are added to the solver as unit
+//               clauses, which later calls find at decision level 0.
+//
+// Notes: Candidates of cores are tested before the next chunk, such that
+//        the solutions found meanwhile drop candidates of both.
+//-----------------------------------------------------------------------------
+
+int SAT_Backbone::compute (int chunk)
+{
+    _solver.start_limits();
+    _backbone_size = 0;
+    _call_number = 0;
+    _fixed_number = 0;
+    if (chunk <= 0) {
+	chunk = BACKBONE_CHUNK;
+    }
+    if (_chunk.size() < chunk) {
+	_chunk.resize (chunk);
+    }
+
+    int outcome = solve();
+    if (outcome != SATISFIABLE) {
+	return outcome;
+    }
+    if (_cands.size() <= _var_number) {
+	_cands.resize (_var_number + 1);
+	_singles.resize (_var_number + 1);
+	_backbone.resize (_var_number + 1);
+    }
+    _cand_number = _single_number = 0;
+    for (int k = 1; k <= _var_number; k++) {
+	if (restricted (k) && _solver.value (k) != UNKNOWN) {
+	    _cands[_cand_number++] = (_solver.value (k) == TRUE) ? k : -k;
+	}
+    }
+    prune();
+
+    while (_cand_number || _single_number) {
+	int size = 0;
+	if (_single_number) {
+	    _chunk[size++] = _singles[--_single_number];
+	}
+	else {
+	    while (size < chunk && _cand_number) {
+		_chunk[size++] = _cands[--_cand_number];
+	    }
+	}
+	if (test (size) == ABORTED) {
+	    return ABORTED;
+	}
+    }
+    return SATISFIABLE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: test()
+//
+// Purpose: Tests the candidates of a chunk, by assuming their negations
+//          until a solution is found, or until none is left. Returns the
+//          outcome of the last call.
+//
+// Side-effects: Candidates of cores of one assumption are added to the
+//               backbone, and those of larger cores are moved to the
+//               candidates tested one at once.
+//
+// Notes: A chunk of one candidate is in the backbone once unsatisfiable,
+//        whatever the core found. So are candidates of no core.
+//-----------------------------------------------------------------------------
+
+int SAT_Backbone::test (int size)
+{
+    int outcome = UNSATISFIABLE;
+    while (size) {
+	for (int k = 0; k < size; k++) {
+	    _solver.assume (-_chunk[k]);
+	}
+	outcome = solve();
+	if (outcome == SATISFIABLE) {      // Candidates of chunk are falsified
+	    filter();
+	    prune();
+	    return outcome;
+	}
+	if (outcome != UNSATISFIABLE) {
+	    return outcome;
+	}
+	int failed = 0, first = 0;
+	for (int k = 0; k < size; k++) {
+	    if (_solver.failed (-_chunk[k]) && !failed++) {
+		first = k;
+	    }
+	}
+	if (size == 1 || failed == 1) {
+	    add_backbone (_chunk[first]);
+	    _chunk[first] = _chunk[--size];
+	}
+	else {
+	    int new_size = 0;
+	    for (int k = 0; k < size; k++) {
+		if (failed && !_solver.failed (-_chunk[k])) {
+		    _chunk[new_size++] = _chunk[k];
+		}
+		else {
+		    _singles[_single_number++] = _chunk[k];
+		}
+	    }
+	    size = new_size;
+	}
+	for (int k = 0; k < size; k++) {
+	    while (k < size && _solver.fixed (_chunk[k])) {
+		add_backbone (_chunk[k]);
+		_fixed_number++;
+		_chunk[k] = _chunk[--size];
+	    }
+	}
+	prune();
+    }
+    return outcome;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: solve()
+//
+// Purpose: Calls the solver under the assumptions given, if resources are
+//          left.
+//-----------------------------------------------------------------------------
+
+int SAT_Backbone::solve()
+{
+    if (!_solver.set_limits (_mode)) {
+	return ABORTED;
+    }
+    _call_number++;
+    return _solver.solve();
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: filter()
+//
+// Purpose: Drops the candidates that are not true in the solution found.
+//-----------------------------------------------------------------------------
+
+void SAT_Backbone::filter()
+{
+    int new_number = 0;
+    for (int k = 0; k < _cand_number; k++) {
+	if (_solver.value (_cands[k]) == TRUE) {
+	    _cands[new_number++] = _cands[k];
+	}
+    }
+    _cand_number = new_number;
+    new_number = 0;
+    for (int k = 0; k < _single_number; k++) {
+	if (_solver.value (_singles[k]) == TRUE) {
+	    _singles[new_number++] = _singles[k];
+	}
+    }
+    _single_number = new_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: prune()
+//
+// Purpose: Adds the candidates implied at decision level 0 by the last
+//          call to the backbone, without testing them.
+//-----------------------------------------------------------------------------
+
+void SAT_Backbone::prune()
+{
+    int new_number = 0;
+    for (int k = 0; k < _cand_number; k++) {
+	if (_solver.fixed (_cands[k])) {
+	    add_backbone (_cands[k]);
+	    _fixed_number++;
+	}
+	else {
+	    _cands[new_number++] = _cands[k];
+	}
+    }
+    _cand_number = new_number;
+    new_number = 0;
+    for (int k = 0; k < _single_number; k++) {
+	if (_solver.fixed (_singles[k])) {
+	    add_backbone (_singles[k]);
+	    _fixed_number++;
+	}
+	else {
+	    _singles[new_number++] = _singles[k];
+	}
+    }
+    _single_number = new_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_backbone()
+//
+// Purpose: Adds a literal to the backbone, and to the solver as a unit
+//          clause.
+//-----------------------------------------------------------------------------
+
+void SAT_Backbone::add_backbone (int lit)
+{
+    _backbone[_backbone_size++] = lit;
+    _solver.add (lit);
+    _solver.add (0);
+}
+
+/*****************************************************************************/
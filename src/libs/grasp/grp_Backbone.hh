@@ -0,0 +1,114 @@
+//-----------------------------------------------------------------------------
+// File: grp_Backbone.hh
+//
+// Purpose: Class declaration of the computation of the backbone of a
+//          formula, ie of the literals true in all its solutions, on one
+//          incremental solver (see grp_Incr.hh).
+//
+// Remarks: The literals of a first solution are the candidates. Chunks of
+//          candidates are then tested by assuming their negations. Each
+//          solution found drops all candidates it falsifies. Otherwise, a
+//          core of one assumption identifies a literal of the backbone,
+//          which is added as a unit clause, and larger cores are tested one
+//          literal at a time. Candidates implied at decision level 0 by the
+//          calls are in the backbone without being tested.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - limits set on each call of the solver.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_BACKBONE__
+#define __GRP_BACKBONE__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_Incr.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for the computation of backbones.
+//-----------------------------------------------------------------------------
+
+#define BACKBONE_CHUNK 16            // Candidates tested at once, if not given
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Backbone
+//
+// Purpose: Keeps the clauses given with DIMACS literals, and computes the
+//          backbone of the formula over a set of variables.
+//
+// Notes: Without variables given by restrict(), the backbone is computed
+//        over all the variables of the clauses. Options are those of the
+//        mode given, whose limits apply to the whole computation, ie all
+//        the calls of the solver. Once limits are exceeded, the literals
+//        found so far are in the backbone, but others may be missing.
+//-----------------------------------------------------------------------------
+
+class SAT_Backbone {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Backbone (SAT_Mode &nmode);
+    virtual ~SAT_Backbone();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. add() adds literals to the clause being given,
+    // which literal 0 ends. compute() tests chunk candidates at once (see
+    // BACKBONE_CHUNK if 0), and returns SATISFIABLE once the backbone is
+    // found, UNSATISFIABLE if the formula has no solution, and ABORTED if
+    // limits were exceeded. Literals of the backbone are in order found.
+    //-------------------------------------------------------------------------
+
+    virtual void add (int lit);
+    virtual void restrict (int var);
+    virtual int compute (int chunk);
+
+    inline int backbone_size() { return _backbone_size; }
+    inline int backbone_literal (int k) { return _backbone[k]; }
+    inline int variable_number() { return _var_number; }
+    inline int call_number() { return _call_number; }
+    inline int fixed_number() { return _fixed_number; }       // Found untested
+
+    inline SAT_Governor &governor() { return _solver.governor(); }
+
+protected:
+    virtual int test (int size);
+    virtual int solve();
+    virtual void filter();
+    virtual void prune();
+    virtual void add_backbone (int lit);
+    inline int restricted (int idx) {
+	return (!_restrict_number ||
+		(idx < _restricted.size() && _restricted[idx]));
+    }
+
+    SAT_Mode &_mode;                                      // Options and limits
+    SAT_Incremental _solver;
+    int _var_number;
+
+    Array<char> _restricted;                 // Variables of backbone, by index
+    int _restrict_number;
+
+    Array<int> _cands;                              // Candidates left untested
+    int _cand_number;
+    Array<int> _singles;             // Candidates of cores, tested one at once
+    int _single_number;
+    Array<int> _chunk;                               // Candidates being tested
+
+    Array<int> _backbone;
+    int _backbone_size;
+
+    int _call_number;
+    int _fixed_number;
+
+};
+
+#endif // __GRP_BACKBONE__
+
+/*****************************************************************************/
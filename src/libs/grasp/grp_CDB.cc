@@ -7,6 +7,11 @@
 // Remarks: --
 //
 // History: 03/10/96 - JPMS - created.
+//          10/19/26 - agent - definitions of AND gates of circuits.
+//          10/19/26 - agent - databases without literals never exceed space.
+//          10/19/26 - agent - counter of implied assignments.
+//          10/19/26 - agent - decisions popped once all were used are kept.
+//          10/19/26 - agent - array of gates reused across instances.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -18,7 +23,7 @@
 #include "grp_CDB.hh"
 
 
-extern void dump_clause_list (ClauseList &cl_list);
+extern void dump_clause_list (SAT_ClauseList &cl_list);
 extern void dump_clause_literals (SAT_ClausePtr cl);
 
 
@@ -32,6 +37,36 @@ MEM_MNG_DEF(SAT_Clause, "SAT_Clause")
 
 
 
+//-----------------------------------------------------------------------------
+// Function: ~SAT_ClauseDatabase()
+//
+// Purpose: Deletes decisions and gives back the blocks of the pool of the
+//          database, ie all variables, clauses and literals, at once.
+//
+// Notes: Engines that allocated items while bound to the pool of the
+//        database must be deleted before the database.
+//-----------------------------------------------------------------------------
+
+SAT_ClauseDatabase::~SAT_ClauseDatabase()
+{
+    _impliedVariables.reset();                 // Items owned by the variables
+    _unassignedVariables.erase();
+    _taggedClauses.erase();
+    _avail_decisions.clear();                  // Items owned by the decisions
+    for (register int k = 0; k < _decision.size(); k++) {
+	_decision[k]->assignedVariables().reset();
+	delete _decision[k];
+    }
+    _decision.resize(0);
+    erase_gates();
+    DMEM(_unitClauses.reset();
+	 _unsatClauses.reset();
+	 _variables.reset();
+	 _clauses.reset();
+	 _pool.release_all(););
+}
+
+
 //-----------------------------------------------------------------------------
 // Function: push_decision()
 //
@@ -87,17 +122,18 @@ int SAT_ClauseDatabase::pop_decision (int level)
 	DBG0(cout<<"RELEASING DLEVEL: "<<level<<endl;);
 	_decision[level]->used() = FALSE;
 
-	if (_avail_decisions.size()) {
-	    DecisionListPtr pdec;
-	    for (pdec = _avail_decisions.first(); pdec; pdec = pdec->next()) {
-		DecisionPtr dec = pdec->data();
-		if (level < dec->DLevel()) {
-		    _avail_decisions.insertBefore
-			(_decision[level]->avail_ref(), pdec);
-		    break;
-		}
+	DecisionListPtr pdec;
+	for (pdec = _avail_decisions.first(); pdec; pdec = pdec->next()) {
+	    DecisionPtr dec = pdec->data();
+	    if (level < dec->DLevel()) {
+		_avail_decisions.insertBefore
+		    (_decision[level]->avail_ref(), pdec);
+		break;
 	    }
 	}
+	if (!pdec) {                  // Above all available, eg none are left
+	    _avail_decisions.append (_decision[level]->avail_ref());
+	}
     }
     _DLevel = NONE;
     DBG1(cout<<"TOP DECISION LEVEL: ";
@@ -157,6 +193,7 @@ void SAT_ClauseDatabase::clear()
     // Stats:
 
     _dec_number = 0;
+    _prop_number = 0;
     _max_tree_depth = 0;
 
     // OTHER requirements to be defined.
@@ -176,7 +213,7 @@ void SAT_ClauseDatabase::clear()
 void SAT_ClauseDatabase::reset()
 {
     _impliedVariables.reset();
-    _unassignedVariables.reset();
+    _unassignedVariables.erase();
 
     for(register int k = 0; k < _decision.size(); k++) {
 	if (_decision[k]->used()) {
@@ -187,10 +224,91 @@ void SAT_ClauseDatabase::reset()
 
 	_avail_decisions.append (_decision[k]->avail_ref());
     }
-    _taggedClauses.reset();
+    _taggedClauses.erase();
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: erase()
+//
+// Purpose: Deletes all clauses and variables of the current instance, such
+//          that the database can be loaded with another instance of SAT.
+//
+// Side-effects: Variable IDs are reused for the next instance. Allocated
+//               decision levels are kept.
+//
+// Notes: The database *must* be reset before, ie no variable is assigned.
+//-----------------------------------------------------------------------------
+
+void SAT_ClauseDatabase::erase()
+{
+    DBG1(cout<<"ERASING CLAUSE DATABASE!"<<endl;);
+    CHECK(if (_satisfied_clauses || _impliedVariables.size())
+	  Warn("Erasing clause database that was not reset?"););
+    SAT_ClauseListPtr pcl;
+    while ((pcl = (SAT_ClauseListPtr) _clauses.first())) {
+	del_clause (pcl->data());
+    }
+    SAT_VariableListPtr pvar;
+    while ((pvar = (SAT_VariableListPtr) _variables.first())) {
+	del_variable (pvar->data());
+    }
+    erase_gates();
+    _varIDs = 0;
+    _lit_number = 0;
+    _satisfied_clauses = 0;
 }
 
 
+//-----------------------------------------------------------------------------
+// Function: add_gate()
+//
+// Purpose: Records the definition of a variable as the AND of two literals.
+//          The clauses of the definition must be added separately.
+//
+// Notes: A later definition of the same variable replaces the former one.
+//-----------------------------------------------------------------------------
+
+SAT_GatePtr SAT_ClauseDatabase::add_gate (SAT_VariablePtr out,
+					  SAT_VariablePtr in0, int sign0,
+					  SAT_VariablePtr in1, int sign1)
+{
+    int size = _gates.size();
+    if (out->ID() >= size) {                    // Grow by doubling the size
+	_gates.resize ((out->ID() < 2*size) ? 2*size : out->ID() + 1);
+	for (register int k = size; k < _gates.size(); k++) {
+	    _gates[k] = NULL;
+	}
+    }
+    if (_gates[out->ID()]) {
+	delete _gates[out->ID()];
+	_gate_number--;
+    }
+    _gates[out->ID()] = new SAT_Gate (out, in0, sign0, in1, sign1);
+    _gate_number++;
+    return _gates[out->ID()];
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: erase_gates()
+//
+// Purpose: Deletes the definitions of gates, if any.
+//
+// Notes: The array of gates keeps its size for the next instance.
+//-----------------------------------------------------------------------------
+
+void SAT_ClauseDatabase::erase_gates()
+{
+    for (register int k = 0; k < _gates.size(); k++) {
+	if (_gates[k]) {
+	    delete _gates[k];
+	    _gates[k] = NULL;
+	}
+    }
+    _gate_number = 0;
+}
+
 
 //-----------------------------------------------------------------------------
 // Function: trim_solution()
@@ -239,7 +357,9 @@ int SAT_ClauseDatabase::can_trim_solution (int &total_dec, int &required_dec)
 
 int SAT_ClauseDatabase::resources_exceeded (SAT_ClauseDatabase &clDB)
 {
-    CHECK(if (!_initial_lit_number) Abort("LIT NUMBER IS ZERO!?"););
+    if (!_initial_lit_number) {                // Eg no clauses were added
+	return FALSE;
+    }
     int growth = _lit_number / _initial_lit_number;
     return (growth > _mode[_SPACE_LIMIT_]);
 }
@@ -265,6 +385,10 @@ void SAT_ClauseDatabase::output_stats()
     printItem ("Total number of decisions", _dec_number);
     printItem ("Largest depth of decision tree", _max_tree_depth);
     printItem();
+    DMEM(printItem ("Number of memory blocks", (int) _pool.block_number());
+	 printItem ("Memory allocated (KB)",
+		    (int) (_pool.allocated_bytes() / 1024));
+	 printItem(););
 }
 
 //-----------------------------------------------------------------------------
@@ -464,13 +588,13 @@ int SAT_ClauseDatabase::check_consistency (int consistent_state)
     if (unit_number != _unitClauses.size()) {
 	cout << "Counted UNIT clauses:  " << unit_number << endl;
 	cout << "Existing UNIT clauses: " << _unitClauses.size() << endl;
-	dump_clause_list ((ClauseList&)_unitClauses);
+	dump_clause_list (_unitClauses);
 	Warn("Invalid number of unit clauses in list");
     }
     if (unsat_number != _unsatClauses.size()) {
 	cout << "Counted UNSAT clauses:  " << unsat_number << endl;
 	cout << "Existing UNSAT clauses: " << _unsatClauses.size() << endl;
-	dump_clause_list ((ClauseList&)_unsatClauses);
+	dump_clause_list (_unsatClauses);
 	Warn("Invalid number of unsat clauses in list");
     }
     if (consistent_state && (_unsatClauses.size() || _unitClauses.size())) {
@@ -638,10 +762,11 @@ void SAT_Variable::dump (ostream &outs)
 // Purpose: Print out list of clauses.
 //-----------------------------------------------------------------------------
 
-void dump_clause_list (ClauseList &cl_list)
+void dump_clause_list (SAT_ClauseList &cl_list)
 {
-    for_each(pcl,cl_list,ClausePtr) {
-	SAT_ClausePtr cl = (SAT_ClausePtr) pcl->data();
+    SAT_ClauseListPtr pcl;
+    for (pcl = cl_list.first(); pcl; pcl = pcl->next()) {
+	SAT_ClausePtr cl = pcl->data();
 	cl->dump (cout); cout << endl;
 	dump_clause_literals (cl);
     }
@@ -6,6 +6,10 @@
 // Remarks: --
 //
 // History: 03/10/96 - JPMS - created.
+//          10/19/26 - agent - definitions of AND gates of circuits.
+//          10/19/26 - agent - LBD of learnt clauses.
+//          10/19/26 - agent - counters restored from checkpoints.
+//          10/19/26 - agent - counter of implied assignments.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -30,6 +34,7 @@
 class SAT_Variable;
 class SAT_Clause;
 class Decision;
+class SAT_Gate;
 
 typedef SAT_Variable *SAT_VariablePtr;
 typedef List<SAT_Variable*> SAT_VariableList;
@@ -43,6 +48,8 @@ typedef Decision *DecisionPtr;
 typedef List<Decision*> DecisionList;
 typedef ListItem<Decision*> *DecisionListPtr;
 
+typedef SAT_Gate *SAT_GatePtr;
+
 
 
 //-----------------------------------------------------------------------------
@@ -154,6 +161,7 @@ class SAT_Clause : public Clause {
 	_state = UNSATISFIED;
 
 	_tag = WHITE;
+	_lbd = NONE;
 
 	_implied_var = NULL;
 
@@ -231,6 +239,9 @@ class SAT_Clause : public Clause {
 
     inline int size() { return literals().size(); }
 
+    inline int &LBD() { return _lbd; }       // Levels of literals when learnt
+    inline int learnt() { return _lbd != NONE; }
+
     inline SAT_ClauseListPtr traverse_ref() { return _traverse_ref; }
     inline SAT_ClauseListPtr consist_ref() { return _consist_ref; }
 
@@ -268,6 +279,7 @@ class SAT_Clause : public Clause {
     int _thres;       // Threshold that for clause to be satisfied
 
     int _tag;         // General purpose tag associated with each clause
+    int _lbd;         // Number of DLevels when learnt, or NONE if not learnt
 
     SAT_VariablePtr _implied_var;       // Var implied due to clause being unit
 
@@ -327,6 +339,35 @@ class Decision {
   private:
 
 };
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Gate
+//
+// Purpose: Definition of a variable as the AND of two literals, for
+//          instances created from circuits. The clauses of the definition
+//          are kept in the clause database as any other clauses.
+//-----------------------------------------------------------------------------
+
+class SAT_Gate {
+  public:
+    SAT_Gate (SAT_VariablePtr nout, SAT_VariablePtr nin0, int nsign0,
+	      SAT_VariablePtr nin1, int nsign1) {
+	_output = nout;
+	_input[0] = nin0; _sign[0] = nsign0;
+	_input[1] = nin1; _sign[1] = nsign1;
+    }
+    virtual ~SAT_Gate() {}
+
+    inline SAT_VariablePtr output() { return _output; }
+    inline SAT_VariablePtr input (int k) { return _input[k]; }
+    inline int sign (int k) { return _sign[k]; }        // TRUE if negated
+
+  protected:
+    SAT_VariablePtr _output;
+    SAT_VariablePtr _input[2];
+    int _sign[2];
+};
 
 
 //-----------------------------------------------------------------------------
@@ -347,21 +388,18 @@ class SAT_ClauseDatabase : public ClauseDatabase {
     SAT_ClauseDatabase (SAT_Mode &nmode) :
     ClauseDatabase(), _unitClauses(), _unsatClauses(),
     _impliedVariables(), _unassignedVariables(), _taggedClauses(),
-    _decision(0), _mode(nmode) {
+    _decision(0), _mode(nmode), _gates(0) {
 	_satisfied_clauses = 0;_DLevel = NONE;
+	_gate_number = 0;
 	_initial_var_number = 0;
 	_initial_cl_number = 0;
 	_initial_lit_number = 0;
 	_lit_number = 0;
 	_dec_number = 0;
+	_prop_number = 0;
 	_max_tree_depth = 0;
     }
-    virtual ~SAT_ClauseDatabase() {
-	_decision.resize(0);
-	_avail_decisions.erase();
-	_impliedVariables.erase();
-	_unassignedVariables.erase();
-    }
+    virtual ~SAT_ClauseDatabase();
 
     //-------------------------------------------------------------------------
     // Interface contract.
@@ -369,6 +407,7 @@ class SAT_ClauseDatabase : public ClauseDatabase {
     //-------------------------------------------------------------------------
 
     inline SAT_VariablePtr add_variable (char *vname = NULL) {
+	MEM_POOL_SCOPE(_pool);
 	SAT_VariablePtr var = new SAT_Variable (vname, _varIDs++);
 	_variables.append (var->cnf_ref());
 	return var;
@@ -388,6 +427,7 @@ class SAT_ClauseDatabase : public ClauseDatabase {
     }
 
     inline SAT_ClausePtr add_clause() {
+	MEM_POOL_SCOPE(_pool);
 	SAT_ClausePtr cl = new SAT_Clause();
 	_clauses.append (cl->cnf_ref());
 	_unsatClauses.append (cl->consist_ref());
@@ -410,6 +450,7 @@ class SAT_ClauseDatabase : public ClauseDatabase {
     }
     inline LiteralPtr add_literal (SAT_ClausePtr cl,
 				   SAT_VariablePtr var, int sign) {
+	MEM_POOL_SCOPE(_pool);
 	int c_state = cl->state();
 
 	LiteralPtr lit = new Literal (cl, var, sign);
@@ -443,6 +484,19 @@ class SAT_ClauseDatabase : public ClauseDatabase {
 	delete lit;
     }
 
+    //-------------------------------------------------------------------------
+    // Definitions of gates, if the instance was created from a circuit.
+    // Gates are indexed by the IDs of their outputs.
+    //-------------------------------------------------------------------------
+
+    virtual SAT_GatePtr add_gate (SAT_VariablePtr out,
+				  SAT_VariablePtr in0, int sign0,
+				  SAT_VariablePtr in1, int sign1);
+    inline SAT_GatePtr gate (SAT_VariablePtr var) {
+	return (var->ID() < _gates.size()) ? _gates[var->ID()] : NULL;
+    }
+    inline int gate_number() { return _gate_number; }
+
     //-------------------------------------------------------------------------
     // **B** Functions used for conducting the search, by keeping internal
     //       information updated.
@@ -451,6 +505,9 @@ class SAT_ClauseDatabase : public ClauseDatabase {
     virtual void init();               // Prepare DB for search, ie alloc space
     virtual void clear();              // Prepare variables for instance of SAT
     virtual void reset();                 // Search-independent reset procedure
+    virtual void erase();              // Delete instance, ie clauses and vars
+
+    inline MemPool &pool() { return _pool; }      // Pool used by the database
 
     virtual int solution_found()
 	{ return (_clauses.size() == _satisfied_clauses); }
@@ -483,6 +540,9 @@ class SAT_ClauseDatabase : public ClauseDatabase {
 
     virtual int resources_exceeded (SAT_ClauseDatabase &clDB);
 
+    inline int &dec_number() { return _dec_number; }    // Eg for checkpoints
+    inline long prop_number() { return _prop_number; }   // Implied assignments
+
     virtual void dump (ostream &outs = cout) { dump (FALSE, outs); }
     virtual void dump (int incremental, ostream &outs = cout);
 
@@ -505,6 +565,7 @@ class SAT_ClauseDatabase : public ClauseDatabase {
 	      Warn("Implying variable already assigned?"););
 	var->set_state (nval, nDLevel, antec);
 	_impliedVariables.append (var->assign_ref());
+	_prop_number++;
     }
     inline void set_assigned_variable (SAT_VariablePtr var) {
 	_decision[var->DLevel()]->assignedVariables()
@@ -675,6 +736,8 @@ class SAT_ClauseDatabase : public ClauseDatabase {
     // Variable definitions.
     //-------------------------------------------------------------------------
 
+    MemPool _pool;                 // Pool of variables, clauses and literals
+
     int _DLevel;                    // Decision level associated with decisions
 
     SAT_ClauseList _unitClauses;                        // List of unit clauses
@@ -701,8 +764,13 @@ class SAT_ClauseDatabase : public ClauseDatabase {
     SAT_VariableList _unassignedVariables;
     SAT_ClauseList _taggedClauses;                    // List of tagged clauses
 
+    Array<SAT_GatePtr> _gates;                 // Gates defining variables
+    int _gate_number;
+    void erase_gates();
+
   protected:                                   // Variables for stats gathering
     int _dec_number;
+    long _prop_number;
     int _max_tree_depth;
     int _initial_var_number;
     int _initial_cl_number;
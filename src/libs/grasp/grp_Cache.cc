@@ -0,0 +1,873 @@
+//-----------------------------------------------------------------------------
+// File: grp_Cache.cc
+//
+// Purpose: Member functions of the cache of preprocessed instances.
+//
+// Remarks: Keys are pairs of 64-bit hashes. The canonical key of an
+//          instance does not depend on the order of clauses, nor on the
+//          order of literals in clauses. Entries are checked for layout,
+//          checksum and key before being used, and invalid files are
+//          removed. Only one process evicts files at a time, which is
+//          serialized by flock() on a lock file of the cache.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <utime.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/file.h>
+#include <iostream.h>
+
+#include "grp_Cache.hh"
+
+
+# define CACHE_BUFFER_SIZE  (1 << 16)            // Bytes hashed per read
+# define CACHE_NAME_SIZE    64                   // Longest name of a file
+# define CACHE_ENTRY_SUFFIX ".pre"
+# define CACHE_ALIAS_SUFFIX ".key"
+# define CACHE_TEMP_PREFIX  ".tmp."
+# define CACHE_LOCK_NAME    ".lock"
+# define CHECKSUM_BASIS     0xcbf29ce484222325UL
+# define CHECKSUM_PRIME     0x100000001b3UL
+# define HASH_PRIME0        0x9e3779b97f4a7c15UL
+# define HASH_PRIME1        0xc2b2ae3d27d4eb4fUL
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static inline unsigned long mix_key (unsigned long x)
+{
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9UL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebUL;
+    return x ^ (x >> 31);
+}
+
+static inline unsigned long checksum_words (unsigned long sum,
+					    unsigned int *words,
+					    unsigned long number)
+{
+    for (unsigned long k = 0; k < number; k++) {
+	sum = (sum ^ words[k]) * CHECKSUM_PRIME;
+    }
+    return sum;
+}
+
+static int write_data (int fd, char *data, unsigned long size)
+{
+    while (size > 0) {
+	ssize_t count = write (fd, data, size);
+	if (count < 0 && errno == EINTR) {
+	    continue;
+	}
+	if (count <= 0) {
+	    return FALSE;
+	}
+	data += count;
+	size -= count;
+    }
+    return TRUE;
+}
+
+static inline int encode_literal (LiteralPtr lit)
+{
+    int vID = lit->variable()->ID() + 1;
+    return (lit->sign()) ? -vID : vID;
+}
+
+static inline int valid_literal (int lit, int var_number)
+{
+    return lit != 0 && lit >= -var_number && lit <= var_number;
+}
+
+static int has_suffix (char *name, const char *suffix)
+{
+    int length = strlen (name), slength = strlen (suffix);
+    return length >= slength && !strcmp (name + length - slength, suffix);
+}
+
+
+//-----------------------------------------------------------------------------
+// Files of the cache, as considered for eviction.
+//-----------------------------------------------------------------------------
+
+struct CacheFile {
+    char name[CACHE_NAME_SIZE];
+    unsigned long size;
+    long mtime;
+};
+
+static int compare_files (const void *file1, const void *file2)
+{
+    long t1 = ((CacheFile*) file1)->mtime, t2 = ((CacheFile*) file2)->mtime;
+    return (t1 < t2) ? -1 : (t1 > t2) ? 1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: valid_entry()
+//
+// Purpose: Checks the layout, the checksum and the contents of an entry,
+//          such that the database can be built without further checks.
+//-----------------------------------------------------------------------------
+
+static int valid_entry (SAT_CacheHeader *entry, unsigned long size,
+			SAT_CacheKey key)
+{
+    SAT_CacheHeader &header = *entry;
+    if (size < sizeof(SAT_CacheHeader) ||
+	memcmp (header.magic, SAT_CACHE_MAGIC, SAT_CACHE_MAGIC_SIZE) ||
+	header.version != SAT_CACHE_VERSION ||
+	header.header_size != sizeof(SAT_CacheHeader) ||
+	header.entry_size != size ||
+	header.key[0] != key[0] || header.key[1] != key[1] ||
+	header.var_number < 0 || header.cl_number < 0 ||
+	header.gate_number < 0 || header.elim_number < 0 ||
+	header.elim_lit_number < 0 ||
+	header.names_pos != (unsigned long) header.header_size ||
+	header.offsets_pos % sizeof(unsigned long) ||
+	header.offsets_pos < header.names_pos ||
+	header.lits_pos != header.offsets_pos +
+	(header.cl_number + 1) * sizeof(unsigned long) ||
+	header.gates_pos != header.lits_pos +
+	header.lit_number * sizeof(int) ||
+	header.elim_pos != header.gates_pos +
+	5 * header.gate_number * sizeof(int) ||
+	header.entry_size != header.elim_pos +
+	(2 * header.elim_number + header.elim_lit_number) * sizeof(int)) {
+	return FALSE;
+    }
+    char *base = (char*) entry;
+    unsigned int *words = (unsigned int*) (base + header.names_pos);
+    unsigned long number = (header.entry_size - header.names_pos) / 4;
+    if (checksum_words (CHECKSUM_BASIS, words, number) != header.checksum) {
+	return FALSE;
+    }
+    int names = 0;                            // Each name ends with a '\0'
+    for (char *pos = base + header.names_pos;
+	 pos < base + header.offsets_pos; pos++) {
+	if (!*pos && ++names == header.var_number) {
+	    break;
+	}
+    }
+    if (names != header.var_number) {
+	return FALSE;
+    }
+    unsigned long *offs = (unsigned long*) (base + header.offsets_pos);
+    if (offs[0] != 0 || offs[header.cl_number] != header.lit_number) {
+	return FALSE;
+    }
+    for (int k = 0; k < header.cl_number; k++) {
+	if (offs[k] > offs[k+1]) {
+	    return FALSE;
+	}
+    }
+    int vnum = header.var_number;
+    int *lits = (int*) (base + header.lits_pos);
+    for (unsigned long j = 0; j < header.lit_number; j++) {
+	if (!valid_literal (lits[j], vnum)) {
+	    return FALSE;
+	}
+    }
+    int *gates = (int*) (base + header.gates_pos);
+    for (int k = 0; k < 5 * header.gate_number; k += 5) {
+	if (gates[k] < 0 || gates[k] >= vnum ||
+	    gates[k+1] < 0 || gates[k+1] >= vnum ||
+	    gates[k+3] < 0 || gates[k+3] >= vnum) {
+	    return FALSE;
+	}
+    }
+    int *elim = (int*) (base + header.elim_pos);
+    int elim_num = header.elim_number;
+    for (int k = 0; k < elim_num; k++) {
+	int end = (k+1 < elim_num) ?
+	    elim[elim_num+k+1] : header.elim_lit_number;
+	if (elim[k] < 0 || elim[k] >= vnum ||
+	    elim[elim_num+k] < 0 || elim[elim_num+k] > end) {
+	    return FALSE;
+	}
+    }
+    int *elits = elim + 2 * elim_num;
+    for (int j = 0; j < header.elim_lit_number; j++) {
+	if (elits[j] && !valid_literal (elits[j], vnum)) {
+	    return FALSE;
+	}
+    }
+    if (header.elim_lit_number && elits[header.elim_lit_number-1]) {
+	return FALSE;                           // Last clause not terminated
+    }
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_Cache::SAT_Cache (SAT_Mode &nmode) : _mode(nmode), _elim_data(0)
+{
+    char default_dir[CACHE_NAME_SIZE];
+    char *dir = getenv (SAT_CACHE_ENV);
+    if (!dir || !*dir) {
+	sprintf (default_dir, "/tmp/nsat-cache-%d", (int) getuid());
+	dir = default_dir;
+    }
+    _dir = new char[strlen (dir) + 1];
+    strcpy (_dir, dir);
+    _path = new char[strlen (dir) + CACHE_NAME_SIZE];
+    _dir_ready = FALSE;
+    _has_key = _has_file_key = FALSE;
+    _loaded = FALSE;
+    _names = NULL;
+    _elim_number = _elim_lit_number = 0;
+    _status = NO_CONFLICT;
+}
+
+SAT_Cache::~SAT_Cache()
+{
+    delete[] _dir;
+    delete[] _path;
+    if (_names) {
+	delete[] _names;
+    }
+    _elim_data.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: load_CDB()
+//
+// Purpose: Builds the clause database from the entry of the contents of a
+//          file, if any. Returns FALSE if the file has no entry, in which
+//          case the instance is to be parsed, and then find_CDB() invoked.
+//
+// Side-effects: The key of the contents of the file is kept.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::load_CDB (char *fname, SAT_ClauseDatabase &clDB)
+{
+    _has_key = _has_file_key = FALSE;
+    _loaded = FALSE;
+    if (!enabled() || !open_directory()) {
+	return FALSE;
+    }
+    int fd = open (fname, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    file_key (fd, _file_key);
+    close (fd);
+    _has_file_key = TRUE;
+    return read_alias() && read_entry (clDB);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: find_CDB()
+//
+// Purpose: Finds the entry of the instance just loaded into the clause
+//          database. If there is one, the database is rebuilt from it and
+//          TRUE is returned.
+//
+// Side-effects: The canonical key of the instance is kept. The file the
+//               instance was loaded from becomes an alias of the entry,
+//               and files are evicted if the cache exceeds its size.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::find_CDB (SAT_ClauseDatabase &clDB)
+{
+    if (!enabled() || !open_directory()) {
+	return FALSE;
+    }
+    instance_key (clDB, salt(), _key);
+    _has_key = TRUE;
+    if (!read_entry (clDB)) {
+	return FALSE;
+    }
+    if (_has_file_key && write_alias()) {
+	evict();
+    }
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: restore()
+//
+// Purpose: Hands the eliminated clauses of the entry loaded to the
+//          elimination engine, in place of eliminating variables. Returns
+//          CONFLICT if the instance was found unsat when preprocessed.
+//
+// Notes: The engine must have been initialized for the database.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::restore (SAT_ClauseDatabase &clDB, EliminationEngine *elimEng)
+{
+    if (elimEng && _elim_number) {
+	elimEng->restore (_elim_number, &_elim_data[0],
+			  &_elim_data[_elim_number], _elim_lit_number,
+			  &_elim_data[2*_elim_number]);
+    }
+    return _status;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: store()
+//
+// Purpose: Stores the instance once preprocessed, unless it was loaded from
+//          an entry. status is the outcome of preprocessing.
+//
+// Side-effects: Least recently used files are evicted if the cache exceeds
+//               its size.
+//
+// Notes: Must be invoked before any clause is learnt or any variable is
+//        assigned, ie right after preprocessing.
+//-----------------------------------------------------------------------------
+
+void SAT_Cache::store (SAT_ClauseDatabase &clDB, EliminationEngine *elimEng,
+		       int status)
+{
+    if (!enabled() || _loaded || !_has_key || !open_directory()) {
+	return;
+    }
+    if (write_entry (clDB, elimEng, status)) {
+	if (_has_file_key) {
+	    write_alias();
+	}
+	evict();
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: read_alias()
+//
+// Purpose: Reads the canonical key of the instance from the alias of the
+//          contents of the file. Returns FALSE if there is no valid alias.
+//
+// Side-effects: The alias is marked as used, ie its time is updated.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::read_alias()
+{
+    char *name = path (_file_key, CACHE_ALIAS_SUFFIX);
+    int fd = open (name, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    SAT_CacheAlias alias;
+    int size = read (fd, &alias, sizeof(alias));
+    close (fd);
+    if (size != sizeof(alias) ||
+	memcmp (alias.magic, SAT_CACHE_ALIAS, SAT_CACHE_MAGIC_SIZE) ||
+	alias.version != SAT_CACHE_VERSION ||
+	alias.alias_size != sizeof(alias) ||
+	alias.file_key[0] != _file_key[0] ||
+	alias.file_key[1] != _file_key[1]) {
+	unlink (name);
+	return FALSE;
+    }
+    utime (name, NULL);
+    _key[0] = alias.key[0];
+    _key[1] = alias.key[1];
+    _has_key = TRUE;
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: read_entry()
+//
+// Purpose: Builds the clause database from the entry of the canonical key,
+//          which is mapped while building. Returns FALSE if there is no
+//          valid entry, in which case the database is left unchanged.
+//
+// Side-effects: The database is erased and built, and the entry is marked
+//               as used. Invalid entries are removed.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::read_entry (SAT_ClauseDatabase &clDB)
+{
+    char *name = path (_key, CACHE_ENTRY_SUFFIX);
+    int fd = open (name, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    struct stat fstatus;
+    if (fstat (fd, &fstatus) < 0 ||
+	fstatus.st_size < (off_t) sizeof(SAT_CacheHeader)) {
+	close (fd);
+	unlink (name);
+	return FALSE;
+    }
+    unsigned long size = fstatus.st_size;
+    void *area = mmap (NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+    if (area == MAP_FAILED) {
+	return FALSE;
+    }
+    SAT_CacheHeader &header = *((SAT_CacheHeader*) area);
+    if (!valid_entry (&header, size, _key)) {
+	munmap ((char*) area, size);
+	unlink (name);
+	return FALSE;
+    }
+    utime (name, NULL);
+    madvise (area, size, MADV_SEQUENTIAL);
+
+    if (clDB.variables().size()) {
+	clDB.erase();
+    }
+    char *base = (char*) area;
+    if (_names) {
+	delete[] _names;                    // No longer used by any database
+    }
+    _names = new char[header.offsets_pos - header.names_pos];
+    memcpy (_names, base + header.names_pos,
+	    header.offsets_pos - header.names_pos);
+
+    Array<SAT_VariablePtr> variables (header.var_number);
+    char *vname = _names;
+    for (int k = 0; k < header.var_number; k++) {
+	variables[k] = clDB.add_variable ((*vname) ? vname : (char*) NULL);
+	vname += strlen (vname) + 1;
+    }
+    unsigned long *offs = (unsigned long*) (base + header.offsets_pos);
+    int *lits = (int*) (base + header.lits_pos);
+    for (int k = 0; k < header.cl_number; k++) {
+	SAT_ClausePtr clause = clDB.add_clause();
+	for (unsigned long j = offs[k]; j < offs[k+1]; j++) {
+	    int lit = lits[j];
+	    clDB.add_literal (clause, variables[((lit > 0) ? lit : -lit) - 1],
+			      (lit < 0));
+	}
+    }
+    int *gates = (int*) (base + header.gates_pos);
+    for (int k = 0; k < 5 * header.gate_number; k += 5) {
+	clDB.add_gate (variables[gates[k]], variables[gates[k+1]], gates[k+2],
+		       variables[gates[k+3]], gates[k+4]);
+    }
+    _elim_number = header.elim_number;
+    _elim_lit_number = header.elim_lit_number;
+    int elim_size = 2 * _elim_number + _elim_lit_number;
+    if (elim_size > _elim_data.size()) {        // Array is reused otherwise
+	_elim_data.resize (elim_size);
+    }
+    if (elim_size) {
+	memcpy (&_elim_data[0], base + header.elim_pos, elim_size*sizeof(int));
+    }
+    _status = header.status;
+    _loaded = TRUE;
+    munmap ((char*) area, size);
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: write_entry()
+//
+// Purpose: Writes the entry of the instance in the clause database, with
+//          the eliminated clauses of the elimination engine, if any.
+//          Returns FALSE if the entry is not written, eg if it would
+//          exceed the size of the cache.
+//
+// Notes: Variables must be listed by increasing ID, from ID 0.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::write_entry (SAT_ClauseDatabase &clDB,
+			    EliminationEngine *elimEng, int status)
+{
+    SAT_CacheHeader header;
+    memset (&header, 0, sizeof(header));
+    memcpy (header.magic, SAT_CACHE_MAGIC, sizeof(header.magic));
+    header.version = SAT_CACHE_VERSION;
+    header.header_size = sizeof(header);
+    header.key[0] = _key[0];
+    header.key[1] = _key[1];
+    header.status = status;
+    header.cl_number = clDB.clauses().size();
+
+    unsigned long names_size = 0;
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	if (var->ID() != header.var_number++) {
+	    return FALSE;
+	}
+	names_size += ((var->name()) ? strlen (var->name()) : 0) + 1;
+	if (clDB.gate (var)) {
+	    header.gate_number++;
+	}
+    }
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	header.lit_number += pcl->data()->literals().size();
+    }
+    if (elimEng) {
+	header.elim_number = elimEng->elim_number();
+	header.elim_lit_number = elimEng->elim_lit_number();
+    }
+    header.names_pos = header.header_size;
+    header.offsets_pos = header.names_pos +
+	((names_size + sizeof(unsigned long) - 1) &
+	 ~(sizeof(unsigned long) - 1));
+    header.lits_pos = header.offsets_pos +
+	(header.cl_number + 1) * sizeof(unsigned long);
+    header.gates_pos = header.lits_pos + header.lit_number * sizeof(int);
+    header.elim_pos = header.gates_pos +
+	5 * header.gate_number * sizeof(int);
+    header.entry_size = header.elim_pos +
+	(2 * header.elim_number + header.elim_lit_number) * sizeof(int);
+    if (header.entry_size > ((unsigned long) _mode[_CACHE_SIZE_] << 20)) {
+	return FALSE;
+    }
+
+    char *data = new char[header.entry_size];
+    memset (data + header.names_pos, 0,
+	    header.offsets_pos - header.names_pos);
+    char *vname = data + header.names_pos;
+    unsigned long *offs = (unsigned long*) (data + header.offsets_pos);
+    int *lits = (int*) (data + header.lits_pos);
+    int *gates = (int*) (data + header.gates_pos);
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	if (var->name()) {
+	    strcpy (vname, var->name());
+	    vname += strlen (var->name());
+	}
+	*vname++ = '\0';
+	SAT_GatePtr gate = clDB.gate (var);
+	if (gate) {
+	    *gates++ = gate->output()->ID();
+	    *gates++ = gate->input(0)->ID();
+	    *gates++ = gate->sign(0);
+	    *gates++ = gate->input(1)->ID();
+	    *gates++ = gate->sign(1);
+	}
+    }
+    unsigned long offset = 0;
+    *offs++ = offset;
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	for_each(plit, pcl->data()->literals(), LiteralPtr) {
+	    lits[offset++] = encode_literal (plit->data());
+	}
+	*offs++ = offset;
+    }
+    if (elimEng) {
+	int *elim = (int*) (data + header.elim_pos);
+	for (int k = 0; k < header.elim_number; k++) {
+	    elim[k] = elimEng->elim_vars()[k];
+	    elim[header.elim_number+k] = elimEng->elim_start()[k];
+	}
+	elim += 2 * header.elim_number;
+	for (int j = 0; j < header.elim_lit_number; j++) {
+	    elim[j] = elimEng->elim_lits()[j];
+	}
+    }
+    unsigned int *words = (unsigned int*) (data + header.names_pos);
+    unsigned long number = (header.entry_size - header.names_pos) / 4;
+    header.checksum = checksum_words (CHECKSUM_BASIS, words, number);
+    memcpy (data, &header, sizeof(header));
+
+    int ok = write_file (path (_key, CACHE_ENTRY_SUFFIX), data,
+			 header.entry_size);
+    delete[] data;
+    return ok;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: write_alias()
+//
+// Purpose: Makes the contents of the file an alias of the entry of the
+//          canonical key.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::write_alias()
+{
+    SAT_CacheAlias alias;
+    memset (&alias, 0, sizeof(alias));
+    memcpy (alias.magic, SAT_CACHE_ALIAS, sizeof(alias.magic));
+    alias.version = SAT_CACHE_VERSION;
+    alias.alias_size = sizeof(alias);
+    alias.file_key[0] = _file_key[0];
+    alias.file_key[1] = _file_key[1];
+    alias.key[0] = _key[0];
+    alias.key[1] = _key[1];
+    return write_file (path (_file_key, CACHE_ALIAS_SUFFIX),
+		       (char*) &alias, sizeof(alias));
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: write_file()
+//
+// Purpose: Writes a file of the cache. The file is replaced only once it
+//          is complete, hence other processes either read the former file
+//          or the new one. Returns FALSE if the file cannot be written.
+//
+// Notes: Temporary files are named by the process and by the cache object,
+//        hence are never shared.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::write_file (char *fname, char *data, unsigned long size)
+{
+    char *tmp_name = new char[strlen (_dir) + CACHE_NAME_SIZE];
+    sprintf (tmp_name, "%s/%s%d.%lx", _dir, CACHE_TEMP_PREFIX,
+	     (int) getpid(), (unsigned long) this);
+    int fd = open (tmp_name, O_WRONLY|O_CREAT|O_TRUNC, 0600);
+    int ok = (fd >= 0);
+    if (ok) {
+	ok = write_data (fd, data, size);
+	ok = (close (fd) == 0) && ok;
+    }
+    if (!ok || rename (tmp_name, fname) < 0) {
+	unlink (tmp_name);
+	ok = FALSE;
+    }
+    delete[] tmp_name;
+    return ok;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: evict()
+//
+// Purpose: Removes the least recently used files until the cache no longer
+//          exceeds its size. Temporary files are removed once abandoned.
+//
+// Notes: Nothing is done if another process is evicting files. Files that
+//        are removed while read remain readable by their readers.
+//-----------------------------------------------------------------------------
+
+void SAT_Cache::evict()
+{
+    unsigned long limit = (unsigned long) _mode[_CACHE_SIZE_] << 20;
+    char *name = new char[strlen (_dir) + CACHE_NAME_SIZE];
+    sprintf (name, "%s/%s", _dir, CACHE_LOCK_NAME);
+    int lock_fd = open (name, O_RDWR|O_CREAT, 0600);
+    if (lock_fd < 0 || flock (lock_fd, LOCK_EX|LOCK_NB) < 0) {
+	if (lock_fd >= 0) { close (lock_fd); }
+	delete[] name;
+	return;
+    }
+    Array<CacheFile> files (0);
+    int file_number = 0;
+    unsigned long total = 0;
+    long now = time (NULL);
+
+    DIR *dir = opendir (_dir);
+    struct dirent *dentry;
+    while (dir && (dentry = readdir (dir))) {
+	char *fname = dentry->d_name;
+	int temp = !strncmp (fname, CACHE_TEMP_PREFIX,
+			     strlen (CACHE_TEMP_PREFIX));
+	struct stat fstatus;
+	if (strlen (fname) >= CACHE_NAME_SIZE ||
+	    (!temp && !has_suffix (fname, CACHE_ENTRY_SUFFIX) &&
+	     !has_suffix (fname, CACHE_ALIAS_SUFFIX))) {
+	    continue;                             // Not a file of the cache
+	}
+	sprintf (name, "%s/%s", _dir, fname);
+	if (stat (name, &fstatus) < 0 || !S_ISREG (fstatus.st_mode)) {
+	    continue;
+	}
+	if (temp && now - fstatus.st_mtime > SAT_CACHE_TEMP_AGE) {
+	    unlink (name);                            // Writer was terminated
+	    continue;
+	}
+	total += fstatus.st_size;
+	if (temp) {
+	    continue;                             // Still being written
+	}
+	if (file_number >= files.size()) {
+	    files.resize (2*file_number + 16);
+	}
+	strcpy (files[file_number].name, fname);
+	files[file_number].size = fstatus.st_size;
+	files[file_number++].mtime = fstatus.st_mtime;
+    }
+    if (dir) {
+	closedir (dir);
+    }
+    if (total > limit && file_number > 0) {
+	qsort (&files[0], file_number, sizeof(CacheFile), compare_files);
+	for (int k = 0; k < file_number && total > limit; k++) {
+	    sprintf (name, "%s/%s", _dir, files[k].name);
+	    unlink (name);
+	    total -= files[k].size;
+	}
+    }
+    flock (lock_fd, LOCK_UN);
+    close (lock_fd);
+    delete[] name;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: open_directory()
+//
+// Purpose: Creates the directory of the cache if it does not exist.
+//          Returns FALSE if the directory cannot be created.
+//-----------------------------------------------------------------------------
+
+int SAT_Cache::open_directory()
+{
+    if (!_dir_ready) {
+	if (mkdir (_dir, 0700) < 0 && errno != EEXIST) {
+	    return FALSE;
+	}
+	_dir_ready = TRUE;
+    }
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: file_key()
+//
+// Purpose: Computes the key of the contents of a file, for the options
+//          that change the instance loaded from the file.
+//
+// Notes: Files are hashed by words of 8 bytes, the last one padded with
+//        zeros.
+//-----------------------------------------------------------------------------
+
+void SAT_Cache::file_key (int fd, SAT_CacheKey key)
+{
+    char buffer[CACHE_BUFFER_SIZE];
+    unsigned long h0 = mix_key (salt() ^ mix_key (_mode[_AIG_OUTPUT_] +
+						  HASH_PRIME1));
+    unsigned long h1 = mix_key (h0 ^ HASH_PRIME1);
+    unsigned long length = 0;
+    for (;;) {
+	int size = 0;                               // Fill buffer if possible
+	while (size < CACHE_BUFFER_SIZE) {
+	    int count = read (fd, buffer + size, CACHE_BUFFER_SIZE - size);
+	    if (count < 0 && errno == EINTR) {
+		continue;
+	    }
+	    if (count <= 0) {
+		break;
+	    }
+	    size += count;
+	}
+	if (size == 0) {
+	    break;
+	}
+	length += size;
+	if (size % sizeof(unsigned long)) {
+	    int pad = sizeof(unsigned long) - size % sizeof(unsigned long);
+	    memset (buffer + size, 0, pad);
+	    size += pad;
+	}
+	for (int k = 0; k < size; k += sizeof(unsigned long)) {
+	    unsigned long word;
+	    memcpy (&word, buffer + k, sizeof(word));
+	    h0 = (h0 ^ word) * HASH_PRIME0;
+	    h0 ^= h0 >> 32;
+	    h1 = (h1 + word) * HASH_PRIME1;
+	    h1 ^= h1 >> 29;
+	}
+	if (size < CACHE_BUFFER_SIZE) {
+	    break;
+	}
+    }
+    key[0] = mix_key (h0 ^ length);
+    key[1] = mix_key (h1 + length);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: instance_key()
+//
+// Purpose: Computes the canonical key of the instance in the clause
+//          database, ie of the names of its variables by ID, and of the
+//          sets of its clauses and of its gates.
+//
+// Notes: Literals and clauses are combined by sums, hence their order is
+//        irrelevant. Learnt clauses are not part of the instance.
+//-----------------------------------------------------------------------------
+
+void SAT_Cache::instance_key (SAT_ClauseDatabase &clDB, unsigned long salt,
+			      SAT_CacheKey key)
+{
+    unsigned long vars[2], cls[2], gates[2];
+    vars[0] = mix_key (salt);
+    vars[1] = mix_key (vars[0] ^ HASH_PRIME1);
+    cls[0] = cls[1] = gates[0] = gates[1] = 0;
+
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	unsigned long h = mix_key (var->ID() + HASH_PRIME0);
+	for (char *name = var->name(); name && *name; name++) {
+	    h = (h ^ (unsigned char) *name) * CHECKSUM_PRIME;
+	}
+	vars[0] = mix_key (vars[0] ^ h);
+	vars[1] = mix_key (vars[1] + h * HASH_PRIME1);
+
+	SAT_GatePtr gate = clDB.gate (var);
+	if (gate) {
+	    unsigned long g = mix_key (gate->output()->ID() + HASH_PRIME0);
+	    for (int k = 0; k < 2; k++) {
+		g = mix_key (g ^ (2 * gate->input(k)->ID() + gate->sign(k)));
+	    }
+	    gates[0] += g;
+	    gates[1] += mix_key (g ^ HASH_PRIME1);
+	}
+    }
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	if (((SAT_ClausePtr) pcl->data())->learnt()) {
+	    continue;
+	}
+	unsigned long c0 = pcl->data()->literals().size(), c1 = c0;
+	for_each(plit, pcl->data()->literals(), LiteralPtr) {
+	    long lit = encode_literal (plit->data());
+	    c0 += mix_key (lit * HASH_PRIME0);
+	    c1 += mix_key (lit * HASH_PRIME1 + 1);
+	}
+	cls[0] += mix_key (c0);
+	cls[1] += mix_key (c1 ^ HASH_PRIME0);
+    }
+    key[0] = mix_key (vars[0] ^ mix_key (cls[0] ^ mix_key (gates[0])));
+    key[1] = mix_key (vars[1] + mix_key (cls[1] + mix_key (gates[1])));
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: path()
+//
+// Purpose: Returns the path of the file of a key, which is valid until the
+//          next path is requested.
+//-----------------------------------------------------------------------------
+
+char *SAT_Cache::path (SAT_CacheKey key, const char *suffix)
+{
+    sprintf (_path, "%s/%016lx%016lx%s", _dir, key[0], key[1], suffix);
+    return _path;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: salt()
+//
+// Purpose: Returns the part of keys given by the version of entries, and by
+//          the options that change preprocessing.
+//-----------------------------------------------------------------------------
+
+unsigned long SAT_Cache::salt()
+{
+    return SAT_CACHE_VERSION * HASH_PRIME0 + (_mode[_ELIM_THREADS_] != NONE);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,177 @@
+//-----------------------------------------------------------------------------
+// File: grp_Cache.hh
+//
+// Purpose: Class declaration of the cache of preprocessed instances. An
+//          entry of the cache holds the clauses left by variable
+//          elimination, the gates and the names of the variables, and the
+//          eliminated clauses needed for extending solutions. Entries are
+//          found by a canonical key of the instance, ie of its variables,
+//          clauses and gates, and also by a key of the contents of the file
+//          the instance was loaded from. Hence instances found by the key
+//          of their files are neither parsed nor preprocessed.
+//
+// Remarks: The cache is a directory shared by any number of processes.
+//          Files are written to temporary files which are then renamed,
+//          hence files are never read while written. The size of the
+//          cache is bound, and least recently used files are removed
+//          first. Entries are not portable between architectures.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_CACHE__
+#define __GRP_CACHE__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_CDB.hh"
+#include "grp_Elim.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for the cache of preprocessed instances.
+//-----------------------------------------------------------------------------
+
+# define SAT_CACHE_MAGIC      "GRASPPRE"
+# define SAT_CACHE_ALIAS      "GRASPKEY"
+# define SAT_CACHE_MAGIC_SIZE 8
+# define SAT_CACHE_VERSION    1
+# define SAT_CACHE_ENV        "NSAT_CACHE"        // Directory of the cache
+# define SAT_CACHE_SIZE       256                 // Default size bound (MB)
+# define SAT_CACHE_TEMP_AGE   3600            // Age of abandoned temp files
+
+typedef unsigned long SAT_CacheKey[2];
+
+
+//-----------------------------------------------------------------------------
+// Header of an entry, stored at offset 0 of the file. The header is
+// followed by the names of the variables (each terminated by '\0'), the
+// offsets of the clauses (cl_number+1 of them, in literals), the literals,
+// the gates (output and inputs), and the eliminated variables, the start of
+// their clauses and the eliminated clauses. Literals are coded as
+// +/-(ID+1), and the checksum covers all but the header.
+//-----------------------------------------------------------------------------
+
+struct SAT_CacheHeader {
+    char magic[SAT_CACHE_MAGIC_SIZE];            // Always SAT_CACHE_MAGIC
+    int version;
+    int header_size;
+    SAT_CacheKey key;                            // Canonical key of instance
+    int status;                                  // CONFLICT if found unsat
+    int var_number;
+    int cl_number;
+    int gate_number;
+    int elim_number;
+    int elim_lit_number;
+    unsigned long lit_number;                    // Literals of all clauses
+    unsigned long names_pos;                     // Positions of the sections
+    unsigned long offsets_pos;
+    unsigned long lits_pos;
+    unsigned long gates_pos;
+    unsigned long elim_pos;
+    unsigned long entry_size;                    // Size of the file
+    unsigned long checksum;
+};
+
+
+//-----------------------------------------------------------------------------
+// Alias of an entry, ie the file named by the key of the contents of a
+// file, which holds the canonical key of the instance loaded from it.
+//-----------------------------------------------------------------------------
+
+struct SAT_CacheAlias {
+    char magic[SAT_CACHE_MAGIC_SIZE];            // Always SAT_CACHE_ALIAS
+    int version;
+    int alias_size;
+    SAT_CacheKey file_key;
+    SAT_CacheKey key;
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Cache
+//
+// Purpose: Loads instances from the cache, and stores instances once
+//          preprocessed. The cache is only used if _CACHE_SIZE_ is set.
+//
+// Notes: A cache object is used for one clause database at a time, since
+//        it keeps the keys of the instance last loaded, and the names of
+//        its variables if loaded from an entry.
+//-----------------------------------------------------------------------------
+
+class SAT_Cache {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Cache (SAT_Mode &nmode);
+    virtual ~SAT_Cache();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. load_CDB() finds the entry of the file, and
+    // find_CDB() the entry of the instance just loaded into the database,
+    // which is then rebuilt. restore() is invoked instead of preprocessing
+    // for instances loaded from entries, and store() after preprocessing
+    // other instances. Each returns CONFLICT if the instance is unsat.
+    //-------------------------------------------------------------------------
+
+    inline int enabled() { return _mode[_CACHE_SIZE_] != NONE; }
+    inline int loaded() { return _loaded; }          // Loaded from an entry?
+
+    virtual int load_CDB (char *fname, SAT_ClauseDatabase &clDB);
+    virtual int find_CDB (SAT_ClauseDatabase &clDB);
+
+    virtual int restore (SAT_ClauseDatabase &clDB,
+			 EliminationEngine *elimEng);
+    virtual void store (SAT_ClauseDatabase &clDB,
+			EliminationEngine *elimEng, int status);
+
+    //-------------------------------------------------------------------------
+    // Canonical key of the instance in a database, learnt clauses aside.
+    // Also used for keying other data of instances, with other salts.
+    //-------------------------------------------------------------------------
+
+    static void instance_key (SAT_ClauseDatabase &clDB, unsigned long salt,
+			      SAT_CacheKey key);
+
+protected:
+    virtual int read_entry (SAT_ClauseDatabase &clDB);
+    virtual int read_alias();
+    virtual int write_entry (SAT_ClauseDatabase &clDB,
+			     EliminationEngine *elimEng, int status);
+    virtual int write_alias();
+    virtual int write_file (char *fname, char *data, unsigned long size);
+    virtual void evict();
+
+    int open_directory();
+    void file_key (int fd, SAT_CacheKey key);
+    char *path (SAT_CacheKey key, const char *suffix);
+    unsigned long salt();
+
+    SAT_Mode &_mode;                                   // Configuration options
+
+    char *_dir;                                  // Directory of the cache
+    char *_path;                                 // Path of last file named
+    int _dir_ready;                              // Directory was created
+
+    SAT_CacheKey _key;                           // Keys of the instance
+    SAT_CacheKey _file_key;
+    int _has_key;
+    int _has_file_key;
+    int _loaded;                                 // Loaded from an entry
+
+    char *_names;                        // Names of variables of the entry
+    Array<int> _elim_data;                     // Eliminated clauses of entry
+    int _elim_number;
+    int _elim_lit_number;
+    int _status;
+
+};
+
+#endif // __GRP_CACHE__
+
+/*****************************************************************************/
@@ -0,0 +1,240 @@
+//-----------------------------------------------------------------------------
+// File: grp_Checkpoint.cc
+//
+// Purpose: Member functions of checkpoints of the search.
+//
+// Remarks: The copy of the search state is taken by the search itself,
+//          between conflicts, and is then written by a thread. A failed
+//          write leaves the former checkpoint in place.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream.h>
+
+#include "grp_Checkpoint.hh"
+
+
+volatile sig_atomic_t SAT_Checkpoint::_interrupted = FALSE;
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static void *checkpoint_thread (void *arg)
+{
+    SAT_Checkpoint *checkpoint = (SAT_Checkpoint*) arg;
+    checkpoint->write_pending();
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_Checkpoint::SAT_Checkpoint (SAT_Mode &nmode) : SAT_Learnt (nmode)
+{
+    _pending = NULL;
+    _pending_size = 0;
+    _writing = _written = FALSE;
+    pthread_mutex_init (&_lock, NULL);
+    _last_time = time (NULL);
+    _write_number = _fail_number = 0;
+    _catching = FALSE;
+}
+
+SAT_Checkpoint::~SAT_Checkpoint()
+{
+    stop();
+    pthread_mutex_destroy (&_lock);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: start()
+//
+// Purpose: Catches SIGTERM while the search runs, and times checkpoints
+//          from the start of the search. Counters start from those resumed,
+//          if any.
+//-----------------------------------------------------------------------------
+
+void SAT_Checkpoint::start()
+{
+    _last_time = time (NULL);
+    _write_number = _fail_number = 0;
+    _interrupted = FALSE;
+    if (!resumed()) {
+	for (int k = 0; k < CKP_STAT_NUMBER; k++) {
+	    _stats[k] = 0;
+	}
+    }
+    if (!_catching) {
+	struct sigaction action;
+	memset (&action, 0, sizeof(action));
+	action.sa_handler = catch_signal;
+	sigemptyset (&action.sa_mask);
+	action.sa_flags = SA_RESTART;
+	_catching = (sigaction (SIGTERM, &action, &_old_action) == 0);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: stop()
+//
+// Purpose: Waits for the checkpoint being written, if any, and restores the
+//          action of SIGTERM.
+//-----------------------------------------------------------------------------
+
+void SAT_Checkpoint::stop()
+{
+    wait_pending();
+    if (_catching) {
+	sigaction (SIGTERM, &_old_action, NULL);
+	_catching = FALSE;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: write()
+//
+// Purpose: Takes a checkpoint of the search, and starts writing it. Returns
+//          FALSE if the checkpoint is skipped, since another is written, or
+//          if it cannot be taken.
+//
+// Notes: The counters of the search must be set beforehand. The last
+//        checkpoint is written before returning.
+//-----------------------------------------------------------------------------
+
+int SAT_Checkpoint::write (SAT_ClauseDatabase &clDB, int last)
+{
+    _last_time = time (NULL);
+    if (_writing) {
+	pthread_mutex_lock (&_lock);
+	int written = _written;
+	pthread_mutex_unlock (&_lock);
+	if (!written && !last) {
+	    return FALSE;
+	}
+	wait_pending();
+    }
+    if (!_export_name || !_has_key) {
+	return FALSE;
+    }
+    _stats[_CKP_CHECKPOINTS_]++;
+    _stat_number = CKP_STAT_NUMBER;
+    int cl_number;
+    _pending = build_file (clDB, _pending_size, cl_number);
+    if (!_pending) {
+	return FALSE;
+    }
+    _write_number++;
+    _export_number = cl_number;
+    _written = FALSE;
+    if (last || pthread_create (&_writer, NULL, checkpoint_thread,
+				(void*) this)) {
+	write_pending();
+    }
+    else {
+	_writing = TRUE;
+    }
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: write_pending()
+//
+// Purpose: Writes the checkpoint taken last, and frees it.
+//-----------------------------------------------------------------------------
+
+void SAT_Checkpoint::write_pending()
+{
+    int ok = write_file (_pending, _pending_size);
+    delete[] _pending;
+    _pending = NULL;
+    pthread_mutex_lock (&_lock);
+    _written = TRUE;
+    if (!ok) {
+	_fail_number++;
+    }
+    pthread_mutex_unlock (&_lock);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: wait_pending()
+//
+// Purpose: Waits for the thread writing a checkpoint, if any.
+//-----------------------------------------------------------------------------
+
+void SAT_Checkpoint::wait_pending()
+{
+    if (_writing) {
+	pthread_join (_writer, NULL);
+	_writing = FALSE;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: exported()
+//
+// Purpose: Checks whether a clause is part of checkpoints, ie whether it is
+//          a learnt clause kept by the database.
+//-----------------------------------------------------------------------------
+
+int SAT_Checkpoint::exported (SAT_ClausePtr cl)
+{
+    return cl->learnt() && !cl->test_tag (GRAY|BLACK);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: exported_unit()
+//
+// Purpose: Checks whether a variable is assigned at decision level 0.
+//          Checkpoints are only taken while searching, hence the variable
+//          is then implied by the instance.
+//-----------------------------------------------------------------------------
+
+int SAT_Checkpoint::exported_unit (SAT_VariablePtr var)
+{
+    return var->value() != UNKNOWN && var->DLevel() == 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: catch_signal()
+//
+// Purpose: Handler of SIGTERM, which makes the search abort.
+//-----------------------------------------------------------------------------
+
+void SAT_Checkpoint::catch_signal (int signo)
+{
+    _interrupted = TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: output_stats()
+//
+// Purpose: Output information regarding checkpoints.
+//-----------------------------------------------------------------------------
+
+void SAT_Checkpoint::output_stats()
+{
+    printItem ("Number of clauses resumed from checkpoint", _import_number);
+    printItem ("Number of checkpoints taken", _write_number);
+    printItem ("Number of checkpoints not written", _fail_number);
+    printItem ("Number of clauses in last checkpoint", _export_number);
+    printItem();
+}
+
+/*****************************************************************************/
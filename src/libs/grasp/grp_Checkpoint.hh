@@ -0,0 +1,126 @@
+//-----------------------------------------------------------------------------
+// File: grp_Checkpoint.hh
+//
+// Purpose: Class declaration of checkpoints of the search, which let runs
+//          that are stopped, eg preempted by SIGTERM, be resumed by later
+//          runs of the same instance.
+//
+// Remarks: A checkpoint is a file of learnt clauses (see grp_Learnt.hh)
+//          that holds all the learnt clauses kept by the database, the
+//          assignments at decision level 0, the values of the variables,
+//          and the counters of the search. A resumed run starts again from
+//          decision level 0, hence only the decisions made since the last
+//          checkpoint are lost. Checkpoints are written periodically by a
+//          thread, from a copy taken by the search, hence the search does
+//          not wait for the file to be written.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_CHECKPOINT__
+#define __GRP_CHECKPOINT__
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+
+#include "grp_Learnt.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for checkpoints. Counters of the search kept by checkpoints.
+//-----------------------------------------------------------------------------
+
+enum CheckpointStats {
+    _CKP_DECISIONS_ = 0,                                 // Decisions made
+    _CKP_CONFLICTS_,                                 // Conflicts diagnosed
+    _CKP_CONF_CLAUSES_,                       // Conflicting clauses created
+    _CKP_BACKTRACKS_,                                  // Backtracks done
+    _CKP_UIPS_,                                         // UIPs identified
+    _CKP_SEARCH_TIME_,                           // CPU time searched (ms)
+    _CKP_CHECKPOINTS_                             // Checkpoints written
+    };
+
+enum { CKP_STAT_NUMBER = (_CKP_CHECKPOINTS_+1) };
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Checkpoint
+//
+// Purpose: Resumes the search from the checkpoint of its file, if any, and
+//          writes the checkpoints of the search to the same file.
+//
+// Notes: Only one checkpoint is written at a time. Checkpoints due while
+//        another is written are skipped, except the last one, which waits
+//        for it. SIGTERM is caught while the search runs, and makes the
+//        search write its last checkpoint and abort.
+//-----------------------------------------------------------------------------
+
+class SAT_Checkpoint : public SAT_Learnt {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Checkpoint (SAT_Mode &nmode);
+    virtual ~SAT_Checkpoint();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. import_file() resumes from the file, and the
+    // counters it held are then available if resumed() holds. start() is
+    // invoked when the search starts, and stop() when it ends. The search
+    // invokes write() whenever due(), and write() with last set before
+    // aborting, eg once interrupted().
+    //-------------------------------------------------------------------------
+
+    inline void set_file (char *name) { set_files (name, name); }
+
+    inline int resumed() { return _stat_number == CKP_STAT_NUMBER; }
+    inline long &stat (int k) { return _stats[k]; }
+
+    virtual void start();
+    virtual void stop();
+    inline int due() {
+	return (_mode[_CHECKPOINT_TIME_] > 0 &&
+		time (NULL) - _last_time >= _mode[_CHECKPOINT_TIME_]);
+    }
+    inline int interrupted() { return _interrupted; }
+    virtual int write (SAT_ClauseDatabase &clDB, int last);
+
+    virtual void output_stats();
+
+    //-------------------------------------------------------------------------
+    // Invoked by the thread that writes checkpoints.
+    //-------------------------------------------------------------------------
+
+    void write_pending();
+
+protected:
+    virtual int exported (SAT_ClausePtr cl);
+    virtual int exported_unit (SAT_VariablePtr var);
+    void wait_pending();
+
+    static void catch_signal (int signo);
+
+    char *_pending;                              // Checkpoint being written
+    unsigned long _pending_size;
+    int _writing;                                // Writer thread not joined
+    int _written;                                // Writer thread is done
+    pthread_t _writer;
+    pthread_mutex_t _lock;                        // Protects _written
+
+    time_t _last_time;                           // Last checkpoint taken
+    int _write_number;
+    int _fail_number;
+
+    struct sigaction _old_action;                // Action replaced on start
+    int _catching;
+    static volatile sig_atomic_t _interrupted;
+
+};
+
+#endif // __GRP_CHECKPOINT__
+
+/*****************************************************************************/
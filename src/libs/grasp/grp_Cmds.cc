@@ -9,16 +9,29 @@
 //          3/16/96 - JPMS - repackaged for new version of GRASP.
 //-----------------------------------------------------------------------------
 
+#include <string.h>
+
 #include "grp_Cmds.hh"
+#include "grp_Cache.hh"                      // Default size of the cache
 
 
 //-----------------------------------------------------------------------------
 // Constructor/destructor.
 //-----------------------------------------------------------------------------
 
-SAT_Cmds::SAT_Cmds (SAT_Mode &nmode) : _mode (nmode) {}
+SAT_Cmds::SAT_Cmds (SAT_Mode &nmode) : _mode (nmode), _file_names() {
+    _import_name = _export_name = _checkpoint_name = NULL;
+    _server_name = _command_name = NULL;
+    _valid = TRUE;
+}
 
-SAT_Cmds::~SAT_Cmds() {}
+SAT_Cmds::~SAT_Cmds() {
+    if (_import_name) { delete[] _import_name; }
+    if (_export_name) { delete[] _export_name; }
+    if (_checkpoint_name) { delete[] _checkpoint_name; }
+    if (_server_name) { delete[] _server_name; }
+    if (_command_name) { delete[] _command_name; }
+}
 
 
 //-----------------------------------------------------------------------------
@@ -115,6 +128,20 @@ void SAT_Cmds::setPreprocessMode (CmdArg &arg)
 	_mode[_PREPROC_LEVEL_] = (int) arg;
     }
 }
+
+int SAT_Cmds::setFileName (char *&name, CmdArg &arg)
+{
+    if (name) {
+	delete[] name;
+	name = NULL;
+    }
+    if (arg.isEmpty()) {
+	return FALSE;
+    }
+    name = new char[strlen ((char*) arg) + 1];
+    strcpy (name, (char*) arg);
+    return TRUE;
+}
 
 //-----------------------------------------------------------------------------
 // Parse for the input command line arguments (for batch execution).
@@ -128,7 +155,8 @@ void SAT_Cmds::setPreprocessMode (CmdArg &arg)
 //          configuring GRASP.
 //
 // Notes: See GRASP description for an overview of the default values.
-//        The file name, if any, has to be the last argument.
+//        All file names are kept (for batch execution) and the first one
+//        is returned. A single "-" denotes file names read from stdin.
 //
 // History: 6/21/95 - JPMS - created.
 // ----------------------------------------------------------------------------
@@ -142,15 +170,15 @@ char *SAT_Cmds::cmdLineParse (int argc, char *argv[])
 	if (cmd_line[k].matches("+")) {
 	    handlePlusOption (cmd_line[k] >> 1);
 	}
-	else if (cmd_line[k].matches("-")) {
+	else if (cmd_line[k].matches("-") && argv[k][1]) {
 	    handleMinusOption (cmd_line[k] >> 1);
 	}
 	else {                                             // File name assumed
 	    DBG1(cout<<"Filename: "<<argv[k]<<endl;);
-	    return argv[k];                                 // Return file name
+	    _file_names.append (argv[k]);
 	}
     }
-    return NULL;
+    return (_file_names.first()) ? _file_names.first()->data() : NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -187,6 +215,68 @@ int SAT_Cmds::handlePlusOption (CmdArg &cmd)
     else if( cmd.matches("u") ) {
 	_mode[_IDENTIFY_UIPS_] = TRUE;
     }
+    else if (cmd.matches("w")) {                      // Workers in batch mode
+	_mode[_BATCH_WORKERS_] = (int) (cmd >> 1);
+    }
+    else if (cmd.matches("e")) {          // Variable elimination w/ threads
+	int threads = (int) (cmd >> 1);
+	_mode[_ELIM_THREADS_] = (threads > 1) ? threads : 1;
+    }
+    else if (cmd.matches("l")) {                // Local search w/ threads
+	int threads = (int) (cmd >> 1);
+	_mode[_LOCAL_THREADS_] = (threads > 1) ? threads : 1;
+    }
+    else if (cmd.matches("L")) {           // Loading of CNF files w/ threads
+	int threads = (int) (cmd >> 1);
+	_mode[_LOAD_THREADS_] = (threads > 1) ? threads : 1;
+    }
+    else if (cmd.matches("o")) {              // Output of circuits checked
+	_mode[_AIG_OUTPUT_] = (int) (cmd >> 1);
+    }
+    else if (cmd.matches("P")) {         // Prefetch of instances in batch mode
+	_mode[_PREFETCH_] = TRUE;
+    }
+    else if (cmd.matches("K")) {        // Cache of preprocessed instances
+	int size = (int) (cmd >> 1);
+	_mode[_CACHE_SIZE_] = (size > 0) ? size : SAT_CACHE_SIZE;
+    }
+    else if (cmd.matches("R")) {         // Import learnt clauses from file
+	if (!setFileName (_import_name, cmd >> 1)) {
+	    cout << "\n    Option +R requires a file name" << endl << endl;
+	    return FALSE;
+	}
+    }
+    else if (cmd.matches("W")) {           // Export learnt clauses to file
+	if (!setFileName (_export_name, cmd >> 1)) {
+	    cout << "\n    Option +W requires a file name" << endl << endl;
+	    return FALSE;
+	}
+    }
+    else if (cmd.matches("X")) {          // Checkpoints of search in file
+	if (!setFileName (_checkpoint_name, cmd >> 1)) {
+	    cout << "\n    Option +X requires a file name" << endl << endl;
+	    return FALSE;
+	}
+    }
+    else if (cmd.matches("U")) {      // On-line mode on a Unix domain socket
+	if (!setFileName (_server_name, cmd >> 1)) {
+	    cout << "\n    Option +U requires a file name" << endl << endl;
+	    return FALSE;
+	}
+    }
+    else if (cmd.matches("x")) {           // Seconds between checkpoints
+	_mode[_CHECKPOINT_TIME_] = (int) (cmd >> 1);
+    }
+    else if (cmd.matches("G")) {          // Largest LBD of exported clauses
+	_mode[_LEARNT_LBD_] = (int) (cmd >> 1);
+    }
+    else if (cmd.matches("Z")) {         // Largest size of exported clauses
+	_mode[_LEARNT_SIZE_] = (int) (cmd >> 1);
+    }
+    else if (cmd.matches("I")) {                 // Write image of instance
+	_mode[_WRITE_IMAGE_] = ((cmd >> 1).matches("F")) ?
+	    _UNCHECKED_IMAGE_ : _CHECKED_IMAGE_;
+    }
     else if (cmd.matches("B")) {
 	_mode[_BACKTRACK_LIMIT_] = (int) (cmd >> 1);
     }
@@ -199,6 +289,20 @@ int SAT_Cmds::handlePlusOption (CmdArg &cmd)
     else if (cmd.matches("S")) {
 	_mode[_SPACE_LIMIT_] = (int) (cmd >> 1);
     }
+    else if (cmd.matches("A")) {                  // Wall-clock time limit
+	_mode[_WALL_LIMIT_] = (int) (cmd >> 1);
+    }
+    else if (cmd.matches("M")) {              // Memory limit of clause DB
+	_mode[_MEMORY_LIMIT_] = (int) (cmd >> 1);
+    }
+    else if (cmd.matches("E")) {        // Enumerate solutions, 0 if all
+	int limit = (int) (cmd >> 1);
+	_mode[_ENUM_LIMIT_] = (limit > 0) ? limit : INFINITY;
+    }
+    else if (cmd.matches("Y")) {     // Compute backbone, 0 if default chunk
+	int chunk = (int) (cmd >> 1);
+	_mode[_BACKBONE_CHUNK_] = (chunk > 0) ? chunk : 0;
+    }
     else if (cmd.matches("F")) {
 	Abort("Cannot read configuration file yet");
     }
@@ -225,6 +329,52 @@ int SAT_Cmds::handleMinusOption (CmdArg &cmd)
     if( cmd.matches("r") ) {
 	_mode[_CONF_CLAUSE_REPACKING_] = FALSE;
     }
+    else if (cmd.matches("e")) {
+	_mode[_ELIM_THREADS_] = NONE;
+    }
+    else if (cmd.matches("l")) {
+	_mode[_LOCAL_THREADS_] = NONE;
+    }
+    else if (cmd.matches("L")) {
+	_mode[_LOAD_THREADS_] = NONE;
+    }
+    else if (cmd.matches("o")) {
+	_mode[_AIG_OUTPUT_] = NONE;
+    }
+    else if (cmd.matches("P")) {
+	_mode[_PREFETCH_] = FALSE;
+    }
+    else if (cmd.matches("K")) {
+	_mode[_CACHE_SIZE_] = NONE;
+    }
+    else if (cmd.matches("R")) {
+	if (_import_name) { delete[] _import_name; }
+	_import_name = NULL;
+    }
+    else if (cmd.matches("W")) {
+	if (_export_name) { delete[] _export_name; }
+	_export_name = NULL;
+    }
+    else if (cmd.matches("X")) {
+	if (_checkpoint_name) { delete[] _checkpoint_name; }
+	_checkpoint_name = NULL;
+    }
+    else if (cmd.matches("U")) {
+	if (_server_name) { delete[] _server_name; }
+	_server_name = NULL;
+    }
+    else if (cmd.matches("A")) {
+	_mode[_WALL_LIMIT_] = NONE;
+    }
+    else if (cmd.matches("M")) {
+	_mode[_MEMORY_LIMIT_] = NONE;
+    }
+    else if (cmd.matches("E")) {
+	_mode[_ENUM_LIMIT_] = NONE;
+    }
+    else if (cmd.matches("Y")) {
+	_mode[_BACKBONE_CHUNK_] = NONE;
+    }
     else if( cmd.matches("t") ) {
 	_mode[_TRIM_SOLUTIONS_] = FALSE;
     }
@@ -248,9 +398,12 @@ int SAT_Cmds::handleMinusOption (CmdArg &cmd)
 // ----------------------------------------------------------------------------
 // Function: cmdParse
 //
-// Purpose: Parses commands in on-line mode.
+// Purpose: Parses commands in on-line mode, ie options given as in the
+//          command line, which are used for configuring GRASP.
 //
-// Notes: It may return a file name to be parsed.
+// Notes: It may return a file name to be parsed, ie the first argument
+//        that is not an option, which is kept until the next command.
+//        valid() tells whether all options given were supported.
 //
 // History: 6/21/95 - JPMS - created.
 // ----------------------------------------------------------------------------
@@ -259,13 +412,30 @@ char *SAT_Cmds::cmdParse( char *str )
 {
     CmdLine command( str );
 
-    //-------------------------------------------------------------------------
-    // Under construction.
-    //-------------------------------------------------------------------------
+    if (_command_name) {
+	delete[] _command_name;
+	_command_name = NULL;
+    }
+    _valid = TRUE;
+    for (int k = 0; k < command.size(); k++) {
+	char *arg = (char*) command[k];
 
-    return NULL;
+	if (arg[0] == '+' && arg[1]) {
+	    _valid &= handlePlusOption (command[k] >> 1);
+	}
+	else if (arg[0] == '-' && arg[1]) {
+	    _valid &= handleMinusOption (command[k] >> 1);
+	}
+	else if (!_command_name) {
+	    setFileName (_command_name, command[k]);
+	}
+	else {
+	    _valid = FALSE;                          // Only one file name
+	}
+    }
+    return _command_name;
 }
-
+
 // ----------------------------------------------------------------------------
 // Function: fileParse
 //
@@ -13,6 +13,7 @@
 #ifndef __GRP_CMDS
 #define __GRP_CMDS
 
+#include "list.hh"
 #include "cmdArg.hh"
 #include "cmdLine.hh"
 
@@ -43,6 +44,13 @@ class SAT_Cmds {
     virtual char *cmdParse (char *str);
     virtual int fileParse (char *name);
 
+    inline List<char*> &file_names() { return _file_names; }
+    inline char *import_name() { return _import_name; }   // Learnt clauses
+    inline char *export_name() { return _export_name; }
+    inline char *checkpoint_name() { return _checkpoint_name; }
+    inline char *server_name() { return _server_name; }  // Socket, or NULL
+    inline int valid() { return _valid; }      // Options of last command
+
   protected:
 
     //-------------------------------------------------------------------------
@@ -56,6 +64,7 @@ class SAT_Cmds {
     void setDecideMode (CmdArg &arg);
     void setMultConfs (CmdArg &arg);
     void setPreprocessMode (CmdArg &arg);
+    int setFileName (char *&name, CmdArg &arg);
 
   private:
 
@@ -64,6 +73,14 @@ class SAT_Cmds {
     //-------------------------------------------------------------------------
 
     SAT_Mode &_mode;
+
+    List<char*> _file_names;            // File names found in the command line
+    char *_import_name;                 // Files of learnt clauses, or NULL
+    char *_export_name;
+    char *_checkpoint_name;             // File of checkpoints, or NULL
+    char *_server_name;                 // Socket of on-line mode, or NULL
+    char *_command_name;                // File name of last command, or NULL
+    int _valid;                         // Whether options were supported
 };
 
 #endif
@@ -7,6 +7,11 @@
 //
 // History: 6/23/95 - JPMS - created.
 //          3/16/96 - JPMS - adapted for new version of GRASP.
+//          10/19/26 - agent - preferred values for dynamic decision making.
+//          10/19/26 - agent - inputs of circuits are decided before gates.
+//          10/19/26 - agent - assumptions decided before other variables.
+//          10/19/26 - agent - failed assumptions traced by the BRE.
+//          10/19/26 - agent - orderings reused, clear() drops assumptions.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -37,33 +42,48 @@ static int shifted_pivot[MAX_RELEVANT_SIZE+1];
 //
 // Purpose: Prepare engine for decision making.
 //
-// Notes: Array resizing is expected to be applied *solely* to arrays of size
-//        0. Otherwise, allocated var ordering entries will be lost! Moreover,
-//        orderings can be specified *ONLY* after resizing has taken place.
+// Notes: Orderings of variables already scheduled (ie with ID not larger
+//        than _max_sched) are kept. Hence, orderings specified before
+//        calling init() again are accounted for when reordering. After
+//        clear() all orderings are reinitialized.
 //-----------------------------------------------------------------------------
 
 void DecisionEngine::init (SAT_ClauseDatabase &clDB)
 {
     if (_mode[_DECISION_MODE_] == _STATIC_ORD_) {
 	_dec_ptr = 0;
-	if (clDB.variables().size() > _sdec_sched.size()) {
+	int orig_size = _sdec_order.size();
+	if (clDB.variables().size() > orig_size) {
 	    _sdec_sched.resize (clDB.variables().size());
 	    _sdec_order.resize (clDB.variables().size());
-
-	    SAT_VariableListPtr pvar =
-		(SAT_VariableListPtr) clDB.variables().first();
-	    for (; pvar; pvar = pvar->next()) {
-		SAT_VariablePtr var = pvar->data();
-		_sdec_order[var->ID()] = new VarOrdering (var);
-		_sdec_sched[var->ID()] = var;
-		DBG1(cout<<"SCHEDULING DEC VAR: "<<var->name()<<endl;);
+	    for (int k = orig_size; k < _sdec_order.size(); k++) {
+		_sdec_order[k] = NULL;
+	    }
+	}
+	SAT_VariableListPtr pvar =
+	    (SAT_VariableListPtr) clDB.variables().first();
+	for (; pvar; pvar = pvar->next()) {
+	    SAT_VariablePtr var = pvar->data();
+	    if (var->ID() > _max_sched) {              // Var w/ default ordering
+		if (_sdec_order[var->ID()]) {
+		    _sdec_order[var->ID()]->set_variable (var);
+		} else {
+		    _sdec_order[var->ID()] = new VarOrdering (var);
+		}
 	    }
-	    _max_sched = _sdec_sched.size()-1;
-	    DBG1(cout<<"TOTAL DECISION VARS: "<<_max_sched<<endl;);
 	}
-	else { reorder_variables (clDB); }      // Reorder only if not resizing
+	_max_sched = clDB.variables().size()-1;
+	DBG1(cout<<"TOTAL DECISION VARS: "<<_max_sched<<endl;);
+	reorder_variables (clDB);
     }
     else {
+	int orig_size = _dpref_value.size();
+	if (clDB.variables().size() > orig_size) {
+	    _dpref_value.resize (clDB.variables().size());
+	    for (int k = orig_size; k < _dpref_value.size(); k++) {
+		_dpref_value[k] = NONE;
+	    }
+	}
         unsigned int pivot = 1;
         for (int k = 0; k < MAX_RELEVANT_SIZE; k++) {
             shifted_pivot[k] = pivot << k;
@@ -87,11 +107,19 @@ void DecisionEngine::reset (SAT_ClauseDatabase &clauseDB)
 // Function: clear()
 //
 // Purpose: Clear internal structures for subsequent SAT instance.
+//
+// Notes: Var ordering entries are then redefined by init(), which reuses
+//        the entries allocated. Assumptions are removed.
 //-----------------------------------------------------------------------------
 
 void DecisionEngine::clear (SAT_ClauseDatabase &clauseDB)
 {
-
+    clear_assumptions();
+    _max_sched = NONE;
+    _dec_ptr = 0;
+    for (int k = 0; k < _dpref_value.size(); k++) {
+	_dpref_value[k] = NONE;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -99,6 +127,9 @@ void DecisionEngine::clear (SAT_ClauseDatabase &clauseDB)
 //
 // Purpose: Set decision pointer at the backtracking level. When decide() is
 //          called this pointer is then set to an unassigned variable.
+//
+// Notes: Assumptions take the first decision levels, hence these are not
+//        accounted for by the decision pointer.
 //-----------------------------------------------------------------------------
 
 void DecisionEngine::backtrack (SAT_ClauseDatabase &clDB, int back_level)
@@ -112,7 +143,60 @@ void DecisionEngine::backtrack (SAT_ClauseDatabase &clDB, int back_level)
 	  {if (_sdec_sched[k] && _sdec_sched[k]->value() == UNKNOWN)
 	       {cout<<"UNASSIGNED DECISION VARIABLE: "<<_sdec_sched[k]->name();
 		cout<<endl;Warn("PREVIOUS var with UNKNOWN value???");}});
-    if (_dec_ptr > back_level-1) { _dec_ptr = back_level-1; }
+    int free_level = back_level-1 - _assumption_number;
+    if (free_level < 0) { free_level = 0; }
+    if (_dec_ptr > free_level) { _dec_ptr = free_level; }
+    _assume_ptr = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_assumption()
+//
+// Purpose: Adds an assumption, decided after those already added.
+//-----------------------------------------------------------------------------
+
+void DecisionEngine::add_assumption (SAT_VariablePtr var, int value)
+{
+    if (_assumption_number >= _assumed_vars.size()) {
+	int size = (_assumed_vars.size()) ? 2*_assumed_vars.size() : 16;
+	_assumed_vars.resize (size);
+	_assumed_values.resize (size);
+    }
+    _assumed_vars[_assumption_number] = var;
+    _assumed_values[_assumption_number++] = value;
+    _assume_ptr = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: clear_assumptions()
+//
+// Purpose: Removes all assumptions, and forgets the one implied false.
+//-----------------------------------------------------------------------------
+
+void DecisionEngine::clear_assumptions()
+{
+    _assumption_number = 0;
+    _assume_ptr = 0;
+    _falsified = NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: assumptions_met()
+//
+// Purpose: Checks whether all assumptions hold.
+//-----------------------------------------------------------------------------
+
+int DecisionEngine::assumptions_met()
+{
+    for (int k = 0; k < _assumption_number; k++) {
+	if (_assumed_vars[k]->value() != _assumed_values[k]) {
+	    return FALSE;
+	}
+    }
+    return TRUE;
 }
 
 
@@ -132,7 +216,9 @@ void DecisionEngine::set_decision_order (SAT_VariablePtr var, int order)
 //-----------------------------------------------------------------------------
 // Function: set_preferred_value()
 //
-// Purpose: Chooses decision value for a variable.
+// Purpose: Chooses decision value for a variable. With dynamic decision
+//          making, the value chosen overrides the value selected by the
+//          heuristic, unless it is NONE.
 //-----------------------------------------------------------------------------
 
 void DecisionEngine::set_preferred_value (SAT_VariablePtr var, int value)
@@ -140,6 +226,9 @@ void DecisionEngine::set_preferred_value (SAT_VariablePtr var, int value)
     if (_mode[_DECISION_MODE_] == _STATIC_ORD_) {
 	_sdec_order[var->ID()]->pref_value() = value;
     }
+    else {
+	_dpref_value[var->ID()] = value;
+    }
 }
 
 
@@ -150,6 +239,9 @@ void DecisionEngine::set_preferred_value (SAT_VariablePtr var, int value)
 //
 // Notes: Number of variables with ANY order plus number of variables with
 //        chosen order *must* match the total number of variables.
+//        If the instance was created from a circuit, variables with ANY
+//        order that are outputs of gates are scheduled last, since these
+//        are usually implied once the inputs of the circuit are assigned.
 //-----------------------------------------------------------------------------
 
 void DecisionEngine::reorder_variables (SAT_ClauseDatabase &clDB)
@@ -157,11 +249,24 @@ void DecisionEngine::reorder_variables (SAT_ClauseDatabase &clDB)
     SAT_VariableListPtr pvar = (SAT_VariableListPtr) clDB.variables().last();
     int _bott_idx = clDB.variables().size()-1;
 
+    if (clDB.gate_number()) {                         // Gate outputs go last
+	for (; pvar; pvar = pvar->prev()) {
+	    SAT_VariablePtr var = pvar->data();
+	    if (_sdec_order[var->ID()]->order() == ANY && clDB.gate (var)) {
+		_sdec_sched[_bott_idx--] = var;
+	    }
+	}
+	pvar = (SAT_VariableListPtr) clDB.variables().last();
+    }
     for (; pvar; pvar = pvar->prev()) {
 	SAT_VariablePtr var = pvar->data();
 	int var_order = _sdec_order[var->ID()]->order();
-	if (var_order == ANY) { _sdec_sched[_bott_idx--] = var; }
-	else                  { _sdec_sched[var_order] = var; }
+	if (var_order == ANY) {
+	    if (!clDB.gate_number() || !clDB.gate (var)) {
+		_sdec_sched[_bott_idx--] = var;
+	    }
+	}
+	else { _sdec_sched[var_order] = var; }
 	DBG1(cout<<"SCHEDULING DEC VAR: "<<var->name()<<endl;);
     }
 }
@@ -196,13 +301,11 @@ void DecisionEngine::output_stats (SAT_ClauseDatabase &clauseDB)
 int DecisionEngine::static_assignment_select (SAT_ClauseDatabase &clDB)
 {
     DBG1(cout<<"Making static decision assignment"<<endl;);
-    while (_dec_ptr < _sdec_sched.size() &&
+    while (_dec_ptr <= _max_sched &&
 	   _sdec_sched[_dec_ptr]->value() != UNKNOWN) {
 	_dec_ptr++;
     }
-    if (_dec_ptr < _sdec_sched.size()) {
-	CHECK(if(_dec_ptr > _max_sched)
-	      Warn("Deciding above max number of decision vars?"););
+    if (_dec_ptr <= _max_sched) {
 	SAT_VariablePtr var = _sdec_sched[_dec_ptr];
 	elect_assignment (clDB, var, _sdec_order[var->ID()]->pref_value());
 	return DECISION;
@@ -212,6 +315,37 @@ int DecisionEngine::static_assignment_select (SAT_ClauseDatabase &clDB)
 }
 
 
+//-----------------------------------------------------------------------------
+// Function: assumption_select()
+//
+// Purpose: Decides the first assumption that does not hold yet. Returns
+//          FAILED if it is implied false, or NONE once all assumptions
+//          hold.
+//
+// Side-effects: If available, an assignment is made. Otherwise, the
+//               assumption implied false is recorded.
+//-----------------------------------------------------------------------------
+
+int DecisionEngine::assumption_select (SAT_ClauseDatabase &clDB)
+{
+    DBG1(cout<<"Making assumption assignment"<<endl;);
+    for (; _assume_ptr < _assumption_number; _assume_ptr++) {
+	SAT_VariablePtr var = _assumed_vars[_assume_ptr];
+	int value = _assumed_values[_assume_ptr];
+	if (var->value() == UNKNOWN) {
+	    elect_assignment (clDB, var, value);
+	    _assume_ptr++;
+	    return DECISION;
+	}
+	else if (var->value() != value) {
+	    _falsified = _assume_ptr;
+	    return FAILED;
+	}
+    }
+    return NONE;
+}
+
+
 //-----------------------------------------------------------------------------
 // Function: dynamic_assignment_select()
 //
@@ -224,7 +358,7 @@ int DecisionEngine::static_assignment_select (SAT_ClauseDatabase &clDB)
 int DecisionEngine::dynamic_assignment_select (SAT_ClauseDatabase &clDB)
 {
     DBG1(cout<<"Making dyamic decision assignment"<<endl;);
-    int outcome;
+    int outcome = NONE;
     switch( _mode[_DECISION_LEVEL_] ) {
       case _MSOS_:
         outcome = select_MSOS (clDB);
@@ -311,7 +445,8 @@ int DecisionEngine::select_MSOS (SAT_ClauseDatabase &clDB)
 	}
     }
     if (!target_var) { return SOLUTION; }
-    elect_assignment (clDB, target_var, target_value );
+    elect_assignment (clDB, target_var,
+		      preferred_value (target_var, target_value));
     return DECISION;
 }
 
@@ -351,7 +486,8 @@ int DecisionEngine::select_MSTS (SAT_ClauseDatabase &clDB)
 	}
     }
     if (!target_var) { return SOLUTION; }
-    elect_assignment (clDB, target_var, target_value );
+    elect_assignment (clDB, target_var,
+		      preferred_value (target_var, target_value));
     return DECISION;
 }
 
@@ -430,7 +566,8 @@ int DecisionEngine::select_MSMM (SAT_ClauseDatabase &clDB)
 	}
     }
     if (!target_var) { return SOLUTION; }
-    elect_assignment (clDB, target_var, target_value );
+    elect_assignment (clDB, target_var,
+		      preferred_value (target_var, target_value));
     return DECISION;
 }
 
@@ -510,7 +647,8 @@ int DecisionEngine::select_BOHM (SAT_ClauseDatabase &clDB)
 	}
     }
     if (!target_var) { return SOLUTION; }
-    elect_assignment (clDB, target_var, target_value );
+    elect_assignment (clDB, target_var,
+		      preferred_value (target_var, target_value));
     return DECISION;
 }
 
@@ -551,7 +689,8 @@ int DecisionEngine::select_DLIS (SAT_ClauseDatabase &clDB)
 	}
     }
     if (!target_var) { return SOLUTION; }
-    elect_assignment (clDB, target_var, target_value );
+    elect_assignment (clDB, target_var,
+		      preferred_value (target_var, target_value));
     return DECISION;
 }
 
@@ -587,7 +726,8 @@ int DecisionEngine::select_DLCS (SAT_ClauseDatabase &clDB)
 	}
     }
     if (!target_var) { return SOLUTION; }
-    elect_assignment (clDB, target_var, target_value );
+    elect_assignment (clDB, target_var,
+		      preferred_value (target_var, target_value));
     return DECISION;
 }
 
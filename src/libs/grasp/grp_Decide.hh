@@ -8,6 +8,10 @@
 //
 // History: 6/23/95 - JPMS - created.
 //          3/10/96 - JPMS - adapted for new version of GRASP.
+//          10/19/26 - agent - preferred values for dynamic decision making.
+//          10/19/26 - agent - assumptions decided before other variables.
+//          10/19/26 - agent - failed assumptions traced by the BRE.
+//          10/19/26 - agent - orderings of variables reused across instances.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -47,10 +51,16 @@ class DecisionEngine {
     // Constructor/destructor.
     //-------------------------------------------------------------------------
 
-    DecisionEngine (SAT_Mode &nmode) : _mode(nmode), _sdec_sched(0) {
+    DecisionEngine (SAT_Mode &nmode) : _mode(nmode), _sdec_sched(0),
+    _dpref_value(0), _assumed_vars(0), _assumed_values(0) {
 	_max_sched = NONE; _dec_ptr = 0;
+	_assumption_number = 0; _assume_ptr = 0; _falsified = NONE;
+    }
+    virtual ~DecisionEngine() {
+	_sdec_sched.resize(0);
+	_assumed_vars.resize(0);
+	_assumed_values.resize(0);
     }
-    virtual ~DecisionEngine() { _sdec_sched.resize(0); }
 
     //-------------------------------------------------------------------------
     // Interface contract.
@@ -63,13 +73,38 @@ class DecisionEngine {
     virtual void backtrack (SAT_ClauseDatabase &clDB, int back_level);
 
     inline int decide (SAT_ClauseDatabase &clDB) {
+	int outcome = (_assumption_number) ? assumption_select (clDB) : NONE;
+	if (outcome != NONE) {
+	    return outcome;
+	}
 	return ((_mode[_DECISION_MODE_] == _STATIC_ORD_) ?
 		static_assignment_select (clDB) :
 		dynamic_assignment_select (clDB));
     }
 
     //-------------------------------------------------------------------------
-    // Decision making preparation -> for static decision making.
+    // Assumptions, ie assignments decided before any other decision, in the
+    // order given. decide() returns FAILED once an assumption is implied
+    // false by the formula and the assumptions before it. This assumption
+    // is then given by falsified_var() and falsified_value(), and is traced
+    // by the backward reasoning engine (see BRE::analyze_final()).
+    //-------------------------------------------------------------------------
+
+    virtual void add_assumption (SAT_VariablePtr var, int value);
+    virtual void clear_assumptions();
+    inline int assumption_number() { return _assumption_number; }
+    virtual int assumptions_met();
+
+    inline SAT_VariablePtr falsified_var() {
+	return (_falsified != NONE) ? _assumed_vars[_falsified] : NULL;
+    }
+    inline int falsified_value() {
+	return (_falsified != NONE) ? _assumed_values[_falsified] : NONE;
+    }
+
+    //-------------------------------------------------------------------------
+    // Decision making preparation -> for static decision making. Preferred
+    // values are also used by dynamic decision making, if defined.
     //-------------------------------------------------------------------------
 
     virtual void set_decision_order (SAT_VariablePtr var, int order = ANY);
@@ -91,6 +126,7 @@ class DecisionEngine {
 
     virtual int static_assignment_select (SAT_ClauseDatabase &clDB);
     virtual int dynamic_assignment_select (SAT_ClauseDatabase &clDB);
+    virtual int assumption_select (SAT_ClauseDatabase &clDB);
 
     inline void elect_assignment (SAT_ClauseDatabase &clDB,
 				  SAT_VariablePtr var, int value) {
@@ -111,6 +147,11 @@ class DecisionEngine {
     // Functions for dynamic variable ordering.
     //-------------------------------------------------------------------------
 
+    inline int preferred_value (SAT_VariablePtr var, int value) {
+	return ((_dpref_value[var->ID()] != NONE) ?
+		_dpref_value[var->ID()] : value);
+    }
+
     int select_MSOS (SAT_ClauseDatabase &clDB);
     int select_MSTS (SAT_ClauseDatabase &clDB);
     int select_MSMM (SAT_ClauseDatabase &clDB);
@@ -129,6 +170,14 @@ class DecisionEngine {
     int _max_sched;
     int _dec_ptr;
 
+    Array<int> _dpref_value;     // Preferred values for dynamic decision making
+
+    Array<SAT_VariablePtr> _assumed_vars;              // Assumptions, in order
+    Array<int> _assumed_values;
+    int _assumption_number;
+    int _assume_ptr;                     // Assumptions before it are satisfied
+    int _falsified;                  // Assumption implied false, or NONE
+
   private:
 
 };
@@ -147,10 +196,12 @@ class VarOrdering {
     // Constructor/destructor.
     //-------------------------------------------------------------------------
 
-    VarOrdering (SAT_VariablePtr Nvar) {
+    VarOrdering (SAT_VariablePtr Nvar) { set_variable (Nvar); }
+    ~VarOrdering() {}
+
+    inline void set_variable (SAT_VariablePtr Nvar) {     // Default ordering
 	_var = Nvar; _pref_value = TRUE; _order = Nvar->ID();
     }
-    ~VarOrdering() {}
 
     //-------------------------------------------------------------------------
     // Interface contract.
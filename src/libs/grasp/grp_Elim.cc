@@ -0,0 +1,540 @@
+//-----------------------------------------------------------------------------
+// File: grp_Elim.cc
+//
+// Purpose: Member functions of the variable elimination engine.
+//
+// Remarks: Workers only read the clause database and write into their own
+//          tasks, and so they do not allocate objects from memory pools.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - restore() of eliminated clauses.
+//          10/19/26 - agent - eliminated clauses forgotten by clear().
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "grp_Elim.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static inline void push_int (Array<int> &arr, int &number, int value)
+{
+    if (number >= arr.size()) {
+	arr.resize (2*number + 16);
+    }
+    arr[number++] = value;
+}
+
+static inline int encode_literal (LiteralPtr lit)
+{
+    int vID = lit->variable()->ID() + 1;
+    return (lit->sign()) ? -vID : vID;
+}
+
+static int compare_keys (const void *key1, const void *key2)
+{
+    long k1 = *((long*) key1), k2 = *((long*) key2);
+    return (k1 < k2) ? -1 : (k1 > k2) ? 1 : 0;
+}
+
+static void *elim_thread (void *arg)
+{
+    ElimWorkerPtr worker = (ElimWorkerPtr) arg;
+    worker->engine()->resolve_tasks (worker);
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+EliminationEngine::EliminationEngine (SAT_Mode &nmode, FRE &nFRE) :
+_mode(nmode), _FRE(nFRE), _variables(0), _status(0), _touched(0),
+_tasks(0), _workers(0), _elim_vars(0), _elim_start(0), _elim_lits(0)
+{
+    int threads = (_mode[_ELIM_THREADS_] > 1) ? _mode[_ELIM_THREADS_] : 1;
+    _workers.resize (threads);
+    for (int k = 0; k < threads; k++) {
+	_workers[k] = new ElimWorker();
+	_workers[k]->engine() = this;
+	_workers[k]->first() = k;
+    }
+    _var_number = 0;
+    _task_number = 0;
+    _elim_lit_number = 0;
+    _elim_number = 0;
+    _elim_lit_number = 0;
+    _round_number = 0;
+    _del_cl_number = 0;
+    _add_cl_number = 0;
+}
+
+EliminationEngine::~EliminationEngine()
+{
+    for (int k = 0; k < _workers.size(); k++) {
+	delete _workers[k];
+    }
+    for (int k = 0; k < _tasks.size(); k++) {
+	if (_tasks[k]) { delete _tasks[k]; }
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: init()
+//
+// Purpose: Prepares the engine for a new instance of SAT.
+//
+// Side-effects: Eliminated clauses of the previous instance are discarded.
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::init (SAT_ClauseDatabase &clDB)
+{
+    _var_number = 0;
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	if (pvar->data()->ID() >= _var_number) {
+	    _var_number = pvar->data()->ID() + 1;
+	}
+    }
+    if (_var_number > _variables.size()) {       // Arrays are reused otherwise
+	_variables.resize (_var_number);
+	_status.resize (_var_number);
+	_touched.resize (_var_number);
+    }
+    for (int k = 0; k < _var_number; k++) {
+	_variables[k] = NULL;
+	_status[k] = ELIM_CANDIDATE;
+	_touched[k] = 0;
+    }
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	_variables[pvar->data()->ID()] = (SAT_VariablePtr) pvar->data();
+    }
+    for (int k = 0; k < _workers.size(); k++) {
+	Array<int> &marks = _workers[k]->marks();
+	if (_var_number > marks.size()) {
+	    marks.resize (_var_number);
+	}
+	for (int j = 0; j < marks.size(); j++) {
+	    marks[j] = 0;
+	}
+	_workers[k]->stamp() = 0;
+    }
+    _task_number = 0;
+    _elim_number = 0;
+    _elim_lit_number = 0;
+    _round_number = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: clear()
+//
+// Purpose: Clears stats of the engine, and forgets the clauses eliminated.
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::clear (SAT_ClauseDatabase &clDB)
+{
+    _elim_number = 0;
+    _round_number = 0;
+    _del_cl_number = 0;
+    _add_cl_number = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: eliminate()
+//
+// Purpose: Eliminates variables in rounds, until no variable can be
+//          eliminated. Returns CONFLICT if an empty resolvent is found.
+//
+// Side-effects: Clauses of eliminated variables are replaced by their
+//               resolvents in the clause database.
+//
+// Notes: Must be invoked before any variable is assigned.
+//-----------------------------------------------------------------------------
+
+int EliminationEngine::eliminate (SAT_ClauseDatabase &clDB)
+{
+    int threads = _workers.size();
+    while (_round_number < ELIM_ROUND_LIMIT && select_tasks (clDB)) {
+	_round_number++;
+	DBG1(cout<<"ELIMINATION ROUND "<<_round_number<<" WITH ";
+	     cout<<_task_number<<" VARIABLES"<<endl;);
+
+	int created = 0;
+	if (threads > 1 && _task_number > 1) {
+	    for (created = 1; created < threads; created++) {
+		ElimWorkerPtr worker = _workers[created];
+		if (pthread_create (&worker->thread(), NULL,
+				    elim_thread, (void*) worker)) {
+		    break;
+		}
+	    }
+	    created--;                             // Number of threads created
+	}
+	resolve_tasks (_workers[0]);
+	for (int k = 1; k <= created; k++) {
+	    pthread_join (_workers[k]->thread(), NULL);
+	}
+	for (int k = created+1; k < threads; k++) {        // Not run by threads
+	    resolve_tasks (_workers[k]);
+	}
+	if (merge_tasks (clDB) == CONFLICT) {
+	    return CONFLICT;
+	}
+    }
+    return NO_CONFLICT;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: select_tasks()
+//
+// Purpose: Selects the variables to eliminate in the next round, by
+//          increasing number of resolution steps. A variable is not
+//          selected if it occurs in a clause of a variable already
+//          selected. Returns the number of variables selected.
+//-----------------------------------------------------------------------------
+
+int EliminationEngine::select_tasks (SAT_ClauseDatabase &clDB)
+{
+    if (!_var_number) {
+	return 0;
+    }
+    Array<long> keys (_var_number);
+    int key_number = 0;
+
+    for (int k = 0; k < _var_number; k++) {
+	SAT_VariablePtr var = _variables[k];
+	if (!var || _status[k] != ELIM_CANDIDATE || var->value() != UNKNOWN) {
+	    continue;
+	}
+	int pos_lits = var->positive_literals();
+	int neg_lits = var->negative_literals();
+	if (pos_lits + neg_lits == 0 ||
+	    (pos_lits && neg_lits &&
+	     (pos_lits > ELIM_OCC_LIMIT || neg_lits > ELIM_OCC_LIMIT))) {
+	    continue;
+	}
+	keys[key_number++] = (long) cost (var) * _var_number + k;
+    }
+    qsort ((long*) &keys[0], key_number, sizeof(long), compare_keys);
+
+    int round = _round_number + 1;
+    _task_number = 0;
+    for (int k = 0; k < key_number; k++) {
+	int vID = (int) (keys[k] % _var_number);
+	if (_touched[vID] == round) {
+	    continue;
+	}
+	SAT_VariablePtr var = _variables[vID];
+	_touched[vID] = round;
+	for_each(plit, var->literals(), LiteralPtr) {
+	    for_each(pl, plit->data()->clause()->literals(), LiteralPtr) {
+		_touched[pl->data()->variable()->ID()] = round;
+	    }
+	}
+	if (_task_number >= _tasks.size()) {
+	    int orig_size = _tasks.size();
+	    _tasks.resize (2*orig_size + 16);
+	    for (int j = orig_size; j < _tasks.size(); j++) {
+		_tasks[j] = NULL;
+	    }
+	}
+	if (!_tasks[_task_number]) {
+	    _tasks[_task_number] = new ElimTask();
+	}
+	_tasks[_task_number++]->var() = var;
+    }
+    return _task_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: resolve_tasks()
+//
+// Purpose: Computes the resolvents of the tasks handled by a worker.
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::resolve_tasks (ElimWorkerPtr worker)
+{
+    int step = _workers.size();
+    for (int k = worker->first(); k < _task_number; k += step) {
+	resolve_variable (worker, _tasks[k]);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: resolve_variable()
+//
+// Purpose: Computes the non-tautological resolvents on a variable. The
+//          outcome of the task is TRUE if the variable is to be
+//          eliminated, and CONFLICT if an empty resolvent is found.
+//
+// Notes: Variables occurring more than once in a clause are not
+//        eliminated.
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::resolve_variable (ElimWorkerPtr worker,
+					  ElimTaskPtr task)
+{
+    SAT_VariablePtr var = task->var();
+    Array<int> &marks = worker->marks();
+    int occ_number = var->literals().size();
+
+    task->lit_number() = 0;
+    task->res_number() = 0;
+    task->outcome() = FALSE;
+
+    for_each(plit, var->literals(), LiteralPtr) {
+	int count = 0;
+	for_each(pl, plit->data()->clause()->literals(), LiteralPtr) {
+	    if (pl->data()->variable() == var) { count++; }
+	}
+	if (count != 1) {
+	    return;
+	}
+    }
+    for_each(ppos, var->literals(), LiteralPtr) {
+	if (ppos->data()->sign()) { continue; }
+
+	for_each(pneg, var->literals(), LiteralPtr) {
+	    if (!pneg->data()->sign()) { continue; }
+
+	    int stamp = ++worker->stamp();
+	    int start = task->lit_number();
+	    int tautology = FALSE;
+	    ClausePtr cls[2];
+	    cls[0] = ppos->data()->clause();
+	    cls[1] = pneg->data()->clause();
+
+	    for (int j = 0; j < 2 && !tautology; j++) {
+		for_each(pl, cls[j]->literals(), LiteralPtr) {
+		    LiteralPtr lit = pl->data();
+		    if (lit->variable() == var) { continue; }
+
+		    int vID = lit->variable()->ID();
+		    int mark = (lit->sign()) ? -stamp : stamp;
+		    if (marks[vID] == mark) { continue; }        // Duplicate
+		    if (marks[vID] == -mark) { tautology = TRUE; break; }
+		    marks[vID] = mark;
+		    push_int (task->resolvents(), task->lit_number(),
+			      encode_literal (lit));
+		}
+	    }
+	    if (tautology) {
+		task->lit_number() = start;
+		continue;
+	    }
+	    if (task->lit_number() == start) {
+		task->outcome() = CONFLICT;                 // Empty resolvent
+		return;
+	    }
+	    if (task->lit_number() - start > ELIM_CLAUSE_LIMIT ||
+		++task->res_number() > occ_number) {
+		return;
+	    }
+	    push_int (task->resolvents(), task->lit_number(), 0);
+	}
+    }
+    task->outcome() = TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: merge_tasks()
+//
+// Purpose: Replaces the clauses of each variable to eliminate by its
+//          resolvents. Returns CONFLICT if an empty resolvent was found.
+//
+// Side-effects: Eliminated clauses are kept for extending solutions.
+//               Variables in these clauses that failed to be eliminated
+//               become candidates again.
+//-----------------------------------------------------------------------------
+
+int EliminationEngine::merge_tasks (SAT_ClauseDatabase &clDB)
+{
+    for (int k = 0; k < _task_number; k++) {
+	ElimTaskPtr task = _tasks[k];
+	SAT_VariablePtr var = task->var();
+
+	if (task->outcome() == CONFLICT) {
+	    return CONFLICT;
+	}
+	else if (task->outcome() != TRUE) {
+	    _status[var->ID()] = ELIM_FAILED;
+	    continue;
+	}
+	DBG1(cout<<"ELIMINATING "<<var->name()<<" WITH ";
+	     cout<<task->res_number()<<" RESOLVENTS"<<endl;);
+
+	if (_elim_number >= _elim_vars.size()) {
+	    _elim_vars.resize (2*_elim_number + 16);
+	    _elim_start.resize (2*_elim_number + 16);
+	}
+	_elim_vars[_elim_number] = var->ID();
+	_elim_start[_elim_number++] = _elim_lit_number;
+
+	LiteralListPtr plit;
+	while ((plit = var->literals().first())) {
+	    SAT_ClausePtr cl = (SAT_ClausePtr) plit->data()->clause();
+	    for_each(pl, cl->literals(), LiteralPtr) {
+		int vID = pl->data()->variable()->ID();
+		if (_status[vID] == ELIM_FAILED) {
+		    _status[vID] = ELIM_CANDIDATE;
+		}
+		push_int (_elim_lits, _elim_lit_number,
+			  encode_literal (pl->data()));
+	    }
+	    push_int (_elim_lits, _elim_lit_number, 0);
+	    clDB.del_clause (cl);
+	    _del_cl_number++;
+	}
+	SAT_ClausePtr cl = NULL;
+	for (int j = 0; j < task->lit_number(); j++) {
+	    int lit = task->resolvents()[j];
+	    if (!lit) {
+		cl = NULL;
+		continue;
+	    }
+	    if (!cl) {
+		cl = clDB.add_clause();
+		_add_cl_number++;
+	    }
+	    SAT_VariablePtr rvar = _variables[((lit > 0) ? lit : -lit) - 1];
+	    clDB.add_literal (cl, rvar, (lit < 0));
+	}
+	_status[var->ID()] = ELIM_DONE;
+    }
+    return NO_CONFLICT;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: extend_solution()
+//
+// Purpose: Extends a solution of the clause database to the eliminated
+//          variables, in reverse order of elimination, such that the
+//          eliminated clauses become satisfied.
+//
+// Side-effects: Unassigned variables of eliminated clauses are assigned
+//               at decision level 0.
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::extend_solution (SAT_ClauseDatabase &clDB)
+{
+    for (int k = _elim_number-1; k >= 0; k--) {
+	SAT_VariablePtr var = _variables[_elim_vars[k]];
+	int start = _elim_start[k];
+	int end = (k+1 < _elim_number) ? _elim_start[k+1] : _elim_lit_number;
+
+	for (int j = start; j < end; j++) {           // Free variables in clauses
+	    int lit = _elim_lits[j];
+	    if (!lit) { continue; }
+
+	    SAT_VariablePtr lvar = _variables[((lit > 0) ? lit : -lit) - 1];
+	    if (lvar != var && lvar->value() == UNKNOWN) {
+		assign_variable (clDB, lvar, FALSE);
+	    }
+	}
+	int value = FALSE;
+	int pos = start;
+	while (pos < end) {                  // Satisfy each clause with var if req
+	    int sat_cl = FALSE;
+	    int var_lit = 0;
+	    for (; _elim_lits[pos]; pos++) {
+		int lit = _elim_lits[pos];
+		SAT_VariablePtr lvar = _variables[((lit > 0) ? lit : -lit) - 1];
+		int lval = (lvar == var) ? value : lvar->value();
+		if (lvar == var) { var_lit = lit; }
+		if (lval == ((lit > 0) ? TRUE : FALSE)) { sat_cl = TRUE; }
+	    }
+	    pos++;
+	    if (!sat_cl) {
+		value = (var_lit > 0) ? TRUE : FALSE;
+	    }
+	}
+	if (var->value() == UNKNOWN) {
+	    assign_variable (clDB, var, value);
+	} else {
+	    var->value() = value;              // Var occurs in no clause of DB
+	}
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: restore()
+//
+// Purpose: Sets the eliminated variables and their clauses, as kept from a
+//          previous elimination of the same instance, such that solutions
+//          can be extended without eliminating variables again.
+//
+// Side-effects: Restored variables are no longer candidates.
+//
+// Notes: Must be invoked after init(), and in place of eliminate().
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::restore (int number, int *vars, int *starts,
+				 int lit_number, int *lits)
+{
+    if (number > _elim_vars.size()) {          // Arrays are reused otherwise
+	_elim_vars.resize (number);
+	_elim_start.resize (number);
+    }
+    if (lit_number > _elim_lits.size()) {
+	_elim_lits.resize (lit_number);
+    }
+    for (int k = 0; k < number; k++) {
+	_elim_vars[k] = vars[k];
+	_elim_start[k] = starts[k];
+	_status[vars[k]] = ELIM_DONE;
+    }
+    for (int j = 0; j < lit_number; j++) {
+	_elim_lits[j] = lits[j];
+    }
+    _elim_number = number;
+    _elim_lit_number = lit_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: assign_variable()
+//
+// Purpose: Assigns an unassigned variable at decision level 0, after a
+//          solution has been found.
+//
+// Side-effects: States of clauses are updated (all remain satisfied).
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::assign_variable (SAT_ClauseDatabase &clDB,
+					 SAT_VariablePtr var, int value)
+{
+    clDB.set_implied_variable (var, value, 0, NULL);
+    _FRE.BCP (clDB);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: output_stats()
+//
+// Purpose: Output information regarding variable elimination.
+//-----------------------------------------------------------------------------
+
+void EliminationEngine::output_stats (SAT_ClauseDatabase &clDB)
+{
+    printItem ("Number of eliminated variables", _elim_number);
+    printItem ("Number of elimination rounds", _round_number);
+    printItem ("Number of eliminated clauses", _del_cl_number);
+    printItem ("Number of resolvents added", _add_cl_number);
+    printItem();
+}
+
+/*****************************************************************************/
@@ -0,0 +1,212 @@
+//-----------------------------------------------------------------------------
+// File: grp_Elim.hh
+//
+// Purpose: Declaration of class EliminationEngine, which applies bounded
+//          variable elimination (by clause distribution) prior to searching
+//          for a solution. Eliminated clauses are kept for extending the
+//          solution found to the eliminated variables.
+//
+// Remarks: Elimination proceeds in rounds. In each round a set of variables
+//          is selected such that no two variables occur in the same clause,
+//          and the resolvents of each variable are computed concurrently
+//          (by threads) from the clause database, which is *not* modified.
+//          The resolvents are then merged into the database by the main
+//          thread. Hence the outcome does not depend on the number of
+//          threads used.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - eliminated clauses can be kept across runs.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_ELIM__
+#define __GRP_ELIM__
+
+#include <pthread.h>
+
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_CDB.hh"
+#include "grp_FRE.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for variable elimination.
+//-----------------------------------------------------------------------------
+
+# define ELIM_OCC_LIMIT      10     // Max occurrences of each literal
+# define ELIM_CLAUSE_LIMIT   20     // Max size of resolvents
+# define ELIM_ROUND_LIMIT    1000   // Max number of rounds
+
+enum ElimStatus { ELIM_CANDIDATE = 0x50, ELIM_FAILED, ELIM_DONE };
+
+
+//-----------------------------------------------------------------------------
+// Class names and typedefs used by the elimination engine.
+//-----------------------------------------------------------------------------
+
+class ElimTask;
+class ElimWorker;
+class EliminationEngine;
+
+typedef ElimTask *ElimTaskPtr;
+typedef ElimWorker *ElimWorkerPtr;
+
+
+//-----------------------------------------------------------------------------
+// Class: ElimTask
+//
+// Purpose: Elimination of one variable, computed by a worker. Literals are
+//          represented as in the CNF format, ie ID+1 or -(ID+1), and each
+//          resolvent is terminated by 0.
+//-----------------------------------------------------------------------------
+
+class ElimTask {
+  public:
+    ElimTask() : _resolvents(0) { _var = NULL; _lit_number = 0;
+				  _res_number = 0; _outcome = FALSE; }
+    virtual ~ElimTask() {}
+
+    inline SAT_VariablePtr &var() { return _var; }
+    inline Array<int> &resolvents() { return _resolvents; }
+    inline int &lit_number() { return _lit_number; }
+    inline int &res_number() { return _res_number; }
+    inline int &outcome() { return _outcome; }      // TRUE, FALSE or CONFLICT
+
+  protected:
+    SAT_VariablePtr _var;                         // Variable to eliminate
+    Array<int> _resolvents;                       // Resolvents found
+    int _lit_number;                              // Entries of _resolvents
+    int _res_number;                              // Number of resolvents
+    int _outcome;                                 // Whether to eliminate
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: ElimWorker
+//
+// Purpose: Thread of the elimination engine. Worker k handles the tasks
+//          k, k+n, k+2n, ..., where n is the number of workers.
+//-----------------------------------------------------------------------------
+
+class ElimWorker {
+  public:
+    ElimWorker() : _marks(0) { _engine = NULL; _first = 0; _stamp = 0; }
+    virtual ~ElimWorker() {}
+
+    inline EliminationEngine *&engine() { return _engine; }
+    inline int &first() { return _first; }
+    inline Array<int> &marks() { return _marks; }
+    inline int &stamp() { return _stamp; }
+    inline pthread_t &thread() { return _thread; }
+
+  protected:
+    EliminationEngine *_engine;
+    int _first;                                   // First task handled
+    Array<int> _marks;                            // Literals in resolvent
+    int _stamp;                                   // Stamp of resolvent
+    pthread_t _thread;
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: EliminationEngine
+//
+// Purpose: Bounded variable elimination. A variable is eliminated if the
+//          number of (non-tautological) resolvents does not exceed the
+//          number of clauses in which the variable occurs.
+//-----------------------------------------------------------------------------
+
+class EliminationEngine {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    EliminationEngine (SAT_Mode &nmode, FRE &nFRE);
+    virtual ~EliminationEngine();
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    virtual void init (SAT_ClauseDatabase &clDB);
+    virtual void clear (SAT_ClauseDatabase &clDB);
+    virtual void reset (SAT_ClauseDatabase &clDB) {}
+
+    virtual int eliminate (SAT_ClauseDatabase &clDB);   // CONFLICT if unsat
+    virtual void extend_solution (SAT_ClauseDatabase &clDB);
+
+    virtual void output_stats (SAT_ClauseDatabase &clDB);
+
+    //-------------------------------------------------------------------------
+    // Eliminated clauses, ie the data needed for extending solutions, which
+    // are restored in place of eliminating variables (see grp_Cache.hh).
+    //-------------------------------------------------------------------------
+
+    inline int elim_number() { return _elim_number; }
+    inline Array<int> &elim_vars() { return _elim_vars; }
+    inline Array<int> &elim_start() { return _elim_start; }
+    inline Array<int> &elim_lits() { return _elim_lits; }
+    inline int elim_lit_number() { return _elim_lit_number; }
+
+    virtual void restore (int number, int *vars, int *starts,
+			  int lit_number, int *lits);
+
+    //-------------------------------------------------------------------------
+    // Function executed by each worker.
+    //-------------------------------------------------------------------------
+
+    virtual void resolve_tasks (ElimWorkerPtr worker);
+
+  protected:
+
+    //-------------------------------------------------------------------------
+    // Internal member functions for each round of elimination.
+    //-------------------------------------------------------------------------
+
+    virtual int select_tasks (SAT_ClauseDatabase &clDB);
+    virtual void resolve_variable (ElimWorkerPtr worker, ElimTaskPtr task);
+    virtual int merge_tasks (SAT_ClauseDatabase &clDB);
+
+    virtual void assign_variable (SAT_ClauseDatabase &clDB,
+				  SAT_VariablePtr var, int value);
+
+    inline int cost (SAT_VariablePtr var) {
+	return var->positive_literals() * var->negative_literals();
+    }
+
+    //-------------------------------------------------------------------------
+    // Internal variable definition.
+    //-------------------------------------------------------------------------
+
+    SAT_Mode &_mode;                                   // Configuration options
+    FRE &_FRE;                 // Implementor of Boolean Constraint Propagation
+
+    Array<SAT_VariablePtr> _variables;                    // ID to variables
+    Array<int> _status;                        // Elimination status of each var
+    Array<int> _touched;                  // Round in which var was last touched
+    int _var_number;
+
+    Array<ElimTaskPtr> _tasks;                  // Tasks of the current round
+    int _task_number;
+    Array<ElimWorkerPtr> _workers;
+
+    Array<int> _elim_vars;                   // IDs of the eliminated variables
+    Array<int> _elim_start;            // Start of the clauses of each variable
+    Array<int> _elim_lits;            // Eliminated clauses, terminated by 0
+    int _elim_lit_number;
+
+  protected:                                   // Variables for stats gathering
+    int _elim_number;
+    int _round_number;
+    int _del_cl_number;
+    int _add_cl_number;
+
+  private:
+
+};
+
+#endif // __GRP_ELIM__
+
+/*****************************************************************************/
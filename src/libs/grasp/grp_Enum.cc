@@ -0,0 +1,320 @@
+//-----------------------------------------------------------------------------
+// File: grp_Enum.cc
+//
+// Purpose: Member functions of the enumeration of projected solutions.
+//
+// Remarks: --
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - models trimmed with watches kept across models.
+//          10/19/26 - agent - limits set on each call of the solver.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iostream.h>
+
+#include "grp_Enum.hh"
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_Enumerator::SAT_Enumerator (SAT_Mode &nmode) : _mode(nmode), _solver(),
+    _lits(0), _projected(0), _cube(0), _values(0), _status(0), _heads(0),
+    _first(0), _pos(0), _next(0)
+{
+    _solver.set_options (nmode);
+    _var_number = 0;
+    _lit_number = 0;
+    _proj_number = 0;
+    _clause_number = 0;
+    _watched_number = 0;
+    _solution_number = 0;
+    _model_number = 0.0;
+    _report = NULL;
+    _report_state = NULL;
+}
+
+SAT_Enumerator::~SAT_Enumerator()
+{
+    _lits.resize (0);
+    _projected.resize (0);
+    _cube.resize (0);
+    _values.resize (0);
+    _status.resize (0);
+    _heads.resize (0);
+    _first.resize (0);
+    _pos.resize (0);
+    _next.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add()
+//
+// Purpose: Adds a literal to the clause being given, or ends it if 0.
+//-----------------------------------------------------------------------------
+
+void SAT_Enumerator::add (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (idx > _var_number) {
+	_var_number = idx;
+    }
+    if (_lit_number >= _lits.size()) {
+	_lits.resize (2*_lit_number + 16);
+    }
+    _lits[_lit_number++] = lit;
+    _solver.add (lit);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: project()
+//
+// Purpose: Adds a variable to the projection. Variables that are not in
+//          clauses are free in all solutions.
+//-----------------------------------------------------------------------------
+
+void SAT_Enumerator::project (int var)
+{
+    if (var <= 0) {
+	return;
+    }
+    if (var >= _projected.size()) {
+	int size = _projected.size();
+	_projected.resize ((var < 2*size) ? 2*size : var + 1);
+	for (int k = size; k < _projected.size(); k++) {
+	    _projected[k] = FALSE;
+	}
+    }
+    if (!_projected[var]) {
+	_projected[var] = TRUE;
+	_proj_number++;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: enumerate()
+//
+// Purpose: Reports solutions until none are left, or until limit
+//          solutions were reported.
+//
+// Side-effects: Blocking clauses are added to the solver. Later calls
+//               resume the enumeration.
+//-----------------------------------------------------------------------------
+
+int SAT_Enumerator::enumerate (int limit)
+{
+    _solver.start_limits();
+    if (_values.size() <= _var_number) {
+	int size = _values.size();
+	_values.resize (_var_number + 1);
+	_status.resize (_var_number + 1);
+	_heads.resize (_var_number + 1);
+	_cube.resize (_var_number + 1);
+	for (int k = size; k <= _var_number; k++) {
+	    _values[k] = UNKNOWN;
+	    _heads[k] = NONE;
+	}
+    }
+    int proj_number = (_proj_number) ? _proj_number : _var_number;
+
+    for (int found = 0; found < limit; found++) {
+	if (!_solver.set_limits (_mode)) {
+	    return ABORTED;
+	}
+	int outcome = _solver.solve();
+	if (outcome != SATISFIABLE) {
+	    return outcome;
+	}
+	int size = trim();
+	_solution_number++;
+	_model_number += ldexp (1.0, proj_number - size);
+	if (_report) {
+	    _report (_report_state, &_cube[0], size);
+	}
+	block (size);
+    }
+    return SATISFIABLE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: trim()
+//
+// Purpose: Trims the model found to a subset-minimal partial assignment of
+//          projection variables, and returns its size. Other variables
+//          stay assigned, hence clauses they satisfy need no projected
+//          literal.
+//
+// Side-effects: The partial assignment is written into _cube. Watches of
+//               clauses move to true literals of the model.
+//
+// Notes: Only the clauses watching variables whose values changed since
+//        the last model are visited, and then the clauses added since,
+//        ie the last blocking clause. Unassigning variables then visits
+//        the clauses watching them, as in SAT_Trimmer::trim().
+//-----------------------------------------------------------------------------
+
+int SAT_Enumerator::trim()
+{
+    int flipped = 0;
+    for (int k = 1; k <= _var_number; k++) {
+	int value = _solver.value (k);
+	if (value != _values[k]) {
+	    _values[k] = value;
+	    _cube[flipped++] = k;                  // Cube is used as a buffer
+	}
+	_status[k] = (value == UNKNOWN) ? TRIM_UNASSIGNED :
+	    (projected (k)) ? TRIM_ASSIGNED : TRIM_REQUIRED;
+    }
+    for (int k = 0; k < flipped; k++) {
+	int cl = _heads[_cube[k]];
+	_heads[_cube[k]] = NONE;
+	while (cl != NONE) {
+	    int next = _next[cl];
+	    if (!move_watch (cl)) {
+		Abort("Model found does not satisfy the clauses");
+	    }
+	    cl = next;
+	}
+    }
+    while (_watched_number < _lit_number) {
+	int start = _watched_number;
+	while (_lits[_watched_number]) {
+	    _watched_number++;
+	}
+	_watched_number++;
+	watch_clause (start);
+    }
+
+    int size = 0;
+    for (int k = 1; k <= _var_number; k++) {
+	if (_status[k] == TRIM_ASSIGNED) {
+	    unassign (k);
+	}
+	if (_status[k] == TRIM_REQUIRED && projected (k)) {
+	    _cube[size++] = (_values[k] == TRUE) ? k : -k;
+	}
+    }
+    return size;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: watch_clause()
+//
+// Purpose: Watches a true literal of the clause kept from a position,
+//          ended by 0.
+//-----------------------------------------------------------------------------
+
+void SAT_Enumerator::watch_clause (int start)
+{
+    if (_clause_number >= _pos.size()) {
+	int size = 2*_clause_number + 16;
+	_first.resize (size);
+	_pos.resize (size);
+	_next.resize (size);
+    }
+    int cl = _clause_number++;
+    _first[cl] = start;
+    _pos[cl] = start;
+    if (!_lits[start]) {
+	return;                              // Empty clause, ie no solutions
+    }
+    if (is_true (_lits[start])) {
+	int idx = (_lits[start] > 0) ? _lits[start] : -_lits[start];
+	_next[cl] = _heads[idx];
+	_heads[idx] = cl;
+    }
+    else if (!move_watch (cl)) {
+	Abort("Model found does not satisfy the clauses");
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: move_watch()
+//
+// Purpose: Moves the watch of a clause to another true literal, searching
+//          after the literal watched and then from the start of the
+//          clause. Returns FALSE if there is none, in which case the watch
+//          is not moved.
+//
+// Side-effects: The clause is added to the clauses watching its variable.
+//               It must not be in any other list of clauses.
+//-----------------------------------------------------------------------------
+
+int SAT_Enumerator::move_watch (int cl)
+{
+    int pos = _pos[cl];
+    do {
+	pos = (_lits[pos+1]) ? pos+1 : _first[cl];
+	if (is_true (_lits[pos])) {
+	    int idx = (_lits[pos] > 0) ? _lits[pos] : -_lits[pos];
+	    _pos[cl] = pos;
+	    _next[cl] = _heads[idx];
+	    _heads[idx] = cl;
+	    return TRUE;
+	}
+    } while (pos != _pos[cl]);
+    return FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: unassign()
+//
+// Purpose: Unassigns a projection variable, and moves the watches of its
+//          clauses to other true literals. Returns FALSE if some clause
+//          has none, in which case the variable is required.
+//
+// Notes: Watches moved before a clause without other true literals is
+//        found are on variables still assigned, and are kept. The clauses
+//        left keep watching the variable.
+//-----------------------------------------------------------------------------
+
+int SAT_Enumerator::unassign (int idx)
+{
+    _status[idx] = TRIM_UNASSIGNED;
+    int cl = _heads[idx];
+    while (cl != NONE) {
+	int next = _next[cl];
+	if (!move_watch (cl)) {                         // Variable is required
+	    _status[idx] = TRIM_REQUIRED;
+	    _heads[idx] = cl;
+	    return FALSE;
+	}
+	cl = next;
+    }
+    _heads[idx] = NONE;
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: block()
+//
+// Purpose: Adds the blocking clause of the partial assignment found, which
+//          is empty once all assignments are solutions.
+//-----------------------------------------------------------------------------
+
+void SAT_Enumerator::block (int size)
+{
+    if (_lit_number + size + 1 > _lits.size()) {
+	_lits.resize (2*_lit_number + size + 1);
+    }
+    for (int k = 0; k < size; k++) {
+	_lits[_lit_number++] = -_cube[k];
+	_solver.add (-_cube[k]);
+    }
+    _lits[_lit_number++] = 0;
+    _solver.add (0);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------------------
+// File: grp_Enum.hh
+//
+// Purpose: Class declaration of the enumeration of all the solutions of a
+//          formula, projected onto a set of variables, on one incremental
+//          solver (see grp_Incr.hh).
+//
+// Remarks: Each model found is trimmed to a partial assignment of the
+//          projection variables, which satisfies the clauses together
+//          with the values of the other variables in the model. Hence all
+//          extensions of the partial assignment are solutions, and it is
+//          reported as one solution. A blocking clause, ie its negation,
+//          is then added, and the solver searches again, keeping the
+//          clauses learnt so far. As blocking clauses are also satisfied
+//          by the partial assignments, the solutions reported are disjoint.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - models trimmed with watches kept across models.
+//          10/19/26 - agent - limits set on each call of the solver.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_ENUM__
+#define __GRP_ENUM__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_Incr.hh"
+#include "grp_Trim.hh"
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Enumerator
+//
+// Purpose: Keeps the clauses given with DIMACS literals, and enumerates
+//          the solutions of the formula over the projection variables.
+//
+// Notes: Without projection variables, all the variables of the clauses
+//        are projected. Options are those of the mode given, whose limits
+//        apply to the whole enumeration, ie all the calls of the solver.
+//        Clauses are kept in order to trim models, as SAT_Trimmer does
+//        (see grp_Trim.hh) but over projection variables only, which are
+//        unassigned one at a time. Each clause watches one true literal,
+//        and watches are kept across models, hence a clause is visited
+//        only when its watched variable changes value or is unassigned.
+//        Blocking clauses added earlier are thus rarely visited.
+//-----------------------------------------------------------------------------
+
+class SAT_Enumerator {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Enumerator (SAT_Mode &nmode);
+    virtual ~SAT_Enumerator();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. add() adds literals to the clause being given,
+    // which literal 0 ends. enumerate() returns UNSATISFIABLE once all
+    // solutions were reported, SATISFIABLE once limit solutions (INFINITY
+    // if none) were reported, and ABORTED if limits were exceeded. Each
+    // solution is given to the callback set by set_report(), as literals.
+    //-------------------------------------------------------------------------
+
+    virtual void add (int lit);
+    virtual void project (int var);
+    virtual int enumerate (int limit);
+
+    inline int solution_number() { return _solution_number; }
+    inline double model_number() { return _model_number; }     // Of projection
+    inline int variable_number() { return _var_number; }
+
+    inline void set_report (void *state, void (*report)(void *state,
+							 int *lits,
+							 int size)) {
+	_report_state = state;
+	_report = report;
+    }
+    inline SAT_Governor &governor() { return _solver.governor(); }
+
+protected:
+    virtual int trim();
+    virtual void block (int size);
+    virtual void watch_clause (int start);
+    virtual int move_watch (int cl);
+    virtual int unassign (int idx);
+    inline int projected (int idx) {
+	return (!_proj_number || (idx < _projected.size() && _projected[idx]));
+    }
+    inline int is_true (int lit) {
+	int idx = (lit > 0) ? lit : -lit;
+	return (_status[idx] != TRIM_UNASSIGNED &&
+		_values[idx] == ((lit > 0) ? TRUE : FALSE));
+    }
+
+    SAT_Mode &_mode;                                      // Options and limits
+    SAT_Incremental _solver;
+    int _var_number;
+
+    Array<int> _lits;                            // Clauses given, and blocking
+    int _lit_number;                                     // clauses, ended by 0
+
+    Array<char> _projected;                          // Projection, by variable
+    int _proj_number;
+
+    Array<int> _cube;                             // Solution, ie partial model
+    Array<char> _values;                           // Values of the last model
+    Array<char> _status;                     // Of variables, as in SAT_Trimmer
+    Array<int> _heads;                   // First clause watching each variable
+    Array<int> _first;                         // First literal of each clause
+    Array<int> _pos;                          // Literal watched by each clause
+    Array<int> _next;                      // Next clause watching the variable
+    int _clause_number;
+    int _watched_number;                         // Literals of clauses watched
+
+    int _solution_number;
+    double _model_number;
+
+    void (*_report)(void *state, int *lits, int size);
+    void *_report_state;
+
+};
+
+#endif // __GRP_ENUM__
+
+/*****************************************************************************/
@@ -7,6 +7,7 @@
 // Remarks: --
 //
 // History: 03/15/96 - JPMS - created.
+//          10/19/26 - agent - init, reset and clear as other engines.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -38,6 +39,10 @@ class FRE {
     // Interface contract.
     //-------------------------------------------------------------------------
 
+    virtual void init (SAT_ClauseDatabase &clDB) {}  // BCP keeps no state
+    virtual void reset (SAT_ClauseDatabase &clDB) {}    // across searches
+    virtual void clear (SAT_ClauseDatabase &clDB) {}
+
     virtual int BCP (SAT_ClauseDatabase &clDB);
 
   protected:
@@ -0,0 +1,131 @@
+//-----------------------------------------------------------------------------
+// File: grp_Governor.cc
+//
+// Purpose: Member functions of the resource governor of the search.
+//
+// Remarks: Clocks are read with clock_gettime(), ie the monotonic clock for
+//          wall-clock time, and the CPU clock of the running thread.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <iostream.h>
+
+#include "grp_Governor.hh"
+
+
+//-----------------------------------------------------------------------------
+// Constructor.
+//-----------------------------------------------------------------------------
+
+SAT_Governor::SAT_Governor (SAT_Mode &nmode) : _mode (nmode)
+{
+    _interrupted = FALSE;
+    _countdown = _spacing = 1;
+    _start_wall = _last_wall = 0.0;
+    _start_cpu = _cpu_offset = 0.0;
+    _progress = NULL;
+    _progress_state = NULL;
+    _progress_period = 0.0;
+    _next_progress = 0.0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: start()
+//
+// Purpose: Measures the time of the search from now on. Clocks are read by
+//          the first consultation, since the search may be short.
+//-----------------------------------------------------------------------------
+
+void SAT_Governor::start()
+{
+    _start_wall = _last_wall = wall_clock();
+    _start_cpu = thread_clock();
+    _cpu_offset = 0.0;
+    _countdown = _spacing = 1;
+    _next_progress = _start_wall + _progress_period;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: cpu_time()
+//
+// Purpose: Returns the CPU time of the search, in seconds.
+//-----------------------------------------------------------------------------
+
+double SAT_Governor::cpu_time()
+{
+    return thread_clock() - _start_cpu + _cpu_offset;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: check()
+//
+// Purpose: Reads the clocks, and checks the limits. The consultations until
+//          the next read are doubled if clocks were read too soon, and
+//          halved if read too late.
+//
+// Side-effects: The progress callback may be invoked.
+//-----------------------------------------------------------------------------
+
+int SAT_Governor::check (SAT_ClauseDatabase &clDB, int conflicts)
+{
+    double now = wall_clock();
+    double step = now - _last_wall;
+    _last_wall = now;
+    if (step < GOVERNOR_PERIOD / 2 && _spacing < GOVERNOR_MAX_SPACING) {
+	_spacing *= 2;
+    }
+    else if (step > 2 * GOVERNOR_PERIOD && _spacing > 1) {
+	_spacing /= 2;
+    }
+    _countdown = _spacing;
+
+    if (_progress && now >= _next_progress) {
+	_next_progress = now + _progress_period;
+	_progress (_progress_state, conflicts, clDB.dec_number(),
+		   clDB.prop_number());
+    }
+    int wall_limit = _mode[_WALL_LIMIT_];
+    int memory_limit = _mode[_MEMORY_LIMIT_];
+    return ((wall_limit != NONE && now - _start_wall > wall_limit) ||
+	    (memory_limit != NONE && clDB.pool().allocated_bytes() >
+	     (unsigned long) memory_limit * 1024 * 1024) ||
+	    (_mode[_TIME_LIMIT_] < INFINITY &&
+	     cpu_time() > _mode[_TIME_LIMIT_]));
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: wall_clock()
+//
+// Purpose: Returns the time of the monotonic clock, in seconds.
+//-----------------------------------------------------------------------------
+
+double SAT_Governor::wall_clock()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: thread_clock()
+//
+// Purpose: Returns the CPU time of the running thread, in seconds.
+//-----------------------------------------------------------------------------
+
+double SAT_Governor::thread_clock()
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------------------
+// File: grp_Governor.hh
+//
+// Purpose: Class declaration of the resource governor of the search, which
+//          decides when the search must abort, and reports its progress.
+//
+// Remarks: The search consults the governor after the deductions of each
+//          decision. Reading clocks is not free, hence clocks are read
+//          only every so many consultations, and this number is adapted
+//          such that clocks are read about every GOVERNOR_PERIOD seconds.
+//          The search can be interrupted at any time, eg by another thread
+//          or by a signal handler, which is checked by each consultation.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - clocks available to other classes.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_GOVERNOR__
+#define __GRP_GOVERNOR__
+
+#include <signal.h>
+
+#include "defs.hh"
+#include "grp_Mode.hh"
+#include "grp_CDB.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for the resource governor.
+//-----------------------------------------------------------------------------
+
+# define GOVERNOR_PERIOD      0.01               // Seconds between clock reads
+# define GOVERNOR_MAX_SPACING 65536         // Most consultations between reads
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Governor
+//
+// Purpose: Aborts the search once interrupted, or once a limit is exceeded
+//          on wall-clock time (_WALL_LIMIT_), on CPU time (_TIME_LIMIT_),
+//          or on the memory used by the clause database (_MEMORY_LIMIT_).
+//          Invokes the progress callback, if any, periodically.
+//
+// Notes: CPU time is that of the thread running the search, hence neither
+//        threads of the same process solving other instances, nor threads
+//        helping this search, eg by eliminating variables, are counted.
+//        Memory is counted from the blocks of the pool of the database,
+//        which hold its variables, clauses and literals. Each interrupt
+//        aborts one search, ie the next one if given while not searching.
+//-----------------------------------------------------------------------------
+
+class SAT_Governor {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Governor (SAT_Mode &nmode);
+    virtual ~SAT_Governor() {}
+
+    //-------------------------------------------------------------------------
+    // Interface contract. start() is invoked when the search starts, and
+    // exceeded() whenever the search may abort. The CPU time of the search
+    // includes cpu_offset(), eg the time searched before resuming.
+    //-------------------------------------------------------------------------
+
+    virtual void start();
+    inline int exceeded (SAT_ClauseDatabase &clDB, int conflicts) {
+	if (_interrupted) {
+	    _interrupted = FALSE;                     // Only aborts one search
+	    return TRUE;
+	}
+	if (--_countdown > 0) {
+	    return FALSE;
+	}
+	return check (clDB, conflicts);
+    }
+    virtual double cpu_time();                         // Seconds of the search
+    inline double &cpu_offset() { return _cpu_offset; }
+
+    //-------------------------------------------------------------------------
+    // Clocks, in seconds: the monotonic clock, and the CPU clock of the
+    // running thread.
+    //-------------------------------------------------------------------------
+
+    static double wall_clock();
+    static double thread_clock();
+
+    //-------------------------------------------------------------------------
+    // Asynchronous interrupt, and progress callback. interrupt() only sets
+    // a flag, hence can be invoked from other threads and signal handlers.
+    //-------------------------------------------------------------------------
+
+    inline void interrupt() { _interrupted = TRUE; }
+    inline void set_progress (void *state, double period,
+			      void (*progress)(void *state, long conflicts,
+					       long decisions,
+					       long propagations)) {
+	_progress_state = state;             // Invoked every period seconds of
+	_progress_period = period;              // wall-clock time, unless NULL
+	_progress = progress;
+    }
+
+protected:
+    virtual int check (SAT_ClauseDatabase &clDB, int conflicts);
+
+    SAT_Mode &_mode;
+    volatile sig_atomic_t _interrupted;
+
+    int _countdown;                      // Consultations until next clock read
+    int _spacing;                          // Consultations between clock reads
+    double _start_wall;
+    double _start_cpu;
+    double _cpu_offset;
+    double _last_wall;                               // Time of last clock read
+
+    void (*_progress)(void *state, long conflicts, long decisions,
+		      long propagations);
+    void *_progress_state;
+    double _progress_period;
+    double _next_progress;
+
+};
+
+#endif // __GRP_GOVERNOR__
+
+/*****************************************************************************/
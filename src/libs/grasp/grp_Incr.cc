@@ -0,0 +1,822 @@
+//-----------------------------------------------------------------------------
+// File: grp_Incr.cc
+//
+// Purpose: Member functions of the incremental interface of GRASP, and the
+//          C interface of incremental solvers built on it.
+//
+// Remarks: Between calls, all variables are unassigned, hence clauses are
+//          added to the database as when loading an instance, and deleted
+//          with the groups popped.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - groups of clauses.
+//          10/19/26 - agent - limit on the conflicts of each call.
+//          10/19/26 - agent - export of learnt clauses.
+//          10/19/26 - agent - groups in the core.
+//          10/19/26 - agent - limits of sequences of calls.
+//          10/19/26 - agent - groups pushed without a name.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream.h>
+
+#include "grp_Incr.hh"
+#include "ipasir.h"
+
+
+//-----------------------------------------------------------------------------
+// Local variable definitions.
+//-----------------------------------------------------------------------------
+
+static char group_var_name[] = "*group*";      // Name of activation variables
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static void learnt_clause (void *state, SAT_ClausePtr cl)
+{
+    ((SAT_Incremental*) state)->learn_clause (cl);
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_Incremental::SAT_Incremental() : _mode(), _clDB(_mode), _sat(_mode),
+    _vars(0), _names(0), _indexes(0), _pending(0), _marks(0), _assumed(0),
+    _model(0), _fixed(0), _core(0), _core_marks(0), _group_vars(0),
+    _group_names(0), _group_failed(0), _group_off(0), _free_vars(0),
+    _learnt(0)
+{
+    _mode.setup();
+    _mode[_BACKTRACK_LIMIT_] = INFINITY;
+    _mode[_CONFLICT_LIMIT_] = INFINITY;
+    _mode[_TIME_LIMIT_] = INFINITY;
+    _mode[_SPACE_LIMIT_] = INFINITY;
+    _setup = FALSE;
+    _conflict_limit = INFINITY;
+    _start_conflicts = 0;
+    _start_wall = _start_cpu = 0.0;
+    _var_number = 0;
+    _model_number = 0;
+    _fixed_number = 0;
+    _core_size = 0;
+    _pending_size = 0;
+    _stamp = 0;
+    _assumed_size = 0;
+    _inconsistent = FALSE;
+    _group_number = 0;
+    _free_number = 0;
+    _learn = NULL;
+    _learn_state = NULL;
+    _learn_length = 0;
+}
+
+SAT_Incremental::~SAT_Incremental()
+{
+    for (int k = 1; k <= _var_number; k++) {      // Names are not used by the
+	delete[] _names[k];                       // destructor of the database
+    }
+    for (int k = 0; k < _group_number; k++) {
+	delete[] _group_names[k];
+    }
+    _vars.resize (0);
+    _names.resize (0);
+    _indexes.resize (0);
+    _pending.resize (0);
+    _marks.resize (0);
+    _assumed.resize (0);
+    _model.resize (0);
+    _fixed.resize (0);
+    _core.resize (0);
+    _core_marks.resize (0);
+    _group_vars.resize (0);
+    _group_names.resize (0);
+    _group_failed.resize (0);
+    _group_off.resize (0);
+    _free_vars.resize (0);
+    _learnt.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: set_options()
+//
+// Purpose: Takes the options of another mode, eg of the command line, but
+//          for the limits, and for the options of engines that are not
+//          used by incremental solvers.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::set_options (SAT_Mode &nmode)
+{
+    for (int k = 0; k < SAT_OPTION_NUMBER; k++) {
+	switch (k) {
+	  case _BACKTRACK_LIMIT_:
+	  case _CONFLICT_LIMIT_:
+	  case _TIME_LIMIT_:
+	  case _SPACE_LIMIT_:
+	  case _WALL_LIMIT_:
+	  case _MEMORY_LIMIT_:
+	  case _PREPROC_LEVEL_:
+	  case _ELIM_THREADS_:
+	  case _LOCAL_THREADS_:
+	    break;
+	  default:
+	    _mode[k] = nmode[k];
+	}
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add()
+//
+// Purpose: Adds a literal to the clause being given, or adds the clause to
+//          the database if lit is 0.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::add (int lit)
+{
+    if (!lit) {
+	add_pending();
+	return;
+    }
+    if (_pending_size >= _pending.size()) {
+	_pending.resize ((_pending.size()) ? 2*_pending.size() : 16);
+    }
+    _pending[_pending_size++] = lit;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: assume()
+//
+// Purpose: Adds an assumption for the next call of solve().
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::assume (int lit)
+{
+    if (_assumed_size >= _assumed.size()) {
+	_assumed.resize ((_assumed.size()) ? 2*_assumed.size() : 16);
+    }
+    _assumed[_assumed_size++] = lit;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: solve()
+//
+// Purpose: Solves the formula under the assumptions given since the last
+//          call, and those of the groups pushed.
+//
+// Side-effects: The engines are set up by the first call. Clauses learnt
+//               are kept in the database, and the values of the solution
+//               found, if any, become the preferred values of decisions.
+//               Assumptions given are cleared. If unsatisfiable, those
+//               traced by the final conflict analysis become the core.
+//               Values at decision level 0 are kept, unless the call
+//               returns before searching.
+//
+// Notes: Conflicts are counted from the first call, hence the limit on the
+//        conflicts of the call is set from the conflicts found so far.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::solve()
+{
+    if (!_setup) {
+	_sat.setup (_clDB);
+	_sat.clear (_clDB);
+	_setup = TRUE;
+    }
+    DecisionEngine &decEng = _sat.decision_engine();
+    decEng.clear_assumptions();
+    clear_core();
+    _fixed_number = 0;
+    int assumed_size = _assumed_size;
+    _assumed_size = 0;
+    if (_inconsistent) {
+	return UNSATISFIABLE;
+    }
+    for (int k = 0; k < _group_number; k++) {
+	decEng.add_assumption (_group_vars[k], !_group_off[k]);
+    }
+    for (int k = 0; k < assumed_size; k++) {
+	int lit = _assumed[k];
+	decEng.add_assumption (variable (lit), (lit > 0) ? TRUE : FALSE);
+    }
+    if (!_clDB.variables().size()) {
+	return SATISFIABLE;
+    }
+    int conflicts = _sat.backward_engine().conf_number();
+    _mode[_CONFLICT_LIMIT_] = (_conflict_limit < INFINITY - conflicts) ?
+	conflicts + _conflict_limit : INFINITY;
+    _sat.backward_engine().set_learn (this, _learn_length,
+				      (_learn) ? learnt_clause : NULL);
+    _sat.init (_clDB);
+    int outcome = _sat.solve (_clDB);
+
+    if (_fixed.size() < _vars.size()) {
+	_fixed.resize (_vars.size());
+    }
+    _fixed_number = _var_number;
+    for (int k = 1; k <= _var_number; k++) {
+	SAT_VariablePtr var = _vars[k];
+	_fixed[k] = (var->DLevel() == 0) ? var->value() : UNKNOWN;
+    }
+    if (outcome == SATISFIABLE) {
+	if (_model.size() < _vars.size()) {
+	    _model.resize (_vars.size());
+	}
+	_model_number = _var_number;
+	for (int k = 1; k <= _var_number; k++) {
+	    SAT_VariablePtr var = _vars[k];
+	    _model[k] = var->value();
+	    if (var->value() != UNKNOWN) {
+		decEng.set_preferred_value (var, var->value());
+	    }
+	}
+    }
+    else if (outcome == UNSATISFIABLE && !decEng.assumption_number()) {
+	_inconsistent = TRUE;
+    }
+    else if (outcome == UNSATISFIABLE) {
+	BRE &bre = _sat.backward_engine();
+	for (int k = 0; k < assumed_size && bre.failed_number(); k++) {
+	    int lit = _assumed[k];
+	    if (bre.failed (_vars[(lit > 0) ? lit : -lit], (lit > 0))) {
+		add_core (lit);
+	    }
+	}
+	for (int k = 0; k < _group_number && bre.failed_number(); k++) {
+	    _group_failed[k] = (!_group_off[k] &&
+				bre.failed (_group_vars[k], TRUE));
+	}
+    }
+    _sat.reset (_clDB);
+    _clDB.reset();
+    return outcome;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: start_limits()
+//
+// Purpose: Starts measuring the resources of a sequence of calls.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::start_limits()
+{
+    _start_conflicts = conflict_number();
+    _start_wall = SAT_Governor::wall_clock();
+    _start_cpu = SAT_Governor::thread_clock();
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: set_limits()
+//
+// Purpose: Sets the limits of the next call to the resources left, since
+//          start_limits(), of the limits given. Returns FALSE if none are
+//          left.
+//
+// Notes: Limits are then checked by the governor, hence no clock is read
+//        on each decision. Time limits are in whole seconds, and the time
+//        left is rounded up, ie the sequence may exceed them by less than
+//        one second. CPU time is that of the running thread.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::set_limits (SAT_Mode &limits)
+{
+    int conflicts = conflict_number() - _start_conflicts;
+    int limit = limits[_CONFLICT_LIMIT_];
+    if (conflicts >= limit) {
+	return FALSE;
+    }
+    _conflict_limit = (limit < INFINITY) ? limit - conflicts : INFINITY;
+
+    _mode[_TIME_LIMIT_] = INFINITY;
+    if ((limit = limits[_TIME_LIMIT_]) < INFINITY) {
+	double left = limit - (SAT_Governor::thread_clock() - _start_cpu);
+	if (left <= 0.0) {
+	    return FALSE;
+	}
+	_mode[_TIME_LIMIT_] = (int) left + 1;
+    }
+    _mode[_WALL_LIMIT_] = NONE;
+    if ((limit = limits[_WALL_LIMIT_]) != NONE) {
+	double left = limit - (SAT_Governor::wall_clock() - _start_wall);
+	if (left <= 0.0) {
+	    return FALSE;
+	}
+	_mode[_WALL_LIMIT_] = (int) left + 1;
+    }
+    _mode[_MEMORY_LIMIT_] = limits[_MEMORY_LIMIT_];
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: value()
+//
+// Purpose: Returns the value of a literal in the last solution found, or
+//          UNKNOWN if its variable was not assigned.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::value (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (idx > _model_number || _model[idx] == UNKNOWN) {
+	return UNKNOWN;
+    }
+    return (lit > 0) ? _model[idx] : !_model[idx];
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: failed()
+//
+// Purpose: Checks whether an assumption of the last call was required for
+//          the formula to be unsatisfiable.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::failed (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (idx >= _core_marks.size()) {
+	return FALSE;
+    }
+    return (_core_marks[idx] & (1 << (lit > 0))) != 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: fixed()
+//
+// Purpose: Checks whether a literal was implied true by the clauses in the
+//          last call, ie before any assumption was decided.
+//
+// Notes: Clauses of groups have the literal of an activation variable,
+//        which is assumed, hence only imply values at later levels.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::fixed (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (idx > _fixed_number || _fixed[idx] == UNKNOWN) {
+	return FALSE;
+    }
+    return ((lit > 0) ? _fixed[idx] : !_fixed[idx]) == TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: set_learn()
+//
+// Purpose: Sets the callback given each clause learnt by later calls with
+//          at most max_length literals, as DIMACS literals ended by 0. A
+//          NULL callback stops the export.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::set_learn (void *state, int max_length,
+				 void (*learn)(void *state, int *clause))
+{
+    _learn_state = state;
+    _learn_length = max_length;
+    _learn = learn;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: learn_clause()
+//
+// Purpose: Gives a clause learnt to the callback of set_learn().
+//
+// Notes: Clauses with the activation variable of a group are only implied
+//        while the group is pushed, and are not given.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::learn_clause (SAT_ClausePtr cl)
+{
+    if (_learnt.size() <= cl->size()) {
+	_learnt.resize (cl->size() + 1);
+    }
+    int size = 0;
+    for_each(plit, cl->literals(), LiteralPtr) {
+	LiteralPtr lit = plit->data();
+	int ID = lit->variable()->ID();
+	int idx = (ID < _indexes.size()) ? _indexes[ID] : 0;
+	if (!idx) {
+	    return;                           // Activation variable of a group
+	}
+	_learnt[size++] = (lit->sign()) ? -idx : idx;
+    }
+    _learnt[size] = 0;
+    _learn (_learn_state, &_learnt[0]);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: minimize_core()
+//
+// Purpose: Removes assumptions and groups from the core of the last call,
+//          until each one left is required for the formula to be
+//          unsatisfiable.
+//
+// Side-effects: Makes one call of solve() for each assumption or group of
+//               the core that is not removed by the core of another call.
+//               Assumptions given for the next call are discarded.
+//
+// Notes: Groups are removed by assuming their activation variables false,
+//        which satisfies their clauses, and groups out of the core are
+//        removed for all calls. Items of the core before kept, ie
+//        assumptions and then groups, are required, hence are in the core
+//        of any unsatisfiable call, and stay before kept.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::minimize_core()
+{
+    int size = _core_size;
+    _assumed_size = 0;
+    Array<int> core (size);
+    for (int k = 0; k < size; k++) {
+	core[k] = _core[k];
+    }
+    Array<int> groups (_group_number);                    // Groups of the core
+    int group_size = 0;
+    for (int k = 0; k < _group_number; k++) {
+	_group_off[k] = !_group_failed[k];
+	if (_group_failed[k]) {
+	    groups[group_size++] = k;
+	}
+    }
+    int kept = 0;
+    while (kept < size + group_size) {
+	for (int k = 0; k < size; k++) {
+	    if (k != kept) {
+		assume (core[k]);
+	    }
+	}
+	if (kept >= size) {
+	    _group_off[groups[kept - size]] = TRUE;
+	}
+	int outcome = solve();
+	if (kept >= size) {
+	    _group_off[groups[kept - size]] = FALSE;
+	}
+	if (outcome == UNSATISFIABLE) {              // Refine to failed ones
+	    int new_size = 0;
+	    for (int k = 0; k < size; k++) {
+		if (failed (core[k])) {
+		    core[new_size++] = core[k];
+		}
+	    }
+	    size = new_size;
+	    new_size = 0;
+	    for (int k = 0; k < group_size; k++) {
+		if (_group_failed[groups[k]]) {
+		    groups[new_size++] = groups[k];
+		}
+		else { _group_off[groups[k]] = TRUE; }
+	    }
+	    group_size = new_size;
+	}
+	else { kept++; }                   // Assumption or group is required
+    }
+    clear_core();
+    for (int k = 0; k < size; k++) {
+	add_core (core[k]);
+    }
+    for (int k = 0; k < _group_number; k++) {
+	_group_off[k] = FALSE;
+    }
+    for (int k = 0; k < group_size; k++) {
+	_group_failed[groups[k]] = TRUE;
+    }
+    return size;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_core()
+//
+// Purpose: Adds a failed assumption to the core.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::add_core (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (idx >= _core_marks.size()) {
+	int size = _core_marks.size();
+	_core_marks.resize ((idx < 2*size) ? 2*size : idx + 1);
+	for (int k = size; k < _core_marks.size(); k++) {
+	    _core_marks[k] = 0;
+	}
+    }
+    if (_core_marks[idx] & (1 << (lit > 0))) {
+	return;                                             // Assumed twice
+    }
+    _core_marks[idx] |= (1 << (lit > 0));
+    if (_core_size >= _core.size()) {
+	_core.resize ((_core.size()) ? 2*_core.size() : 16);
+    }
+    _core[_core_size++] = lit;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: clear_core()
+//
+// Purpose: Forgets the core, in time linear in its size and in the number
+//          of groups.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::clear_core()
+{
+    for (int k = 0; k < _core_size; k++) {
+	int lit = _core[k];
+	_core_marks[(lit > 0) ? lit : -lit] = 0;
+    }
+    _core_size = 0;
+    for (int k = 0; k < _group_number; k++) {
+	_group_failed[k] = FALSE;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: variable()
+//
+// Purpose: Returns the variable of a literal, creating it and all variables
+//          with smaller index if required. Variables are named by index.
+//-----------------------------------------------------------------------------
+
+SAT_VariablePtr SAT_Incremental::variable (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (idx >= _vars.size()) {
+	int size = (idx < 2*_vars.size()) ? 2*_vars.size() : idx+1;
+	_vars.resize (size);
+	_names.resize (size);
+	_marks.resize (size);
+	for (int k = _var_number+1; k < size; k++) {
+	    _marks[k] = 0;
+	}
+    }
+    while (_var_number < idx) {
+	_var_number++;
+	char buffer[16];
+	sprintf (buffer, "%d", _var_number);
+	_names[_var_number] = new char[strlen(buffer)+1];
+	strcpy (_names[_var_number], buffer);
+	SAT_VariablePtr var = _clDB.add_variable (_names[_var_number]);
+	_vars[_var_number] = var;
+	if (var->ID() >= _indexes.size()) {
+	    int orig_size = _indexes.size();
+	    _indexes.resize (2*var->ID() + 16);
+	    for (int k = orig_size; k < _indexes.size(); k++) {
+		_indexes[k] = 0;
+	    }
+	}
+	_indexes[var->ID()] = _var_number;
+    }
+    return _vars[idx];
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_pending()
+//
+// Purpose: Adds the clause given to the database. Repeated literals are
+//          added once, and clauses with complementary literals are not
+//          added. The formula becomes unsatisfiable once an empty clause
+//          is added.
+//
+// Notes: Literals of the clause are marked with the stamp of the clause,
+//        which is negated for negative literals. Clauses of groups have
+//        the negative literal of the activation variable of the group,
+//        hence an empty clause only makes the group unsatisfiable.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::add_pending()
+{
+    int size = _pending_size;
+    _pending_size = 0;
+    if (!size && !_group_number) {
+	_inconsistent = TRUE;
+	return;
+    }
+    _stamp++;
+    int kept = 0;
+    for (int k = 0; k < size; k++) {
+	int lit = _pending[k];
+	int idx = (lit > 0) ? lit : -lit;
+	variable (lit);
+	int mark = (lit > 0) ? _stamp : -_stamp;
+	if (_marks[idx] == mark) {
+	    continue;                                    // Repeated literal
+	}
+	if (_marks[idx] == -mark) {
+	    return;                                      // Clause is satisfied
+	}
+	_marks[idx] = mark;
+	_pending[kept++] = lit;
+    }
+    SAT_ClausePtr cl = _clDB.add_clause();
+    for (int k = 0; k < kept; k++) {
+	int lit = _pending[k];
+	_clDB.add_literal (cl, variable (lit), (lit < 0));
+    }
+    if (_group_number) {
+	_clDB.add_literal (cl, _group_vars[_group_number-1], TRUE);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: push()
+//
+// Purpose: Pushes a group of clauses, given a name that is copied. A
+//          NULL name is taken as the empty name.
+//
+// Notes: Clauses given while the group is pushed are extended with the
+//        negative literal of its activation variable. Variables of groups
+//        popped are reused.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::push (char *name)
+{
+    if (_group_number >= _group_vars.size()) {
+	int size = (_group_vars.size()) ? 2*_group_vars.size() : 16;
+	_group_vars.resize (size);
+	_group_names.resize (size);
+	_group_failed.resize (size);
+	_group_off.resize (size);
+    }
+    SAT_VariablePtr var = (_free_number) ? _free_vars[--_free_number] :
+	_clDB.add_variable (group_var_name);
+    _group_vars[_group_number] = var;
+    _group_failed[_group_number] = FALSE;
+    _group_off[_group_number] = FALSE;
+    if (!name) {
+	name = (char*) "";
+    }
+    _group_names[_group_number] = new char[strlen(name)+1];
+    strcpy (_group_names[_group_number++], name);
+    return _group_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: pop()
+//
+// Purpose: Pops the group pushed last, or else the last group pushed with
+//          the name given, and the groups pushed after it. Nothing is
+//          popped if no group has the name given.
+//-----------------------------------------------------------------------------
+
+int SAT_Incremental::pop (char *name)
+{
+    int last = _group_number-1;
+    if (name) {
+	for (; last >= 0; last--) {
+	    if (!strcmp (_group_names[last], name)) { break; }
+	}
+    }
+    if (last < 0) {
+	return _group_number;
+    }
+    while (_group_number > last) {
+	pop_group();
+    }
+    return _group_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: pop_group()
+//
+// Purpose: Pops the group pushed last.
+//
+// Side-effects: Clauses with the activation variable of the group, either
+//               given or learnt, are deleted. The variable becomes free.
+//-----------------------------------------------------------------------------
+
+void SAT_Incremental::pop_group()
+{
+    SAT_VariablePtr var = _group_vars[--_group_number];
+    delete[] _group_names[_group_number];
+
+    LiteralListPtr plit;
+    while ((plit = var->literals().first())) {
+	_clDB.del_clause ((SAT_ClausePtr) plit->data()->clause());
+    }
+    if (_free_number >= _free_vars.size()) {
+	_free_vars.resize ((_free_vars.size()) ? 2*_free_vars.size() : 16);
+    }
+    _free_vars[_free_number++] = var;
+}
+
+
+//-----------------------------------------------------------------------------
+// C interface of incremental solvers. Solvers are SAT_Incremental objects,
+// and memory management is initialized by the first solver created.
+//-----------------------------------------------------------------------------
+
+const char *ipasir_signature()
+{
+    return "grasp";
+}
+
+void *ipasir_init()
+{
+    MEM_MNG_INIT();
+    return (void*) new SAT_Incremental();
+}
+
+void ipasir_release (void *solver)
+{
+    delete (SAT_Incremental*) solver;
+}
+
+void ipasir_add (void *solver, int32_t lit_or_zero)
+{
+    ((SAT_Incremental*) solver)->add (lit_or_zero);
+}
+
+void ipasir_assume (void *solver, int32_t lit)
+{
+    ((SAT_Incremental*) solver)->assume (lit);
+}
+
+int ipasir_solve (void *solver)
+{
+    switch (((SAT_Incremental*) solver)->solve()) {
+      case SATISFIABLE:
+	return 10;
+      case UNSATISFIABLE:
+	return 20;
+      default:
+	return 0;
+    }
+}
+
+int32_t ipasir_val (void *solver, int32_t lit)
+{
+    switch (((SAT_Incremental*) solver)->value (lit)) {
+      case TRUE:
+	return lit;
+      case FALSE:
+	return -lit;
+      default:
+	return 0;
+    }
+}
+
+int ipasir_failed (void *solver, int32_t lit)
+{
+    return ((SAT_Incremental*) solver)->failed (lit);
+}
+
+void ipasir_set_terminate (void *solver, void *data,
+			   int (*terminate)(void *data))
+{
+    ((SAT_Incremental*) solver)->set_terminate (data, terminate);
+}
+
+void ipasir_set_learn (void *solver, void *data, int max_length,
+		       void (*learn)(void *data, int32_t *clause))
+{
+    ((SAT_Incremental*) solver)->set_learn (data, max_length, learn);
+}
+
+int grasp_push (void *solver, const char *name)
+{
+    return ((SAT_Incremental*) solver)->push ((char*) name);
+}
+
+int grasp_pop (void *solver, const char *name)
+{
+    return ((SAT_Incremental*) solver)->pop ((char*) name);
+}
+
+int grasp_minimize_core (void *solver)
+{
+    return ((SAT_Incremental*) solver)->minimize_core();
+}
+
+int grasp_group_failed (void *solver, int group)
+{
+    return ((SAT_Incremental*) solver)->group_failed (group);
+}
+
+void grasp_interrupt (void *solver)
+{
+    ((SAT_Incremental*) solver)->governor().interrupt();
+}
+
+/*****************************************************************************/
@@ -0,0 +1,202 @@
+//-----------------------------------------------------------------------------
+// File: grp_Incr.hh
+//
+// Purpose: Class declaration of the incremental interface of GRASP, which
+//          solves a formula that grows between calls, under assumptions.
+//
+// Remarks: The same clause database and engines are used by all calls,
+//          hence the clauses learnt by a call, and the values taken by the
+//          variables, are kept by later calls. The C interface of
+//          incremental solvers (see ipasir.h) is built on this class.
+//          Clauses can be given in groups, which are later removed with
+//          the clauses learnt from them.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - groups of clauses.
+//          10/19/26 - agent - limit on the conflicts of each call.
+//          10/19/26 - agent - minimization of the failed assumptions.
+//          10/19/26 - agent - resource governor and interrupts.
+//          10/19/26 - agent - access to the core, and options of other modes.
+//          10/19/26 - agent - literals fixed at decision level 0.
+//          10/19/26 - agent - export of learnt clauses.
+//          10/19/26 - agent - groups in the core.
+//          10/19/26 - agent - limits of sequences of calls.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_INCR__
+#define __GRP_INCR__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_CDB.hh"
+#include "grp_SAT.hh"
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Incremental
+//
+// Purpose: Keeps the clauses and assumptions given with DIMACS literals,
+//          and solves the formula with GRASP_SAT. Assumptions are decided
+//          before any other variable, and are cleared by each call.
+//
+// Notes: Variable elimination, preprocessing and local search are not
+//        used. Calls are limited by the conflicts set, by set_terminate()
+//        and by the governor (see grp_Governor.hh). Each group of clauses
+//        is guarded by an activation variable, assumed true while the
+//        group is pushed. Memory management must be initialized
+//        beforehand (see memory.hh).
+//-----------------------------------------------------------------------------
+
+class SAT_Incremental {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Incremental();
+    virtual ~SAT_Incremental();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. add() adds literals to the clause being given,
+    // which literal 0 ends. solve() returns SATISFIABLE, UNSATISFIABLE or
+    // ABORTED. Once satisfiable, value() gives the values of literals, ie
+    // TRUE, FALSE or UNKNOWN. Once unsatisfiable, failed() identifies the
+    // assumptions that were required, ie the core of the call. fixed()
+    // identifies the literals implied by the clauses alone in the last
+    // call, ie assigned true at decision level 0, whatever its outcome.
+    //-------------------------------------------------------------------------
+
+    inline SAT_Mode &mode() { return _mode; }
+    virtual void set_options (SAT_Mode &nmode);        // All but the limits
+
+    virtual void add (int lit);
+    virtual void assume (int lit);
+    virtual int solve();
+
+    virtual int value (int lit);
+    virtual int failed (int lit);
+    virtual int fixed (int lit);
+
+    inline void set_terminate (void *state, int (*terminate)(void *state)) {
+	_sat.set_terminate (state, terminate);
+    }
+    virtual void set_learn (void *state, int max_length,
+			    void (*learn)(void *state, int *clause));
+    inline void set_conflict_limit (int conflicts) {   // INFINITY if none
+	_conflict_limit = conflicts;
+    }
+    inline int variable_number() { return _var_number; }
+    inline int conflict_number() {                  // Of all calls so far
+	return (_setup) ? _sat.backward_engine().conf_number() : 0;
+    }
+    inline SAT_Governor &governor() { return _sat.governor(); }
+
+    //-------------------------------------------------------------------------
+    // Limits of a sequence of calls, eg by engines built on this class.
+    // start_limits() starts measuring the resources of the sequence, and
+    // set_limits() sets the limits of the next call to those left of the
+    // limits of the mode given, ie conflicts, CPU and wall-clock time and
+    // memory. It returns FALSE if no resources are left.
+    //-------------------------------------------------------------------------
+
+    virtual void start_limits();
+    virtual int set_limits (SAT_Mode &limits);
+
+    //-------------------------------------------------------------------------
+    // Minimization of the core. minimize_core() removes assumptions and
+    // groups from the core of an unsatisfiable call until each one left is
+    // required, and returns the number of assumptions left. Assumptions
+    // are then identified by failed(), groups by group_failed(), and the
+    // values of the last satisfiable call made by the minimization are
+    // given by value().
+    //-------------------------------------------------------------------------
+
+    virtual int minimize_core();
+    inline int core_size() { return _core_size; }
+    inline int core_literal (int k) { return _core[k]; }        // In order
+
+    //-------------------------------------------------------------------------
+    // Groups of clauses. Clauses given while groups are pushed belong to
+    // the group pushed last. pop() removes the group pushed last, or the
+    // last group with the given name and all groups pushed after it. Both
+    // return the number of groups pushed afterwards, hence groups are
+    // identified by the number returned by push(). Once unsatisfiable,
+    // group_failed() identifies the groups whose clauses were required,
+    // ie the groups of the core.
+    //-------------------------------------------------------------------------
+
+    virtual int push (char *name);
+    virtual int pop (char *name = NULL);
+    inline int group_number() { return _group_number; }
+    inline char *group_name (int group) { return _group_names[group-1]; }
+    inline int group_failed (int group) {
+	return (group >= 1 && group <= _group_number &&
+		_group_failed[group-1]);
+    }
+
+    //-------------------------------------------------------------------------
+    // Invoked by the BRE with each clause learnt that is short enough.
+    //-------------------------------------------------------------------------
+
+    virtual void learn_clause (SAT_ClausePtr cl);
+
+protected:
+    SAT_VariablePtr variable (int lit);
+    void add_pending();
+    void pop_group();
+    void add_core (int lit);
+    void clear_core();
+
+    SAT_Mode _mode;                                    // Configuration options
+    SAT_ClauseDatabase _clDB;                   // Must outlive engines of _sat
+    GRASP_SAT _sat;
+    int _setup;
+    int _conflict_limit;                             // Conflicts of each call
+    int _start_conflicts;                           // Of the sequence of calls
+    double _start_wall;
+    double _start_cpu;
+
+    Array<SAT_VariablePtr> _vars;                  // Variables by DIMACS index
+    Array<char*> _names;
+    int _var_number;
+    Array<int> _indexes;              // DIMACS index by variable ID, 0 if none
+
+    Array<int> _pending;                          // Clause being given, if any
+    int _pending_size;
+    Array<int> _marks;                        // Literals in clause being given
+    int _stamp;
+
+    Array<int> _assumed;                                   // Assumptions given
+    int _assumed_size;
+
+    Array<int> _model;                         // Values of last solution found
+    int _model_number;
+    Array<int> _fixed;                            // Values at decision level 0
+    int _fixed_number;
+
+    Array<int> _core;                          // Failed assumptions, in order
+    int _core_size;
+    Array<int> _core_marks;            // Values failed by variable, as bits
+
+    Array<SAT_VariablePtr> _group_vars;       // Activation variables, in order
+    Array<char*> _group_names;
+    Array<int> _group_failed;                            // Whether in the core
+    Array<int> _group_off;                // Disabled while minimizing the core
+    int _group_number;
+    Array<SAT_VariablePtr> _free_vars;            // Variables of groups popped
+    int _free_number;
+    int _inconsistent;                          // Empty clause added, or unsat
+
+    void (*_learn)(void *state, int *clause);       // Export of learnt clauses
+    void *_learn_state;
+    int _learn_length;
+    Array<int> _learnt;                             // Clause given to _learn()
+
+};
+
+#endif // __GRP_INCR__
+
+/*****************************************************************************/
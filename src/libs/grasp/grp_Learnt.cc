@@ -0,0 +1,448 @@
+//-----------------------------------------------------------------------------
+// File: grp_Learnt.cc
+//
+// Purpose: Member functions of files of learnt clauses.
+//
+// Remarks: Files are checked for layout, checksum and key before any
+//          clause is imported, hence files of other instances, and files
+//          partially written, are ignored. Files are replaced only once
+//          written, hence the file imported by a run can also be the file
+//          exported by it.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - counters and units kept for checkpoints.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <iostream.h>
+
+#include "grp_Learnt.hh"
+
+
+# define LEARNT_NAME_SIZE   32                   // Longest suffix of names
+# define LEARNT_TEMP_SUFFIX ".tmp"
+# define CHECKSUM_BASIS     0xcbf29ce484222325UL
+# define CHECKSUM_PRIME     0x100000001b3UL
+# define SALT_PRIME         0xc2b2ae3d27d4eb4fUL
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static inline unsigned long checksum_words (unsigned long sum,
+					    unsigned int *words,
+					    unsigned long number)
+{
+    for (unsigned long k = 0; k < number; k++) {
+	sum = (sum ^ words[k]) * CHECKSUM_PRIME;
+    }
+    return sum;
+}
+
+static inline int valid_literal (int lit, int var_number)
+{
+    return lit != 0 && lit >= -var_number && lit <= var_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: valid_file()
+//
+// Purpose: Checks the layout, the checksum and the contents of a file, such
+//          that its clauses can be imported without further checks.
+//-----------------------------------------------------------------------------
+
+static int valid_file (SAT_LearntHeader *file, unsigned long size,
+		       SAT_CacheKey key, int var_number)
+{
+    SAT_LearntHeader &header = *file;
+    if (size < sizeof(SAT_LearntHeader) ||
+	memcmp (header.magic, SAT_LEARNT_MAGIC, SAT_LEARNT_MAGIC_SIZE) ||
+	header.version != SAT_LEARNT_VERSION ||
+	header.header_size != sizeof(SAT_LearntHeader) ||
+	header.key[0] != key[0] || header.key[1] != key[1] ||
+	header.var_number != var_number || header.cl_number < 0 ||
+	header.stat_number < 0 ||
+	header.stat_number > SAT_LEARNT_MAX_STATS ||
+	header.file_size != size ||
+	header.file_size != header.header_size +
+	header.stat_number * sizeof(long) +
+	(header.var_number + 2 * (unsigned long) header.cl_number +
+	 header.lit_number) * sizeof(int)) {
+	return FALSE;
+    }
+    unsigned int *words = (unsigned int*) ((char*) file + header.header_size);
+    unsigned long number = (size - header.header_size) / 4;
+    if (checksum_words (CHECKSUM_BASIS, words, number) != header.checksum) {
+	return FALSE;
+    }
+    int *values = (int*) ((char*) words + header.stat_number * sizeof(long));
+    for (int k = 0; k < header.var_number; k++) {
+	if (values[k] != FALSE && values[k] != TRUE && values[k] != UNKNOWN) {
+	    return FALSE;
+	}
+    }
+    int *lits = values + header.var_number;
+    unsigned long left = header.lit_number;
+    for (int j = 0; j < header.cl_number; j++) {
+	int lbd = *lits++, cl_size = *lits++;
+	if (lbd <= 0 || cl_size <= 0 || (unsigned long) cl_size > left) {
+	    return FALSE;
+	}
+	for (int k = 0; k < cl_size; k++) {
+	    if (!valid_literal (*lits++, var_number)) {
+		return FALSE;
+	    }
+	}
+	left -= cl_size;
+    }
+    return left == 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_Learnt::SAT_Learnt (SAT_Mode &nmode) :
+    _mode(nmode), _values(0), _stats(SAT_LEARNT_MAX_STATS)
+{
+    _import_name = _export_name = NULL;
+    _has_key = FALSE;
+    _stat_number = 0;
+    _import_number = _export_number = 0;
+}
+
+SAT_Learnt::~SAT_Learnt()
+{
+    _values.resize (0);
+    _stats.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: init()
+//
+// Purpose: Keys the instance in the database, for exporting clauses later,
+//          and forgets the values and the counters imported before.
+//-----------------------------------------------------------------------------
+
+void SAT_Learnt::init (SAT_ClauseDatabase &clDB)
+{
+    SAT_Cache::instance_key (clDB, salt(), _key);
+    _has_key = TRUE;
+    int var_number = clDB.variables().size();
+    if (_values.size() < var_number) {
+	_values.resize (var_number);
+    }
+    for (int k = 0; k < var_number; k++) {
+	_values[k] = UNKNOWN;
+    }
+    _stat_number = 0;
+    _import_number = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: import_file()
+//
+// Purpose: Adds the learnt clauses of the file imported to the database,
+//          and makes the values of its variables the preferred values of
+//          the decision engine. Files of other instances are ignored.
+//
+// Side-effects: The instance is keyed by init(), even if no file is
+//               imported.
+//-----------------------------------------------------------------------------
+
+int SAT_Learnt::import_file (SAT_ClauseDatabase &clDB, DecisionEngine &decEng)
+{
+    init (clDB);
+    if (!_import_name) {
+	return NONE;
+    }
+    int fd = open (_import_name, O_RDONLY);
+    if (fd < 0) {
+	return NONE;
+    }
+    struct stat fstatus;
+    if (fstat (fd, &fstatus) < 0 ||
+	fstatus.st_size < (off_t) sizeof(SAT_LearntHeader)) {
+	close (fd);
+	return NONE;
+    }
+    unsigned long size = fstatus.st_size;
+    void *area = mmap (NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+    if (area == MAP_FAILED) {
+	return NONE;
+    }
+    int cl_number = read_file (clDB, decEng, (char*) area, size);
+    munmap (area, size);
+    return cl_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: read_file()
+//
+// Purpose: Imports the contents of a file mapped in memory. Returns the
+//          number of clauses imported, or NONE if the file is not valid.
+//
+// Notes: Imported clauses keep their LBD, hence are exported again if the
+//        bounds still hold.
+//-----------------------------------------------------------------------------
+
+int SAT_Learnt::read_file (SAT_ClauseDatabase &clDB, DecisionEngine &decEng,
+			   char *data, unsigned long size)
+{
+    SAT_LearntHeader *header = (SAT_LearntHeader*) data;
+    int var_number = clDB.variables().size();
+    if (!valid_file (header, size, _key, var_number)) {
+	return NONE;
+    }
+    Array<SAT_VariablePtr> variables (var_number);
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	if (var->ID() >= var_number) {
+	    return NONE;
+	}
+	variables[var->ID()] = var;
+    }
+    long *stats = (long*) (data + header->header_size);
+    for (int k = 0; k < header->stat_number; k++) {
+	_stats[k] = stats[k];
+    }
+    _stat_number = header->stat_number;
+    int *values = (int*) (stats + header->stat_number);
+    for (int k = 0; k < var_number; k++) {
+	_values[k] = values[k];
+	if (values[k] != UNKNOWN) {
+	    decEng.set_preferred_value (variables[k], values[k]);
+	}
+    }
+    int *lits = values + var_number;
+    for (int j = 0; j < header->cl_number; j++) {
+	int lbd = *lits++, cl_size = *lits++;
+	SAT_ClausePtr cl = clDB.add_clause();
+	for (int k = 0; k < cl_size; k++, lits++) {
+	    int vID = ((*lits > 0) ? *lits : -*lits) - 1;
+	    clDB.add_literal (cl, variables[vID], (*lits < 0));
+	}
+	cl->LBD() = lbd;
+    }
+    _import_number = header->cl_number;
+    return _import_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: export_file()
+//
+// Purpose: Writes the learnt clauses of the database within the bounds on
+//          LBD and size, and the values of the variables, to the file
+//          exported. Returns NONE if the file cannot be written.
+//
+// Notes: Nothing is written unless import_file() was invoked for the
+//        instance in the database.
+//-----------------------------------------------------------------------------
+
+int SAT_Learnt::export_file (SAT_ClauseDatabase &clDB)
+{
+    if (!_export_name || !_has_key) {
+	return NONE;
+    }
+    unsigned long size;
+    int cl_number;
+    char *data = build_file (clDB, size, cl_number);
+    if (!data) {
+	return NONE;
+    }
+    int ok = write_file (data, size);
+    delete[] data;
+    _export_number = (ok) ? cl_number : 0;
+    return (ok) ? cl_number : NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: build_file()
+//
+// Purpose: Returns the contents of the file exported, allocated with
+//          new[], or NULL if the database is not the instance imported.
+//
+// Notes: Variables assigned and exported as units, unless some unit clause
+//        exported already holds them, are written as clauses of LBD 1.
+//-----------------------------------------------------------------------------
+
+char *SAT_Learnt::build_file (SAT_ClauseDatabase &clDB, unsigned long &size,
+			      int &cl_number)
+{
+    SAT_LearntHeader header;
+    memset (&header, 0, sizeof(header));
+    memcpy (header.magic, SAT_LEARNT_MAGIC, sizeof(header.magic));
+    header.version = SAT_LEARNT_VERSION;
+    header.header_size = sizeof(header);
+    header.key[0] = _key[0];
+    header.key[1] = _key[1];
+    header.var_number = clDB.variables().size();
+    header.stat_number = _stat_number;
+    if (header.var_number > _values.size()) {
+	return NULL;
+    }
+    Array<int> units (header.var_number);
+    for (int k = 0; k < header.var_number; k++) {
+	units[k] = FALSE;
+    }
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	SAT_ClausePtr cl = (SAT_ClausePtr) pcl->data();
+	if (exported (cl)) {
+	    header.cl_number++;
+	    header.lit_number += cl->size();
+	    if (cl->size() == 1) {
+		units[cl->literals().first()->data()->variable()->ID()] = TRUE;
+	    }
+	}
+    }
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	if (var->ID() >= header.var_number) {
+	    return NULL;
+	}
+	if (!units[var->ID()] && exported_unit (var)) {
+	    units[var->ID()] = NONE;
+	    header.cl_number++;
+	    header.lit_number++;
+	}
+    }
+    header.file_size = header.header_size +
+	header.stat_number * sizeof(long) +
+	(header.var_number + 2 * (unsigned long) header.cl_number +
+	 header.lit_number) * sizeof(int);
+
+    char *data = new char[header.file_size];
+    long *stats = (long*) (data + header.header_size);
+    for (int k = 0; k < header.stat_number; k++) {
+	stats[k] = _stats[k];
+    }
+    int *values = (int*) (stats + header.stat_number);
+    int *lits = values + header.var_number;
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	values[var->ID()] = (var->value() != UNKNOWN) ?
+	    var->value() : _values[var->ID()];
+	if (units[var->ID()] == NONE) {
+	    *lits++ = 1;
+	    *lits++ = 1;
+	    *lits++ = (var->value()) ? var->ID() + 1 : -(var->ID() + 1);
+	}
+    }
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	SAT_ClausePtr cl = (SAT_ClausePtr) pcl->data();
+	if (exported (cl)) {
+	    *lits++ = cl->LBD();
+	    *lits++ = cl->size();
+	    for_each(plit, cl->literals(), LiteralPtr) {
+		int vID = plit->data()->variable()->ID() + 1;
+		*lits++ = (plit->data()->sign()) ? -vID : vID;
+	    }
+	}
+    }
+    unsigned int *words = (unsigned int*) stats;
+    unsigned long number = (header.file_size - header.header_size) / 4;
+    header.checksum = checksum_words (CHECKSUM_BASIS, words, number);
+    memcpy (data, &header, sizeof(header));
+    size = header.file_size;
+    cl_number = header.cl_number;
+    return data;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: write_file()
+//
+// Purpose: Writes the file exported. The file is replaced only once it is
+//          complete. Returns FALSE if the file cannot be written.
+//-----------------------------------------------------------------------------
+
+int SAT_Learnt::write_file (char *data, unsigned long size)
+{
+    char *tmp_name = new char[strlen (_export_name) + LEARNT_NAME_SIZE];
+    sprintf (tmp_name, "%s%s.%d", _export_name, LEARNT_TEMP_SUFFIX,
+	     (int) getpid());
+    int fd = open (tmp_name, O_WRONLY|O_CREAT|O_TRUNC, 0600);
+    int ok = (fd >= 0);
+    while (ok && size > 0) {
+	ssize_t count = write (fd, data, size);
+	if (count < 0 && errno == EINTR) {
+	    continue;
+	}
+	if (count <= 0) {
+	    ok = FALSE;
+	    break;
+	}
+	data += count;
+	size -= count;
+    }
+    if (fd >= 0) {
+	ok = (close (fd) == 0) && ok;
+    }
+    if (!ok || rename (tmp_name, _export_name) < 0) {
+	unlink (tmp_name);
+	ok = FALSE;
+    }
+    delete[] tmp_name;
+    return ok;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: exported()
+//
+// Purpose: Checks whether a clause is to be exported, ie whether it is a
+//          learnt clause kept by the database within the bounds on LBD and
+//          size.
+//-----------------------------------------------------------------------------
+
+int SAT_Learnt::exported (SAT_ClausePtr cl)
+{
+    return (cl->learnt() && !cl->test_tag (GRAY|BLACK) &&
+	    cl->LBD() <= _mode[_LEARNT_LBD_] &&
+	    cl->size() <= _mode[_LEARNT_SIZE_]);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: salt()
+//
+// Purpose: Returns the part of keys given by the version of files.
+//-----------------------------------------------------------------------------
+
+unsigned long SAT_Learnt::salt()
+{
+    return SAT_LEARNT_VERSION * SALT_PRIME + 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: output_stats()
+//
+// Purpose: Output information regarding imported and exported clauses.
+//-----------------------------------------------------------------------------
+
+void SAT_Learnt::output_stats()
+{
+    printItem ("Number of imported learnt clauses", _import_number);
+    printItem ("Number of exported learnt clauses", _export_number);
+    printItem();
+}
+
+/*****************************************************************************/
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+// File: grp_Learnt.hh
+//
+// Purpose: Class declaration of files of learnt clauses, which keep the
+//          learnt clauses of a run and the values last taken by the
+//          variables, such that a later run on the same instance, eg after
+//          exceeding the limits on conflicts or time, starts from them.
+//
+// Remarks: Files are keyed by the canonical key of the instance once
+//          variables are eliminated, hence the clauses of a file are only
+//          imported by runs of the same instance with the same options
+//          for elimination. Clauses learnt from an instance are implied by
+//          it, hence imported clauses never change its solutions.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - counters and units kept for checkpoints.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_LEARNT__
+#define __GRP_LEARNT__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_CDB.hh"
+#include "grp_Decide.hh"
+#include "grp_Cache.hh"                     // Only requires keys of instances
+
+
+//-----------------------------------------------------------------------------
+// Defines for files of learnt clauses.
+//-----------------------------------------------------------------------------
+
+# define SAT_LEARNT_MAGIC      "GRASPLRN"
+# define SAT_LEARNT_MAGIC_SIZE 8
+# define SAT_LEARNT_VERSION    1
+# define SAT_LEARNT_MAX_STATS  64                // Most counters in a file
+
+
+//-----------------------------------------------------------------------------
+// Header of a file, stored at offset 0. The header is followed by the
+// counters kept with the file, if any, by the values of the variables by
+// ID (0, 1 or UNKNOWN), and by the clauses, each given by its LBD, its size
+// and its literals. Literals are coded as +/-(ID+1), and the checksum
+// covers all but the header.
+//-----------------------------------------------------------------------------
+
+struct SAT_LearntHeader {
+    char magic[SAT_LEARNT_MAGIC_SIZE];          // Always SAT_LEARNT_MAGIC
+    int version;
+    int header_size;
+    SAT_CacheKey key;                           // Canonical key of instance
+    int var_number;
+    int cl_number;
+    int stat_number;                            // Counters, as longs
+    unsigned long lit_number;                   // Literals of all clauses
+    unsigned long file_size;
+    unsigned long checksum;
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Learnt
+//
+// Purpose: Imports the learnt clauses and the values of the variables of a
+//          file when the search starts, and exports them when it ends.
+//          Only clauses with LBD and size within _LEARNT_LBD_ and
+//          _LEARNT_SIZE_ are exported.
+//
+// Notes: Values of variables are imported as preferred values of the
+//        decision engine. Variables unassigned when exporting keep the
+//        values imported. The counters of a file are kept, and exported
+//        again, but are only used by derived classes.
+//-----------------------------------------------------------------------------
+
+class SAT_Learnt {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Learnt (SAT_Mode &nmode);
+    virtual ~SAT_Learnt();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. import_file() is invoked once variables are
+    // eliminated, or else init(), which only keys the instance. Then
+    // export_file() is invoked when the search is done, before the state
+    // of the variables is reset. Each returns the number of clauses
+    // imported or exported, or NONE if no file was read or written.
+    //-------------------------------------------------------------------------
+
+    inline void set_files (char *import_name, char *export_name) {
+	_import_name = import_name;
+	_export_name = export_name;
+    }
+    inline int enabled() { return _import_name || _export_name; }
+
+    virtual void init (SAT_ClauseDatabase &clDB);
+    virtual int import_file (SAT_ClauseDatabase &clDB,
+			     DecisionEngine &decEng);
+    virtual int export_file (SAT_ClauseDatabase &clDB);
+
+    virtual void output_stats();
+
+protected:
+    virtual int read_file (SAT_ClauseDatabase &clDB, DecisionEngine &decEng,
+			   char *data, unsigned long size);
+    virtual char *build_file (SAT_ClauseDatabase &clDB, unsigned long &size,
+			      int &cl_number);
+    virtual int write_file (char *data, unsigned long size);
+
+    virtual int exported (SAT_ClausePtr cl);
+    virtual int exported_unit (SAT_VariablePtr var) { return FALSE; }
+    unsigned long salt();
+
+    SAT_Mode &_mode;                                   // Configuration options
+
+    char *_import_name;                          // Files named, not owned
+    char *_export_name;
+
+    SAT_CacheKey _key;                           // Key of the instance
+    int _has_key;
+
+    Array<int> _values;                          // Values imported, by ID
+    Array<long> _stats;                          // Counters of the file
+    int _stat_number;
+    int _import_number;
+    int _export_number;
+
+};
+
+#endif // __GRP_LEARNT__
+
+/*****************************************************************************/
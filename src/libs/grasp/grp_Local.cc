@@ -0,0 +1,517 @@
+//-----------------------------------------------------------------------------
+// File: grp_Local.cc
+//
+// Purpose: Member functions of the local search engine.
+//
+// Remarks: Workers only access the copy of the clauses and their own
+//          assignments, and so they do not allocate objects from memory
+//          pools. Shared information is protected by a single mutex, which
+//          workers acquire every LOCAL_CHECK_FLIPS flips.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "grp_Local.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static void *local_thread (void *arg)
+{
+    LocalWorkerPtr worker = (LocalWorkerPtr) arg;
+    worker->engine()->run (worker);
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+LocalSearchEngine::LocalSearchEngine (SAT_Mode &nmode, FRE &nFRE) :
+_mode(nmode), _FRE(nFRE), _variables(0), _cl_start(0), _cl_lits(0),
+_occ_start(0), _occ_list(0), _break_prob(LOCAL_BREAK_LIMIT+1), _workers(0),
+_phases(0), _best(0), _model(0), _saved(0)
+{
+    int threads = (_mode[_LOCAL_THREADS_] > 1) ? _mode[_LOCAL_THREADS_] : 1;
+    _workers.resize (threads);
+    for (int k = 0; k < threads; k++) {
+	_workers[k] = new LocalWorker();
+	_workers[k]->engine() = this;
+	_workers[k]->seed() = k + 1;
+    }
+    double prob = 1.0;
+    for (int k = 0; k <= LOCAL_BREAK_LIMIT; k++) {
+	_break_prob[k] = prob;
+	prob /= LOCAL_BREAK_BASE;
+    }
+    pthread_mutex_init (&_lock, NULL);
+    _thread_number = 0;
+    _var_number = 0;
+    _cl_number = 0;
+    _phase_stamp = 0;
+    _best_unsat = 0;
+    _best_stamp = 0;
+    _import_stamp = 0;
+    _found = FALSE;
+    _stop = FALSE;
+    _conflict_count = 0;
+    _flip_number = 0.0;
+    _restart_number = 0;
+    _exchange_number = 0;
+    _import_number = 0;
+    _local_solutions = 0;
+}
+
+LocalSearchEngine::~LocalSearchEngine()
+{
+    stop();
+    for (int k = 0; k < _workers.size(); k++) {
+	delete _workers[k];
+    }
+    pthread_mutex_destroy (&_lock);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: init()
+//
+// Purpose: Prepares the engine for a new instance of SAT.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::init (SAT_ClauseDatabase &clDB)
+{
+    stop();
+    _conflict_count = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: clear()
+//
+// Purpose: Clears stats of the engine.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::clear (SAT_ClauseDatabase &clDB)
+{
+    _flip_number = 0.0;
+    _restart_number = 0;
+    _exchange_number = 0;
+    _import_number = 0;
+    _local_solutions = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: start()
+//
+// Purpose: Copies the clauses of the clause database and starts the
+//          workers. Local search starts from the variables assigned in the
+//          clause database, other variables being assigned randomly.
+//
+// Notes: Local search is not started if the database has an empty clause.
+//        If threads cannot be created, the search proceeds without local
+//        search.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::start (SAT_ClauseDatabase &clDB)
+{
+    stop();
+    _var_number = 0;
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	if (pvar->data()->ID() >= _var_number) {
+	    _var_number = pvar->data()->ID() + 1;
+	}
+    }
+    if (_var_number > _variables.size()) {       // Arrays are reused otherwise
+	_variables.resize (_var_number);
+	_phases.resize (_var_number);
+	_best.resize (_var_number);
+	_model.resize (_var_number);
+	_saved.resize (_var_number);
+    }
+    if (2*_var_number+1 > _occ_start.size()) {
+	_occ_start.resize (2*_var_number+1);
+    }
+    for (int k = 0; k < _var_number; k++) {
+	_variables[k] = NULL;
+	_saved[k] = NONE;
+    }
+    for (int k = 0; k <= 2*_var_number; k++) {
+	_occ_start[k] = 0;
+    }
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	_variables[var->ID()] = var;
+	if (var->value() != UNKNOWN) {
+	    _saved[var->ID()] = var->value();
+	}
+    }
+
+    // Copy clauses, and count occurrences of each literal.
+
+    _cl_number = clDB.clauses().size();
+    int lit_number = 0;
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	lit_number += pcl->data()->literals().size();
+    }
+    if (_cl_number+1 > _cl_start.size()) {
+	_cl_start.resize (_cl_number+1);
+    }
+    if (lit_number > _cl_lits.size()) {
+	_cl_lits.resize (lit_number);
+	_occ_list.resize (lit_number);
+    }
+    int cl_idx = 0, lit_idx = 0, max_size = 0, empty_cl = FALSE;
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	_cl_start[cl_idx++] = lit_idx;
+	for_each(plit, pcl->data()->literals(), LiteralPtr) {
+	    LiteralPtr lit = plit->data();
+	    int code = 2*lit->variable()->ID() + ((lit->sign()) ? 1 : 0);
+	    _cl_lits[lit_idx++] = code;
+	    _occ_start[code+1]++;
+	}
+	int size = pcl->data()->literals().size();
+	if (size > max_size) { max_size = size; }
+	if (!size) { empty_cl = TRUE; }
+    }
+    _cl_start[cl_idx] = lit_idx;
+    for (int k = 1; k <= 2*_var_number; k++) {
+	_occ_start[k] += _occ_start[k-1];
+    }
+    for (int k = 0; k < _cl_number; k++) {        // Fill lists, then shift back
+	for (int j = _cl_start[k]; j < _cl_start[k+1]; j++) {
+	    _occ_list[_occ_start[_cl_lits[j]]++] = k;
+	}
+    }
+    for (int k = 2*_var_number; k > 0; k--) {
+	_occ_start[k] = _occ_start[k-1];
+    }
+    _occ_start[0] = 0;
+
+    // Setup shared information and start the workers.
+
+    for (int k = 0; k < _var_number; k++) {
+	_phases[k] = _saved[k];
+    }
+    _phase_stamp = 1;
+    _best_unsat = _cl_number + 1;
+    _best_stamp = 0;
+    _import_stamp = 0;
+    _conflict_count = 0;
+    _found = FALSE;
+    _stop = FALSE;
+    if (!_var_number || empty_cl) {
+	return;
+    }
+    for (int k = 0; k < _workers.size(); k++) {
+	LocalWorkerPtr worker = _workers[k];
+	if (_var_number > worker->values().size()) {
+	    worker->values().resize (_var_number);
+	}
+	if (_cl_number > worker->true_count().size()) {
+	    worker->true_count().resize (_cl_number);
+	    worker->unsat().resize (_cl_number);
+	    worker->unsat_pos().resize (_cl_number);
+	}
+	if (max_size > worker->probs().size()) {
+	    worker->probs().resize (max_size);
+	}
+	if (pthread_create (&worker->thread(), NULL,
+			    local_thread, (void*) worker)) {
+	    break;
+	}
+	_thread_number++;
+    }
+    DBG1(cout<<"LOCAL SEARCH STARTED WITH "<<_thread_number;
+	 cout<<" THREADS"<<endl;);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: stop()
+//
+// Purpose: Stops the workers, if any, and waits for them to finish.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::stop()
+{
+    if (!_thread_number) {
+	return;
+    }
+    pthread_mutex_lock (&_lock);
+    _stop = TRUE;
+    pthread_mutex_unlock (&_lock);
+    for (int k = 0; k < _thread_number; k++) {
+	pthread_join (_workers[k]->thread(), NULL);
+    }
+    _thread_number = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: solution_found()
+//
+// Purpose: Returns TRUE if a worker found a solution.
+//-----------------------------------------------------------------------------
+
+int LocalSearchEngine::solution_found()
+{
+    pthread_mutex_lock (&_lock);
+    int found = _found;
+    pthread_mutex_unlock (&_lock);
+    return found;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: exchange()
+//
+// Purpose: Invoked by the search process on each conflict. Saves the
+//          phases of assigned variables, and every LOCAL_EXCHANGE_INTERVAL
+//          conflicts publishes them to the workers and imports the best
+//          assignment of local search as preferred values.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::exchange (SAT_ClauseDatabase &clDB,
+				  DecisionEngine &decEng)
+{
+    if (!_thread_number) {
+	return;
+    }
+    for (int k = 0; k < _var_number; k++) {
+	SAT_VariablePtr var = _variables[k];
+	if (var && var->value() != UNKNOWN) {
+	    _saved[k] = var->value();
+	}
+    }
+    if (++_conflict_count < LOCAL_EXCHANGE_INTERVAL) {
+	return;
+    }
+    _conflict_count = 0;
+    _exchange_number++;
+
+    pthread_mutex_lock (&_lock);
+    for (int k = 0; k < _var_number; k++) {
+	_phases[k] = _saved[k];
+    }
+    _phase_stamp++;
+    if (_best_stamp != _import_stamp) {
+	for (int k = 0; k < _var_number; k++) {
+	    if (_variables[k]) {
+		decEng.set_preferred_value (_variables[k], _best[k]);
+	    }
+	}
+	_import_stamp = _best_stamp;
+	_import_number++;
+    }
+    pthread_mutex_unlock (&_lock);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: assign_solution()
+//
+// Purpose: Assigns unassigned variables the values in the solution found
+//          by local search, after the search has been restored to decision
+//          level 0.
+//
+// Side-effects: Variables are assigned at decision level 0. Since the
+//               solution satisfies the clauses (and so the clauses
+//               recorded by the search process) no conflict can arise.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::assign_solution (SAT_ClauseDatabase &clDB)
+{
+    stop();
+    for (int k = 0; k < _var_number; k++) {
+	SAT_VariablePtr var = _variables[k];
+	if (var && var->value() == UNKNOWN) {
+	    clDB.set_implied_variable (var, _model[k], 0, NULL);
+	    if (_FRE.BCP (clDB) == CONFLICT) {
+		Warn("Conflict while assigning solution of local search?");
+	    }
+	}
+    }
+    _local_solutions++;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: run()
+//
+// Purpose: Flips variables until a solution is found or the workers are
+//          stopped. Every LOCAL_CHECK_FLIPS flips the worker publishes its
+//          assignment, if better than the best one, and restarts from the
+//          phases of the search process, if new phases are available.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::run (LocalWorkerPtr worker)
+{
+    restart (worker);
+    int done = FALSE;
+    while (!done) {
+	int flips = 0;
+	for (; flips < LOCAL_CHECK_FLIPS && worker->unsat_number(); flips++) {
+	    flip (worker, pick_variable (worker));
+	}
+	if (worker->run_flips() < LOCAL_RESTART_FLIPS) {
+	    worker->run_flips() += flips;
+	}
+	pthread_mutex_lock (&_lock);
+	_flip_number += flips;
+	if (!worker->unsat_number()) {
+	    if (!_found) {
+		for (int k = 0; k < _var_number; k++) {
+		    _model[k] = worker->values()[k];
+		}
+		_found = TRUE;
+	    }
+	    _stop = TRUE;
+	}
+	else if (worker->unsat_number() < _best_unsat) {
+	    for (int k = 0; k < _var_number; k++) {
+		_best[k] = worker->values()[k];
+	    }
+	    _best_unsat = worker->unsat_number();
+	    _best_stamp++;
+	}
+	done = _stop;
+	int must_restart = (worker->phase_stamp() != _phase_stamp &&
+			    worker->run_flips() >= LOCAL_RESTART_FLIPS);
+	pthread_mutex_unlock (&_lock);
+
+	if (!done && must_restart) {
+	    restart (worker);
+	}
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: restart()
+//
+// Purpose: Sets the assignment of a worker to the published phases, and
+//          computes the unsatisfied clauses.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::restart (LocalWorkerPtr worker)
+{
+    Array<int> &values = worker->values();
+    pthread_mutex_lock (&_lock);
+    for (int k = 0; k < _var_number; k++) {
+	values[k] = (_phases[k] != NONE) ?
+	    _phases[k] : ((rand_r (&worker->seed()) >> 4) & 1);
+    }
+    worker->phase_stamp() = _phase_stamp;
+    _restart_number++;
+    pthread_mutex_unlock (&_lock);
+
+    worker->unsat_number() = 0;
+    worker->run_flips() = 0;
+    for (int k = 0; k < _cl_number; k++) {
+	int count = 0;
+	for (int j = _cl_start[k]; j < _cl_start[k+1]; j++) {
+	    int code = _cl_lits[j];
+	    if (values[code >> 1] != (code & 1)) { count++; }
+	}
+	worker->true_count()[k] = count;
+	if (!count) {
+	    worker->unsat_pos()[k] = worker->unsat_number();
+	    worker->unsat()[worker->unsat_number()++] = k;
+	}
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: pick_variable()
+//
+// Purpose: Picks a variable of a random unsatisfied clause, with
+//          probability decreasing exponentially with its break value.
+//-----------------------------------------------------------------------------
+
+int LocalSearchEngine::pick_variable (LocalWorkerPtr worker)
+{
+    int cl = worker->unsat()[rand_r (&worker->seed()) %
+			     worker->unsat_number()];
+    int start = _cl_start[cl];
+    int size = _cl_start[cl+1] - start;
+    Array<double> &probs = worker->probs();
+
+    double sum = 0.0;
+    for (int j = 0; j < size; j++) {
+	int count = break_count (worker, _cl_lits[start+j] >> 1);
+	probs[j] = _break_prob[(count < LOCAL_BREAK_LIMIT) ?
+			       count : LOCAL_BREAK_LIMIT];
+	sum += probs[j];
+    }
+    double pick = sum * (rand_r (&worker->seed()) / (RAND_MAX + 1.0));
+    for (int j = 0; j < size-1; j++) {
+	pick -= probs[j];
+	if (pick < 0.0) {
+	    return _cl_lits[start+j] >> 1;
+	}
+    }
+    return _cl_lits[start+size-1] >> 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: flip()
+//
+// Purpose: Flips the value of a variable, and updates the unsatisfied
+//          clauses.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::flip (LocalWorkerPtr worker, int vID)
+{
+    Array<int> &true_count = worker->true_count();
+    Array<int> &unsat = worker->unsat();
+    Array<int> &unsat_pos = worker->unsat_pos();
+
+    int old_code = 2*vID + (1 - worker->values()[vID]);   // Now true literal
+    int new_code = old_code ^ 1;
+    worker->values()[vID] = 1 - worker->values()[vID];
+
+    for (int k = _occ_start[old_code]; k < _occ_start[old_code+1]; k++) {
+	int cl = _occ_list[k];
+	if (--true_count[cl] == 0) {
+	    unsat_pos[cl] = worker->unsat_number();
+	    unsat[worker->unsat_number()++] = cl;
+	}
+    }
+    for (int k = _occ_start[new_code]; k < _occ_start[new_code+1]; k++) {
+	int cl = _occ_list[k];
+	if (true_count[cl]++ == 0) {
+	    int last = unsat[--worker->unsat_number()];
+	    unsat[unsat_pos[cl]] = last;
+	    unsat_pos[last] = unsat_pos[cl];
+	}
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: output_stats()
+//
+// Purpose: Output information regarding local search.
+//-----------------------------------------------------------------------------
+
+void LocalSearchEngine::output_stats (SAT_ClauseDatabase &clDB)
+{
+    printItem ("Number of local search flips", _flip_number);
+    printItem ("Number of local search restarts", _restart_number);
+    printItem ("Number of phase exchanges", _exchange_number);
+    printItem ("Number of imported assignments", _import_number);
+    printItem ("Number of solutions of local search", _local_solutions);
+    printItem();
+}
+
+/*****************************************************************************/
@@ -0,0 +1,200 @@
+//-----------------------------------------------------------------------------
+// File: grp_Local.hh
+//
+// Purpose: Declaration of class LocalSearchEngine, which runs stochastic
+//          local search (ProbSAT) in threads, concurrently with the search
+//          process of GRASP_SAT.
+//
+// Remarks: Local search works on a copy of the clauses, taken when the
+//          search starts. Periodically, the search process publishes its
+//          phases (ie the values of variables on conflicts), from which
+//          local search restarts, and imports the best assignment found by
+//          local search as preferred values of decision variables. The first
+//          solution found by either side ends the search.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_LOCAL__
+#define __GRP_LOCAL__
+
+#include <pthread.h>
+
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_CDB.hh"
+#include "grp_FRE.hh"
+#include "grp_Decide.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for local search.
+//-----------------------------------------------------------------------------
+
+# define LOCAL_EXCHANGE_INTERVAL 256    // Conflicts between exchanges
+# define LOCAL_RESTART_FLIPS     100000 // Min flips before restarting
+# define LOCAL_CHECK_FLIPS       1024   // Flips between checks by workers
+# define LOCAL_BREAK_BASE        2.5    // Probability of break b is base^-b
+# define LOCAL_BREAK_LIMIT       32
+
+
+//-----------------------------------------------------------------------------
+// Class names and typedefs used by the local search engine.
+//-----------------------------------------------------------------------------
+
+class LocalWorker;
+class LocalSearchEngine;
+
+typedef LocalWorker *LocalWorkerPtr;
+
+
+//-----------------------------------------------------------------------------
+// Class: LocalWorker
+//
+// Purpose: Thread of the local search engine, with its own assignment.
+//-----------------------------------------------------------------------------
+
+class LocalWorker {
+  public:
+    LocalWorker() : _values(0), _true_count(0), _unsat(0), _unsat_pos(0),
+    _probs(0) { _engine = NULL; _seed = 0; _unsat_number = 0;
+		_run_flips = 0; _phase_stamp = 0; }
+    virtual ~LocalWorker() {}
+
+    inline LocalSearchEngine *&engine() { return _engine; }
+    inline unsigned int &seed() { return _seed; }
+    inline Array<int> &values() { return _values; }
+    inline Array<int> &true_count() { return _true_count; }
+    inline Array<int> &unsat() { return _unsat; }
+    inline Array<int> &unsat_pos() { return _unsat_pos; }
+    inline Array<double> &probs() { return _probs; }
+    inline int &unsat_number() { return _unsat_number; }
+    inline int &run_flips() { return _run_flips; }
+    inline int &phase_stamp() { return _phase_stamp; }
+    inline pthread_t &thread() { return _thread; }
+
+  protected:
+    LocalSearchEngine *_engine;
+    unsigned int _seed;                           // Seed for rand_r()
+    Array<int> _values;                           // Assignment to variables
+    Array<int> _true_count;                       // True literals of clauses
+    Array<int> _unsat;                            // Unsatisfied clauses
+    Array<int> _unsat_pos;                        // Position in _unsat
+    Array<double> _probs;                         // Probabilities of flips
+    int _unsat_number;
+    int _run_flips;                               // Flips since restart
+    int _phase_stamp;                             // Stamp of phases used
+    pthread_t _thread;
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: LocalSearchEngine
+//
+// Purpose: Stochastic local search, run by threads alongside the search
+//          process. Literals are coded as 2*ID+sign.
+//
+// Notes: Except for the functions run by workers, member functions are
+//        invoked by the thread of the search process.
+//-----------------------------------------------------------------------------
+
+class LocalSearchEngine {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    LocalSearchEngine (SAT_Mode &nmode, FRE &nFRE);
+    virtual ~LocalSearchEngine();
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    virtual void init (SAT_ClauseDatabase &clDB);
+    virtual void clear (SAT_ClauseDatabase &clDB);
+    virtual void reset (SAT_ClauseDatabase &clDB) { stop(); }
+
+    virtual void start (SAT_ClauseDatabase &clDB);       // Copy clauses, run
+    virtual void stop();                                   // Join the workers
+
+    virtual int solution_found();
+    virtual void exchange (SAT_ClauseDatabase &clDB, DecisionEngine &decEng);
+    virtual void assign_solution (SAT_ClauseDatabase &clDB);
+
+    virtual void output_stats (SAT_ClauseDatabase &clDB);
+
+    //-------------------------------------------------------------------------
+    // Function executed by each worker.
+    //-------------------------------------------------------------------------
+
+    virtual void run (LocalWorkerPtr worker);
+
+  protected:
+
+    //-------------------------------------------------------------------------
+    // Internal member functions for local search.
+    //-------------------------------------------------------------------------
+
+    virtual void restart (LocalWorkerPtr worker);
+    virtual void flip (LocalWorkerPtr worker, int vID);
+    virtual int pick_variable (LocalWorkerPtr worker);
+
+    inline int break_count (LocalWorkerPtr worker, int vID) {
+	int code = 2*vID + (1 - worker->values()[vID]);  // Literal now true
+	int count = 0;
+	for (int k = _occ_start[code]; k < _occ_start[code+1]; k++) {
+	    if (worker->true_count()[_occ_list[k]] == 1) { count++; }
+	}
+	return count;
+    }
+
+    //-------------------------------------------------------------------------
+    // Internal variable definition.
+    //-------------------------------------------------------------------------
+
+    SAT_Mode &_mode;                                   // Configuration options
+    FRE &_FRE;                 // Implementor of Boolean Constraint Propagation
+
+    Array<SAT_VariablePtr> _variables;                    // ID to variables
+    int _var_number;
+    int _cl_number;
+
+    Array<int> _cl_start;                  // Start of each clause in _cl_lits
+    Array<int> _cl_lits;                            // Literals of the clauses
+    Array<int> _occ_start;             // Start of each literal in _occ_list
+    Array<int> _occ_list;                     // Clauses in which lits occur
+    Array<double> _break_prob;                  // Probability of each break
+
+    Array<LocalWorkerPtr> _workers;
+    int _thread_number;                          // Number of threads running
+
+    pthread_mutex_t _lock;               // Protects the variables that follow
+    Array<int> _phases;                     // Phases published by the search
+    int _phase_stamp;
+    Array<int> _best;                   // Best assignment of local search
+    int _best_unsat;
+    int _best_stamp;
+    Array<int> _model;                          // Solution of local search
+    int _found;
+    int _stop;
+
+    Array<int> _saved;                    // Phases saved by the search process
+    int _import_stamp;
+    int _conflict_count;
+
+  protected:                                   // Variables for stats gathering
+    double _flip_number;
+    int _restart_number;
+    int _exchange_number;
+    int _import_number;
+    int _local_solutions;
+
+  private:
+
+};
+
+#endif // __GRP_LOCAL__
+
+/*****************************************************************************/
@@ -0,0 +1,473 @@
+//-----------------------------------------------------------------------------
+// File: grp_MaxSAT.cc
+//
+// Purpose: Member functions of the core-guided MaxSAT engine of GRASP.
+//
+// Remarks: Totalizers encode only that their outputs are implied by their
+//          inputs, which is the direction required by the bounds assumed,
+//          ie by negative outputs.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - limits set on each call of the solver.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "grp_MaxSAT.hh"
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_MaxSAT::SAT_MaxSAT (SAT_Mode &nmode) : _mode(nmode), _solver(),
+    _soft_lits(0), _soft_weights(0), _rec_lits(0), _rec_weights(0),
+    _rec_cards(0), _rec_bounds(0), _lit_recs(0), _cards(0),
+    _card_weights(0), _card_bounds(0), _core(0), _model(0)
+{
+    _solver.set_options (nmode);
+    _var_number = _top_var = 0;
+    _soft_lit_number = _soft_number = 0;
+    _base_cost = 0;
+    _rec_number = _card_number = 0;
+    _lower_bound = 0;
+    _upper_bound = NONE;
+    _stratum = 0;
+    _core_number = 0;
+    _relaxed = FALSE;
+    _report = NULL;
+    _report_state = NULL;
+}
+
+SAT_MaxSAT::~SAT_MaxSAT()
+{
+    for (int k = 0; k < _card_number; k++) {
+	delete _cards[k];
+    }
+    _soft_lits.resize (0);
+    _soft_weights.resize (0);
+    _rec_lits.resize (0);
+    _rec_weights.resize (0);
+    _rec_cards.resize (0);
+    _rec_bounds.resize (0);
+    _lit_recs.resize (0);
+    _cards.resize (0);
+    _card_weights.resize (0);
+    _card_bounds.resize (0);
+    _core.resize (0);
+    _model.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_hard()
+//
+// Purpose: Adds a hard clause, ie a clause of the incremental solver.
+//-----------------------------------------------------------------------------
+
+void SAT_MaxSAT::add_hard (int *lits, int size)
+{
+    for (int k = 0; k < size; k++) {
+	int idx = (lits[k] > 0) ? lits[k] : -lits[k];
+	if (idx > _var_number) {
+	    _var_number = idx;
+	}
+	_solver.add (lits[k]);
+    }
+    _solver.add (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_soft()
+//
+// Purpose: Adds a soft clause, kept until solve() relaxes it. Empty soft
+//          clauses are always falsified, hence only add to the cost.
+//-----------------------------------------------------------------------------
+
+void SAT_MaxSAT::add_soft (long weight, int *lits, int size)
+{
+    if (weight <= 0) {
+	return;
+    }
+    else if (!size) {
+	_base_cost += weight;
+	_lower_bound += weight;
+	return;
+    }
+    if (_soft_lit_number + size + 1 > _soft_lits.size()) {
+	int lit_size = 2*_soft_lits.size() + size + 1;
+	_soft_lits.resize (lit_size);
+    }
+    for (int k = 0; k < size; k++) {
+	int idx = (lits[k] > 0) ? lits[k] : -lits[k];
+	if (idx > _var_number) {
+	    _var_number = idx;
+	}
+	_soft_lits[_soft_lit_number++] = lits[k];
+    }
+    _soft_lits[_soft_lit_number++] = 0;
+    if (_soft_number >= _soft_weights.size()) {
+	_soft_weights.resize ((_soft_number) ? 2*_soft_number : 16);
+    }
+    _soft_weights[_soft_number++] = weight;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: solve()
+//
+// Purpose: Minimizes the weight of the soft clauses falsified.
+//
+// Side-effects: Each better solution found is reported, and is kept. The
+//               incremental solver keeps the clauses of the relaxation.
+//
+// Notes: Records of weight below the stratum are not assumed. Once the
+//        records assumed are satisfiable, the stratum is lowered to the
+//        next weight of records. The solution found once all records are
+//        assumed is optimal, since its cost is at most the lower bound.
+//-----------------------------------------------------------------------------
+
+int SAT_MaxSAT::solve()
+{
+    if (!_relaxed) {
+	relax();
+    }
+    _solver.start_limits();
+
+    for (;;) {
+	if (_upper_bound != NONE && _lower_bound >= _upper_bound) {
+	    return SATISFIABLE;
+	}
+	if (!_solver.set_limits (_mode)) {
+	    return ABORTED;
+	}
+	for (int r = 0; r < _rec_number; r++) {
+	    if (_rec_weights[r] > 0 && _rec_weights[r] >= _stratum) {
+		_solver.assume (_rec_lits[r]);
+	    }
+	}
+	int outcome = _solver.solve();
+
+	if (outcome == ABORTED) {
+	    return ABORTED;
+	}
+	else if (outcome == SATISFIABLE) {
+	    update_model();
+	    if (!(_stratum = next_stratum())) {
+		return SATISFIABLE;                      // All records assumed
+	    }
+	}
+	else if (!_solver.core_size()) {
+	    return UNSATISFIABLE;                          // Hard clauses only
+	}
+	else {
+	    process_core();
+	}
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: value()
+//
+// Purpose: Returns the value of a literal in the best solution found, or
+//          UNKNOWN if none was found, or its variable was not assigned.
+//-----------------------------------------------------------------------------
+
+int SAT_MaxSAT::value (int lit)
+{
+    int idx = (lit > 0) ? lit : -lit;
+    if (_upper_bound == NONE || idx > _var_number || _model[idx] == UNKNOWN) {
+	return UNKNOWN;
+    }
+    return (lit > 0) ? _model[idx] : !_model[idx];
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: relax()
+//
+// Purpose: Gives each soft clause its assumption literal, and creates the
+//          record of each literal. Soft clauses with the same literal
+//          share its record.
+//-----------------------------------------------------------------------------
+
+void SAT_MaxSAT::relax()
+{
+    _top_var = _var_number;
+    int pos = 0;
+    for (int k = 0; k < _soft_number; k++) {
+	int *lits = &_soft_lits[pos];
+	int size = 0;
+	while (lits[size]) { size++; }
+	pos += size + 1;
+
+	int lit = lits[0];
+	if (size > 1) {                          // New variable implies clause
+	    lit = new_variable();
+	    for (int j = 0; j < size; j++) {
+		_solver.add (lits[j]);
+	    }
+	    _solver.add (-lit);
+	    _solver.add (0);
+	}
+	int r = record (lit);
+	if (r != NONE) {
+	    _rec_weights[r] += _soft_weights[k];
+	}
+	else {
+	    r = add_record (lit, _soft_weights[k], NONE, 0);
+	}
+	if (_rec_weights[r] > _stratum) {
+	    _stratum = _rec_weights[r];
+	}
+    }
+    _relaxed = TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: process_core()
+//
+// Purpose: Raises the lower bound by the least weight of the records of
+//          the core, which is taken from each one, and relaxes the core.
+//
+// Side-effects: Small cores are first minimized. A totalizer is created
+//               for the core, and the bound of the totalizer of each of
+//               its outputs in the core is relaxed.
+//
+// Notes: A core of one record is implied false, and becomes a unit clause.
+//-----------------------------------------------------------------------------
+
+void SAT_MaxSAT::process_core()
+{
+    int size = _solver.core_size();
+    if (size > 1 && size <= MAXSAT_MIN_CORE && _solver.set_limits (_mode)) {
+	_solver.set_conflict_limit (MAXSAT_MIN_CONFLICTS);
+	size = _solver.minimize_core();
+    }
+    if (_core.size() < size) {
+	_core.resize (size);
+    }
+    long weight = NONE;
+    for (int k = 0; k < size; k++) {
+	_core[k] = _solver.core_literal (k);
+	int r = record (_core[k]);
+	if (weight == NONE || _rec_weights[r] < weight) {
+	    weight = _rec_weights[r];
+	}
+    }
+    _lower_bound += weight;
+    _core_number++;
+
+    for (int k = 0; k < size; k++) {
+	int r = record (_core[k]);
+	_rec_weights[r] -= weight;
+	int c = _rec_cards[r];
+	if (c != NONE && _rec_bounds[r] == _card_bounds[c] &&
+	    _card_bounds[c] < _cards[c]->size()) {      // Allow one more input
+	    int bound = ++_card_bounds[c];
+	    extend_totalizer (_cards[c], bound);
+	    add_record (-_cards[c]->outputs()[bound-1], _card_weights[c],
+			c, bound);
+	}
+	_core[k] = -_core[k];                         // Input of the totalizer
+    }
+    if (size == 1) {
+	_solver.add (_core[0]);
+	_solver.add (0);
+	return;
+    }
+    if (_card_number >= _cards.size()) {
+	int card_size = (_card_number) ? 2*_card_number : 16;
+	_cards.resize (card_size);
+	_card_weights.resize (card_size);
+	_card_bounds.resize (card_size);
+    }
+    int c = _card_number++;
+    _cards[c] = new_totalizer (&_core[0], size);
+    _card_weights[c] = weight;
+    _card_bounds[c] = 2;
+    extend_totalizer (_cards[c], 2);                       // At most one input
+    add_record (-_cards[c]->outputs()[1], weight, c, 2);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: update_model()
+//
+// Purpose: Evaluates the cost of the solution found by the incremental
+//          solver, which is kept and reported if better.
+//-----------------------------------------------------------------------------
+
+void SAT_MaxSAT::update_model()
+{
+    long cost = _base_cost;
+    int pos = 0;
+    for (int k = 0; k < _soft_number; k++) {
+	int satisfied = FALSE;
+	for (; _soft_lits[pos]; pos++) {
+	    if (_solver.value (_soft_lits[pos]) == TRUE) {
+		satisfied = TRUE;
+	    }
+	}
+	pos++;
+	if (!satisfied) {
+	    cost += _soft_weights[k];
+	}
+    }
+    if (_upper_bound != NONE && cost >= _upper_bound) {
+	return;
+    }
+    _upper_bound = cost;
+    if (_model.size() <= _var_number) {
+	_model.resize (_var_number + 1);
+    }
+    for (int k = 1; k <= _var_number; k++) {
+	_model[k] = _solver.value (k);
+    }
+    if (_report) {
+	_report (_report_state, cost);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: next_stratum()
+//
+// Purpose: Returns the largest weight of records below the stratum, or 0
+//          if there are none.
+//-----------------------------------------------------------------------------
+
+long SAT_MaxSAT::next_stratum()
+{
+    long stratum = 0;
+    for (int r = 0; r < _rec_number; r++) {
+	if (_rec_weights[r] < _stratum && _rec_weights[r] > stratum) {
+	    stratum = _rec_weights[r];
+	}
+    }
+    return stratum;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: new_variable()
+//
+// Purpose: Returns the index of a new variable, after those of clauses.
+//-----------------------------------------------------------------------------
+
+int SAT_MaxSAT::new_variable()
+{
+    return ++_top_var;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_record()
+//
+// Purpose: Creates the record of an assumption literal, and returns it.
+//-----------------------------------------------------------------------------
+
+int SAT_MaxSAT::add_record (int lit, long weight, int card, int bound)
+{
+    if (_rec_number >= _rec_lits.size()) {
+	int rec_size = (_rec_number) ? 2*_rec_number : 16;
+	_rec_lits.resize (rec_size);
+	_rec_weights.resize (rec_size);
+	_rec_cards.resize (rec_size);
+	_rec_bounds.resize (rec_size);
+    }
+    int code = 2*((lit > 0) ? lit : -lit) + (lit < 0);
+    if (code >= _lit_recs.size()) {
+	int size = _lit_recs.size();
+	_lit_recs.resize ((code < 2*size) ? 2*size : code + 2);
+	for (int k = size; k < _lit_recs.size(); k++) {
+	    _lit_recs[k] = NONE;
+	}
+    }
+    int r = _rec_number++;
+    _rec_lits[r] = lit;
+    _rec_weights[r] = weight;
+    _rec_cards[r] = card;
+    _rec_bounds[r] = bound;
+    _lit_recs[code] = r;
+    return r;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: record()
+//
+// Purpose: Returns the record of an assumption literal, or NONE.
+//-----------------------------------------------------------------------------
+
+int SAT_MaxSAT::record (int lit)
+{
+    int code = 2*((lit > 0) ? lit : -lit) + (lit < 0);
+    return (code < _lit_recs.size()) ? _lit_recs[code] : NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: new_totalizer()
+//
+// Purpose: Creates a balanced totalizer over some literals, with no
+//          outputs encoded.
+//-----------------------------------------------------------------------------
+
+SAT_CardNodePtr SAT_MaxSAT::new_totalizer (int *lits, int size)
+{
+    if (size == 1) {
+	return new SAT_CardNode (lits[0]);
+    }
+    int half = size / 2;
+    return new SAT_CardNode (new_totalizer (lits, half),
+			     new_totalizer (lits + half, size - half));
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: extend_totalizer()
+//
+// Purpose: Encodes the outputs of a node up to a bound, after those of its
+//          children. Output s is implied by outputs i and j of the
+//          children, for all i+j = s, where outputs 0 always hold.
+//
+// Side-effects: New variables and clauses are added.
+//-----------------------------------------------------------------------------
+
+void SAT_MaxSAT::extend_totalizer (SAT_CardNodePtr node, int bound)
+{
+    if (bound > node->size()) {
+	bound = node->size();
+    }
+    if (!node->left() || bound <= node->bound()) {
+	return;
+    }
+    SAT_CardNodePtr left = node->left(), right = node->right();
+    extend_totalizer (left, bound);
+    extend_totalizer (right, bound);
+
+    Array<int> &outs = node->outputs();
+    outs.resize (bound);
+    for (int s = node->bound() + 1; s <= bound; s++) {
+	outs[s-1] = new_variable();
+	for (int i = 0; i <= s && i <= left->size(); i++) {
+	    int j = s - i;
+	    if (j > right->size()) {
+		continue;
+	    }
+	    if (i) { _solver.add (-left->outputs()[i-1]); }
+	    if (j) { _solver.add (-right->outputs()[j-1]); }
+	    _solver.add (outs[s-1]);
+	    _solver.add (0);
+	}
+    }
+    node->bound() = bound;
+}
+
+/*****************************************************************************/
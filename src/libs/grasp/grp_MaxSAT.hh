@@ -0,0 +1,185 @@
+//-----------------------------------------------------------------------------
+// File: grp_MaxSAT.hh
+//
+// Purpose: Class declaration of the core-guided MaxSAT engine of GRASP,
+//          which solves weighted partial MaxSAT instances with the OLL
+//          algorithm, on one incremental solver (see grp_Incr.hh).
+//
+// Remarks: Each soft clause is given an assumption literal, which is
+//          true only if the clause is satisfied, ie the literal of a unit
+//          clause, or else a new variable that implies the clause. Each
+//          core found by assuming these literals raises the lower bound by
+//          its least weight, and is relaxed by a totalizer, whose outputs
+//          count the literals of the core that are false. The outputs are
+//          encoded as bounds on these counts are assumed, ie a totalizer
+//          only grows as its bound is relaxed. Soft clauses are assumed by
+//          strata of decreasing weights, and each model found gives an
+//          upper bound, hence the engine reports solutions as it goes.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - limits set on each call of the solver.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_MAXSAT__
+#define __GRP_MAXSAT__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_Mode.hh"
+#include "grp_Incr.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for the MaxSAT engine.
+//-----------------------------------------------------------------------------
+
+# define MAXSAT_MIN_CORE       32               // Largest core to be minimized
+# define MAXSAT_MIN_CONFLICTS  1000        // Conflicts of each minimizing call
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_CardNode
+//
+// Purpose: Node of a totalizer. Output j of a node, ie outputs()[j-1], is
+//          implied by j of the inputs below the node being true. Leaves
+//          are the inputs themselves.
+//-----------------------------------------------------------------------------
+
+class SAT_CardNode {
+
+public:
+    SAT_CardNode (int lit) : _outs(1) {                            // Leaf node
+	_left = _right = NULL;
+	_size = _bound = 1;
+	_outs[0] = lit;
+    }
+    SAT_CardNode (SAT_CardNode *nleft, SAT_CardNode *nright) : _outs(0) {
+	_left = nleft; _right = nright;
+	_size = nleft->_size + nright->_size;
+	_bound = 0;
+    }
+    virtual ~SAT_CardNode() {
+	if (_left) { delete _left; }
+	if (_right) { delete _right; }
+    }
+
+    inline SAT_CardNode *left() { return _left; }
+    inline SAT_CardNode *right() { return _right; }
+    inline int size() { return _size; }                         // Inputs below
+    inline int &bound() { return _bound; }                   // Outputs encoded
+    inline Array<int> &outputs() { return _outs; }
+
+protected:
+    SAT_CardNode *_left;
+    SAT_CardNode *_right;
+    int _size;
+    int _bound;
+    Array<int> _outs;
+
+};
+
+typedef SAT_CardNode *SAT_CardNodePtr;
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_MaxSAT
+//
+// Purpose: Keeps the hard and soft clauses given with DIMACS literals, and
+//          minimizes the weight of the soft clauses falsified.
+//
+// Notes: All clauses must be given before solve(), since new variables
+//        are numbered after those of the clauses. Options are those of the
+//        mode given, whose limits apply to the whole optimization, ie all
+//        the calls of the incremental solver, whose search is aborted
+//        through its termination callback once time limits expire. Small
+//        cores are minimized, within few conflicts for each call.
+//-----------------------------------------------------------------------------
+
+class SAT_MaxSAT {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_MaxSAT (SAT_Mode &nmode);
+    virtual ~SAT_MaxSAT();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. solve() returns SATISFIABLE once the best
+    // solution found is optimal, UNSATISFIABLE if the hard clauses are,
+    // and ABORTED otherwise. The best solution found, if any, has cost()
+    // and gives value() to literals. The callback given by set_report() is
+    // invoked for each better solution found.
+    //-------------------------------------------------------------------------
+
+    virtual void add_hard (int *lits, int size);
+    virtual void add_soft (long weight, int *lits, int size);
+    virtual int solve();
+
+    inline long cost() { return _upper_bound; }             // NONE if no model
+    inline long lower_bound() { return _lower_bound; }
+    virtual int value (int lit);
+    inline int variable_number() { return _var_number; }
+    inline int soft_number() { return _soft_number; }
+    inline int core_number() { return _core_number; }
+
+    inline void set_report (void *state, void (*report)(void *state,
+							 long cost)) {
+	_report_state = state;
+	_report = report;
+    }
+    inline SAT_Governor &governor() { return _solver.governor(); }
+
+protected:
+    virtual void relax();
+    virtual void process_core();
+    virtual void update_model();
+    long next_stratum();
+
+    int new_variable();
+    int add_record (int lit, long weight, int card, int bound);
+    int record (int lit);
+    SAT_CardNodePtr new_totalizer (int *lits, int size);
+    void extend_totalizer (SAT_CardNodePtr node, int bound);
+
+    SAT_Mode &_mode;                        // Options and limits of the engine
+    SAT_Incremental _solver;
+    int _var_number;                              // Variables of clauses given
+    int _top_var;                              // Including those of the engine
+
+    Array<int> _soft_lits;                    // Literals of soft clauses, each
+    int _soft_lit_number;                                  // clause ended by 0
+    Array<long> _soft_weights;
+    int _soft_number;
+    long _base_cost;                                 // Weight of empty clauses
+
+    Array<int> _rec_lits;                      // Assumption literal of records
+    Array<long> _rec_weights;                           // Weight left to cover
+    Array<int> _rec_cards;                   // Totalizer of an output, or NONE
+    Array<int> _rec_bounds;                          // Output of the totalizer
+    int _rec_number;
+    Array<int> _lit_recs;                    // Record of each literal, or NONE
+
+    Array<SAT_CardNodePtr> _cards;                       // Roots of totalizers
+    Array<long> _card_weights;
+    Array<int> _card_bounds;                             // Last output assumed
+    int _card_number;
+
+    Array<int> _core;                                   // Core being processed
+    Array<char> _model;                              // Values of best solution
+    long _lower_bound;
+    long _upper_bound;
+    long _stratum;                           // Least weight of records assumed
+    int _core_number;
+    int _relaxed;
+
+    void (*_report)(void *state, long cost);
+    void *_report_state;
+
+};
+
+#endif // __GRP_MAXSAT__
+
+/*****************************************************************************/
@@ -93,6 +93,21 @@ void SAT_Mode::init_mode()                             // Default configuration
     _mode[_CONF_CLAUSE_SIZE_] = INFINITY;                 // Accept all clauses
     _mode[_TRIM_SOLUTIONS_] = FALSE;            // NO trim solutions by default
     _mode[_CONF_CLAUSE_REPACKING_] = FALSE;    // NO repack conflicting clauses
+    _mode[_BATCH_WORKERS_] = NONE;              // One worker for each processor
+    _mode[_WRITE_IMAGE_] = _NO_IMAGE_;                 // Solve the instance
+    _mode[_ELIM_THREADS_] = NONE;                   // NO variable elimination
+    _mode[_LOCAL_THREADS_] = NONE;                           // NO local search
+    _mode[_LOAD_THREADS_] = NONE;                     // Files loaded sequentially
+    _mode[_AIG_OUTPUT_] = NONE;                    // All outputs of circuits
+    _mode[_PREFETCH_] = TRUE;              // Instances loaded while solving
+    _mode[_CACHE_SIZE_] = NONE;                     // NO cache of instances
+    _mode[_LEARNT_LBD_] = 6;                   // Export clauses of LBD <= 6
+    _mode[_LEARNT_SIZE_] = 30;                          // and of size <= 30
+    _mode[_CHECKPOINT_TIME_] = 600;           // Checkpoint every 10 minutes
+    _mode[_WALL_LIMIT_] = NONE;                   // NO wall-clock time limit
+    _mode[_MEMORY_LIMIT_] = NONE;                          // NO memory limit
+    _mode[_ENUM_LIMIT_] = NONE;               // NO enumeration of solutions
+    _mode[_BACKBONE_CHUNK_] = NONE;                   // NO backbone computed
 }
 
 /*****************************************************************************/
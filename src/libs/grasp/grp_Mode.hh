@@ -42,11 +42,26 @@ enum SatModes {
     _BACKTRACKING_STRATEGY_,              // Which backtracking strategy to use
     _DB_GROWTH_,                        // Chosen growth of teh clause database
     _CONF_CLAUSE_SIZE_,          // Largest clause size to add to the clause DB
-    _TRIM_SOLUTIONS_,       // Prune computed solutions of irrelevant decisions
-    _CONF_CLAUSE_REPACKING_     // Retrace depdendencies to decisions if useful
+    _TRIM_SOLUTIONS_,         // Trim solutions to minimal partial assignments
+    _CONF_CLAUSE_REPACKING_,    // Retrace depdendencies to decisions if useful
+    _BATCH_WORKERS_,               // Number of worker processes in batch mode
+    _WRITE_IMAGE_,                 // Write image of the instance, do not solve
+    _ELIM_THREADS_,               // Threads used for eliminating variables
+    _LOCAL_THREADS_,                // Threads used for running local search
+    _LOAD_THREADS_,                    // Threads used for loading CNF files
+    _AIG_OUTPUT_,                   // Output of AIGER circuits to be checked
+    _PREFETCH_,             // Load next instance while solving in batch mode
+    _CACHE_SIZE_,                 // Size bound (MB) of the cache of instances
+    _LEARNT_LBD_,                   // Largest LBD of learnt clauses exported
+    _LEARNT_SIZE_,                 // Largest size of learnt clauses exported
+    _CHECKPOINT_TIME_,                // Seconds between checkpoints of search
+    _WALL_LIMIT_,                            // Maximum wall-clock time allowed
+    _MEMORY_LIMIT_,                  // Maximum memory (MB) of the clause DB
+    _ENUM_LIMIT_,                     // Maximum solutions enumerated, or NONE
+    _BACKBONE_CHUNK_         // Candidates of backbone tested at once, or NONE
     };
 
-enum { SAT_OPTION_NUMBER = (_CONF_CLAUSE_REPACKING_+1) };
+enum { SAT_OPTION_NUMBER = (_BACKBONE_CHUNK_+1) };
 
 
 enum BackStrategies {
@@ -75,6 +90,12 @@ enum DecisionModes {
     _DYNAMIC_ORD_                // Best assignment chosen before each decision
     };
 
+enum ImageModes {
+    _NO_IMAGE_,                                         // Solve the instance
+    _CHECKED_IMAGE_,            // Image with checksum, verified when loaded
+    _UNCHECKED_IMAGE_                 // Image without checksum, loaded faster
+    };
+
 enum DecisionLevels {                             // Decision making procedures
     _FIXED_, _LCS_, _LIS_, _CA_, _JW_, _CAJW_, _PARTITION_,
     _MSOS_, _MSTS_, _MSMM_, _BOHM_, _DLIS_, _DLCS_, _DJW_
@@ -88,7 +109,7 @@ enum DecisionLevels {                             // Decision making procedures
 
 enum DeduceResult { CONFLICT = 0x40, NO_CONFLICT = 0x41 };
 
-enum DecideResult { DECISION = 0x50, SOLUTION = 0x51  };
+enum DecideResult { DECISION = 0x50, SOLUTION = 0x51, FAILED = 0x52 };
 
 
 
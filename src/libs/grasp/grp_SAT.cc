@@ -6,6 +6,14 @@
 // Remarks: --
 //
 // History: 03/10/96 - JPMS - created.
+//          10/19/26 - agent - hybrid search with local search engine.
+//          10/19/26 - agent - preprocessed instances kept in a cache.
+//          10/19/26 - agent - learnt clauses imported from files.
+//          10/19/26 - agent - checkpoints of the search.
+//          10/19/26 - agent - assumptions and termination callback.
+//          10/19/26 - agent - final conflict analysis of failed assumptions.
+//          10/19/26 - agent - resource governor of the search.
+//          10/19/26 - agent - engines reused by the instances recycled.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -28,34 +36,81 @@
 // Function: setup()
 //
 // Purpose: Sets up engines and data structures used by the SAT algorithm.
+//
+// Side-effects: Engines are allocated by the first call only. Later calls
+//               allocate, or delete, the engines enabled, or disabled, by
+//               the mode since then.
+//
+// Notes: All engines refer to the FRE and BRE, hence are reallocated if
+//        the growth of the clause database requires another BRE.
 //-----------------------------------------------------------------------------
 
 void GRASP_SAT::setup (SAT_ClauseDatabase &clDB)
 {
     DBG1(cout<<"Inside GRASP_SAT setup function"<<endl;);
 
+    if (_BRE && _growth != _mode[_DB_GROWTH_]) {
+	teardown();
+    }
+
     //-------------------------------------------------------------------------
     // Define the forward and backward reasoning engines.
     //-------------------------------------------------------------------------
 
-    _FRE = new FRE (_mode);
+    if (!_BRE) {
+	_FRE = new FRE (_mode);
+
+	if (_mode[_DB_GROWTH_] == _POLYNOMIAL_DB_) {
+	    _BRE = (BRE*) new BRE_P (_mode);
+	} else {
+	    _BRE = new BRE (_mode);
+	}
+	_growth = _mode[_DB_GROWTH_];
 
-    if (_mode[_DB_GROWTH_] == _POLYNOMIAL_DB_) {
-	_BRE = (BRE*) new BRE_P (_mode);
-    } else {
-	_BRE = new BRE (_mode);
+	_deduceEng = new DeductionEngine (_mode, *_FRE, *_BRE);
+	_diagnoseEng = new DiagnosisEngine (_mode, *_FRE, *_BRE);
+	_decideEng = new DecisionEngine (_mode);
     }
 
     //-------------------------------------------------------------------------
     // Define the engines directly used by the search process.
     //-------------------------------------------------------------------------
 
-    if (_mode[_PREPROC_LEVEL_] != NONE) {
+    if (_mode[_PREPROC_LEVEL_] == NONE) {
+	if (_preprocEng) { delete _preprocEng; _preprocEng = NULL; }
+    } else if (!_preprocEng) {
 	_preprocEng = new PreprocessEngine (_mode, *_FRE, *_BRE);
     }
-    _deduceEng = new DeductionEngine (_mode, *_FRE, *_BRE);
-    _diagnoseEng = new DiagnosisEngine (_mode, *_FRE, *_BRE);
-    _decideEng = new DecisionEngine (_mode);
+    if (_mode[_ELIM_THREADS_] == NONE) {
+	if (_elimEng) { delete _elimEng; _elimEng = NULL; }
+    } else if (!_elimEng) {
+	_elimEng = new EliminationEngine (_mode, *_FRE);
+    }
+    if (_mode[_LOCAL_THREADS_] == NONE) {
+	if (_localEng) { delete _localEng; _localEng = NULL; }
+    } else if (!_localEng) {
+	_localEng = new LocalSearchEngine (_mode, *_FRE);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: teardown()
+//
+// Purpose: Deletes the engines, which setup() allocates again.
+//-----------------------------------------------------------------------------
+
+void GRASP_SAT::teardown()
+{
+    if (_BRE) { delete _BRE; _BRE = NULL; }
+    if (_FRE) { delete _FRE; _FRE = NULL; }
+    if (_preprocEng) { delete _preprocEng; _preprocEng = NULL; }
+    if (_elimEng) { delete _elimEng; _elimEng = NULL; }
+    if (_localEng) { delete _localEng; _localEng = NULL; }
+    if (_deduceEng) { delete _deduceEng; _deduceEng = NULL; }
+    if (_diagnoseEng) { delete _diagnoseEng; _diagnoseEng = NULL; }
+    if (_decideEng) { delete _decideEng; _decideEng = NULL; }
+    _growth = NONE;
 }
 
 
@@ -70,13 +125,21 @@ void GRASP_SAT::setup (SAT_ClauseDatabase &clDB)
 
 void GRASP_SAT::init(SAT_ClauseDatabase &clDB)
 {
+    MEM_POOL_SCOPE(clDB.pool());
     DBG0(if (_mode[_DEBUG_])
 	 {cout<<"CLAUSE DATABASE DUMP IN INIT"<<endl;clDB.dump(FALSE, cout);});
     clDB.init();
+    _FRE->init (clDB);
 
     if (_preprocEng) {
 	_preprocEng->init (clDB);
     }
+    if (_elimEng) {
+	_elimEng->init (clDB);
+    }
+    if (_localEng) {
+	_localEng->init (clDB);
+    }
     _deduceEng->init (clDB);
     _diagnoseEng->init (clDB);
     _decideEng->init (clDB);
@@ -92,16 +155,24 @@ void GRASP_SAT::init(SAT_ClauseDatabase &clDB)
 // Side-effects: All variables become unassigned. No clause is satisfied or
 //               unsatisfied.
 //
-// Notes: I decided not to implement reset for FRE's.
+// Notes: The BRE unassigns the variables, hence is reset first.
 //-----------------------------------------------------------------------------
 
 void GRASP_SAT::reset (SAT_ClauseDatabase &clDB)
 {
+    MEM_POOL_SCOPE(clDB.pool());
     _BRE->reset (clDB);
+    _FRE->reset (clDB);
 
     if (_preprocEng) {
 	_preprocEng->reset (clDB);
     }
+    if (_elimEng) {
+	_elimEng->reset (clDB);
+    }
+    if (_localEng) {
+	_localEng->reset (clDB);
+    }
     _deduceEng->reset (clDB);
     _diagnoseEng->reset (clDB);
     _decideEng->reset (clDB);
@@ -119,16 +190,51 @@ void GRASP_SAT::reset (SAT_ClauseDatabase &clDB)
 
 void GRASP_SAT::clear (SAT_ClauseDatabase &clDB)
 {
+    MEM_POOL_SCOPE(clDB.pool());
     clDB.clear();
     _BRE->clear (clDB);
+    _FRE->clear (clDB);
 
     if (_preprocEng) {
 	_preprocEng->clear (clDB);
     }
+    if (_elimEng) {
+	_elimEng->clear (clDB);
+    }
+    if (_localEng) {
+	_localEng->clear (clDB);
+    }
     _deduceEng->clear (clDB);
     _diagnoseEng->clear (clDB);
     _decideEng->clear (clDB);
 }
+
+
+//-----------------------------------------------------------------------------
+// Function: recycle()
+//
+// Purpose: Readies the solver and the clause database for the definition of
+//          another instance of SAT, once the current one is accounted for.
+//
+// Side-effects: Variables are unassigned, then all clauses and variables
+//               are deleted. The engines forget the instance and its stats,
+//               ie assumptions, failed assumptions and eliminated clauses.
+//
+// Notes: Engines and the arrays of engines and database keep their sizes,
+//        and are reused by the next instance. The options given, eg the
+//        cache and callbacks, are kept.
+//-----------------------------------------------------------------------------
+
+void GRASP_SAT::recycle (SAT_ClauseDatabase &clDB)
+{
+    MEM_POOL_SCOPE(clDB.pool());
+    if (_BRE) {
+	reset (clDB);
+	clDB.reset();
+	clear (clDB);
+    }
+    clDB.erase();
+}
 
 
 //-----------------------------------------------------------------------------
@@ -147,12 +253,16 @@ void GRASP_SAT::clear (SAT_ClauseDatabase &clDB)
 // Notes: If the backtracking strategy is _DYNAMIC_B_ is set, then dynamic
 //        organization of the search process is assumed and implemented.
 //        In the end *no* reset to the state of the variables is done. This
-//        should be done afterwards.
+//        should be done afterwards. With assumptions, those failed are
+//        kept until the next call (see BRE::failed()).
 //-----------------------------------------------------------------------------
 
 int GRASP_SAT::solve (SAT_ClauseDatabase &clDB)
 {
+    MEM_POOL_SCOPE(clDB.pool());
     _time.presetTime();
+    _governor.start();
+    _BRE->clear_failed();
 
     //-------------------------------------------------------------------------
     // Setup phase. Create DLevel = 0.
@@ -160,7 +270,12 @@ int GRASP_SAT::solve (SAT_ClauseDatabase &clDB)
 
     DBG0(if (_mode[_DEBUG_])clDB.dump (FALSE, cout););
     clDB.push_decision();
-    if (_preprocEng &&  (_preprocEng->preprocess (clDB) == CONFLICT) ||
+    int status = eliminate (clDB);
+    if (status != CONFLICT) {
+	resume (clDB);
+    }
+    if (status == CONFLICT ||
+	(_preprocEng && _preprocEng->preprocess (clDB) == CONFLICT) ||
 	(_deduceEng->deduce (clDB) == CONFLICT)) {
 	_BRE->reset (clDB, 0, 0);
 	if (_mode[_VERBOSE_]) {
@@ -177,12 +292,29 @@ int GRASP_SAT::solve (SAT_ClauseDatabase &clDB)
 	  if (_mode[_DEBUG_]) {clDB.check_consistency (TRUE);});
     DBG0(if (_mode[_DEBUG_]) clDB.dump (FALSE, cout););
 
-    while (!clDB.solution_found() && _decideEng->decide (clDB) != SOLUTION) {
+    if (_localEng) {
+	_localEng->start (clDB);
+    }
+    if (_checkpoint) {
+	_checkpoint->start();
+    }
+    int decision = DECISION;
+    while (!(clDB.solution_found() && _decideEng->assumptions_met()) &&
+	   (decision = _decideEng->decide (clDB)) == DECISION) {
 	DBG0(if (_mode[_DEBUG_])clDB.dump (TRUE, cout););
 
 	while (_deduceEng->deduce (clDB) == CONFLICT) {
+	    if (_localEng) {
+		_localEng->exchange (clDB, *_decideEng);
+	    }
 	    int backtrack_level = _diagnoseEng->diagnose (clDB);
 	    if (!backtrack (clDB, backtrack_level)) {
+		if (_localEng) {
+		    _localEng->stop();
+		}
+		if (_checkpoint) {
+		    _checkpoint->stop();
+		}
 		if (_mode[_VERBOSE_]) {
 		    printTime ("Unsatisfiable instance",
 			       _time.elapsedTime(), "SAT Elapsed");
@@ -191,7 +323,24 @@ int GRASP_SAT::solve (SAT_ClauseDatabase &clDB)
 	    }
 	    CHECK(else {if (_mode[_DEBUG_]) {clDB.check_consistency (TRUE);}});
 	}
+	if (_localEng && _localEng->solution_found() &&
+	    !_decideEng->assumption_number()) {
+	    _BRE->reset (clDB, 1, clDB.MLevel());      // Back to DLevel = 0
+	    clDB.DLevel() = 0;
+	    _localEng->assign_solution (clDB);
+	    break;
+	}
+	if (_checkpoint && _checkpoint->due()) {
+	    checkpoint (clDB, FALSE);
+	}
 	if (resources_exceeded (clDB)) {
+	    if (_localEng) {
+		_localEng->stop();
+	    }
+	    if (_checkpoint) {
+		checkpoint (clDB, TRUE);
+		_checkpoint->stop();
+	    }
 	    if (_mode[_VERBOSE_]) {
 		printTime ("Aborted instance",
 			   _time.elapsedTime(), "SAT Elapsed");
@@ -203,6 +352,24 @@ int GRASP_SAT::solve (SAT_ClauseDatabase &clDB)
 	      if (_mode[_DEBUG_]) {clDB.check_consistency (TRUE);});
 	DBGn(clDB.dump (TRUE, cout););
     }
+    if (_localEng) {
+	_localEng->stop();
+    }
+    if (_checkpoint) {
+	_checkpoint->stop();
+    }
+    if (decision == FAILED) {
+	_BRE->analyze_final (clDB, _decideEng->falsified_var(),
+			     _decideEng->falsified_value());
+	if (_mode[_VERBOSE_]) {
+	    printTime ("Unsatisfiable instance",
+		       _time.elapsedTime(), "SAT Elapsed");
+	}
+	return UNSATISFIABLE;
+    }
+    if (_elimEng) {
+	_elimEng->extend_solution (clDB);
+    }
     CHECK(clDB.check_solution(););
     if (_mode[_VERBOSE_]) {
 	printTime ("Satisfiable instance", _time.elapsedTime(), "SAT Elapsed");
@@ -211,6 +378,87 @@ int GRASP_SAT::solve (SAT_ClauseDatabase &clDB)
 }
 
 
+//-----------------------------------------------------------------------------
+// Function: eliminate()
+//
+// Purpose: Eliminates variables, unless the instance was loaded from the
+//          cache, in which case the eliminated clauses are restored. Returns
+//          CONFLICT if the instance is found unsat.
+//
+// Side-effects: Instances not loaded from the cache are stored once
+//               variables are eliminated, even if no engine is used.
+//-----------------------------------------------------------------------------
+
+int GRASP_SAT::eliminate (SAT_ClauseDatabase &clDB)
+{
+    if (_cache && _cache->loaded()) {
+	return _cache->restore (clDB, _elimEng);
+    }
+    int status = (_elimEng) ? _elimEng->eliminate (clDB) : NO_CONFLICT;
+    if (_cache) {
+	_cache->store (clDB, _elimEng, status);
+    }
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: resume()
+//
+// Purpose: Resumes the search from its checkpoint, if any, restoring the
+//          counters of the search. Otherwise imports learnt clauses, if a
+//          file of learnt clauses is given.
+//
+// Notes: The clauses of a checkpoint include those of the file of learnt
+//        clauses written by the same run, hence the file is not imported
+//        once resumed.
+//-----------------------------------------------------------------------------
+
+void GRASP_SAT::resume (SAT_ClauseDatabase &clDB)
+{
+    int resumed = FALSE;
+    if (_checkpoint) {
+	_checkpoint->import_file (clDB, *_decideEng);
+	resumed = _checkpoint->resumed();
+    }
+    if (resumed) {
+	clDB.dec_number() = _checkpoint->stat (_CKP_DECISIONS_);
+	_BRE->conf_number() = _checkpoint->stat (_CKP_CONFLICTS_);
+	_BRE->conf_cl_number() = _checkpoint->stat (_CKP_CONF_CLAUSES_);
+	_BRE->back_number() = _checkpoint->stat (_CKP_BACKTRACKS_);
+	_BRE->uip_number() = _checkpoint->stat (_CKP_UIPS_);
+	_governor.cpu_offset() =
+	    _checkpoint->stat (_CKP_SEARCH_TIME_) / 1000.0;
+    }
+    if (_learnt && resumed) {
+	_learnt->init (clDB);
+    }
+    else if (_learnt) {
+	_learnt->import_file (clDB, *_decideEng);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: checkpoint()
+//
+// Purpose: Takes a checkpoint of the search, with its counters. The last
+//          checkpoint is written before returning.
+//-----------------------------------------------------------------------------
+
+void GRASP_SAT::checkpoint (SAT_ClauseDatabase &clDB, int last)
+{
+    _checkpoint->stat (_CKP_DECISIONS_) = clDB.dec_number();
+    _checkpoint->stat (_CKP_CONFLICTS_) = _BRE->conf_number();
+    _checkpoint->stat (_CKP_CONF_CLAUSES_) = _BRE->conf_cl_number();
+    _checkpoint->stat (_CKP_BACKTRACKS_) = _BRE->back_number();
+    _checkpoint->stat (_CKP_UIPS_) = _BRE->uip_number();
+    _checkpoint->stat (_CKP_SEARCH_TIME_) =
+	(long) (_governor.cpu_time() * 1000.0);
+    _checkpoint->write (clDB, last);
+}
+
+
 //-----------------------------------------------------------------------------
 // Function: backtrack()
 //
@@ -218,6 +466,10 @@ int GRASP_SAT::solve (SAT_ClauseDatabase &clDB)
 //          found to be unsatisfiable.
 //
 // Side-effects: Search structures are updated accordingly.
+//
+// Notes: With assumptions, dynamic backtracking also unsets the decision
+//        levels above the backtracking level, such that assumptions always
+//        take the first decision levels.
 //-----------------------------------------------------------------------------
 
 int GRASP_SAT::backtrack (SAT_ClauseDatabase &clDB, int back_level)
@@ -226,7 +478,8 @@ int GRASP_SAT::backtrack (SAT_ClauseDatabase &clDB, int back_level)
 	_BRE->reset (clDB, back_level, clDB.MLevel());    // *must* reset state
 	return FALSE;
     }
-    else if (_mode[_BACKTRACKING_STRATEGY_] != _DYNAMIC_B_) {
+    else if (_mode[_BACKTRACKING_STRATEGY_] != _DYNAMIC_B_ ||
+	     _decideEng->assumption_number()) {
 	_BRE->reset (clDB, back_level + 1, clDB.active_decisions());
     }
     _decideEng->backtrack (clDB, back_level);      // Recover decision schedule
@@ -239,14 +492,22 @@ int GRASP_SAT::backtrack (SAT_ClauseDatabase &clDB, int back_level)
 //
 // Purpose: Evaluates whether the allowed computational resources have been
 //          exceeded.
+//
+// Notes: Resources used before resuming the search count. Limits on time
+//        and memory, and interrupts, are checked by the governor, which
+//        reads clocks only every so often. The search is also aborted once
+//        interrupted by SIGTERM, or once the callback set with
+//        set_terminate() asks for it.
 //-----------------------------------------------------------------------------
 
 int GRASP_SAT::resources_exceeded (SAT_ClauseDatabase &clDB)
 {
     int must_abort =
-	(_time.readTime() > _mode[_TIME_LIMIT_]) ||
+	_governor.exceeded (clDB, _BRE->conf_number()) ||
 	    clDB.resources_exceeded (clDB) ||
-		_BRE->resources_exceeded (clDB);
+		_BRE->resources_exceeded (clDB) ||
+		    (_checkpoint && _checkpoint->interrupted()) ||
+			(_terminate && _terminate (_terminate_state));
     return must_abort;
 }
 
@@ -272,9 +533,21 @@ void GRASP_SAT::output_stats (SAT_ClauseDatabase &clDB)
     if (_preprocEng) {
 	_preprocEng->output_stats (clDB);
     }
+    if (_elimEng) {
+	_elimEng->output_stats (clDB);
+    }
+    if (_localEng) {
+	_localEng->output_stats (clDB);
+    }
     _deduceEng->output_stats (clDB);
     _diagnoseEng->output_stats (clDB);
     _decideEng->output_stats (clDB);
+    if (_learnt) {
+	_learnt->output_stats();
+    }
+    if (_checkpoint) {
+	_checkpoint->output_stats();
+    }
     printItem();
 }
 
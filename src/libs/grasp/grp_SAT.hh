@@ -6,6 +6,13 @@
 // Remarks: --
 //
 // History: 03/10/96 - JPMS - created.
+//          10/19/26 - agent - preprocessed instances kept in a cache.
+//          10/19/26 - agent - learnt clauses imported from files.
+//          10/19/26 - agent - checkpoints of the search.
+//          10/19/26 - agent - assumptions and termination callback.
+//          10/19/26 - agent - access to the backward reasoning engine.
+//          10/19/26 - agent - resource governor of the search.
+//          10/19/26 - agent - engines reused across instances.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -22,9 +29,15 @@
 #include "grp_BRE_P.hh"
 #include "grp_FRE.hh"
 #include "grp_Preproc.hh"
+#include "grp_Elim.hh"
+#include "grp_Local.hh"
 #include "grp_Deduce.hh"
 #include "grp_Diagnose.hh"
 #include "grp_Decide.hh"
+#include "grp_Cache.hh"
+#include "grp_Learnt.hh"
+#include "grp_Checkpoint.hh"
+#include "grp_Governor.hh"
 
 
 
@@ -51,20 +64,23 @@ class GRASP_SAT {
     // Constructor/destructor.
     //-------------------------------------------------------------------------
 
-    GRASP_SAT (SAT_Mode &nmode) : _mode(nmode), _time() {
+    GRASP_SAT (SAT_Mode &nmode) : _mode(nmode), _time(), _governor(nmode) {
+	_BRE = NULL;
+	_FRE = NULL;
 	_preprocEng = NULL;
+	_elimEng = NULL;
+	_localEng = NULL;
 	_deduceEng = NULL;
 	_diagnoseEng = NULL;
 	_decideEng = NULL;
+	_cache = NULL;
+	_learnt = NULL;
+	_checkpoint = NULL;
+	_terminate = NULL;
+	_terminate_state = NULL;
+	_growth = NONE;
     }
-    virtual ~GRASP_SAT() {
-	delete _BRE;
-	delete _FRE;
-	if (_preprocEng) { delete _preprocEng; }
-	delete _deduceEng;
-	delete _diagnoseEng;
-	delete _decideEng;
-    }
+    virtual ~GRASP_SAT() { teardown(); }
 
     //-------------------------------------------------------------------------
     // Interface contract.
@@ -75,17 +91,32 @@ class GRASP_SAT {
     virtual void init (SAT_ClauseDatabase &clDB);
     virtual void reset (SAT_ClauseDatabase &clDB);
     virtual void clear (SAT_ClauseDatabase &clDB);
+    virtual void recycle (SAT_ClauseDatabase &clDB);  // For next instance
 
     virtual int solve (SAT_ClauseDatabase &clDB);          // Solve CNF formula
 
+    inline void set_cache (SAT_Cache *cache) { _cache = cache; }  // Or NULL
+    inline void set_learnt (SAT_Learnt *learnt) { _learnt = learnt; }
+    inline void set_checkpoint (SAT_Checkpoint *checkpoint) {
+	_checkpoint = checkpoint;
+    }
+    inline void set_terminate (void *state, int (*terminate)(void *state)) {
+	_terminate_state = state;            // Search aborts once it returns
+	_terminate = terminate;              // non-zero, unless it is NULL
+    }
+
     //-------------------------------------------------------------------------
     // Access key data structures and engines used by the search algorithm.
     //-------------------------------------------------------------------------
 
     inline PreprocessEngine &preprocess_engine() { return *_preprocEng; }
+    inline EliminationEngine &elimination_engine() { return *_elimEng; }
+    inline LocalSearchEngine &local_search_engine() { return *_localEng; }
     inline DeductionEngine &deduction_engine() { return *_deduceEng; }
     inline DiagnosisEngine &diagnosis_engine() { return *_diagnoseEng; }
     inline DecisionEngine &decision_engine() { return *_decideEng; }
+    inline BRE &backward_engine() { return *_BRE; }
+    inline SAT_Governor &governor() { return _governor; }
 
     //-------------------------------------------------------------------------
     // Functions for mode setting and for accessing stats of running the SAT
@@ -106,6 +137,12 @@ class GRASP_SAT {
     // used resources.
     //-------------------------------------------------------------------------
 
+    virtual void teardown();                            // Deletes all engines
+
+    virtual int eliminate (SAT_ClauseDatabase &clDB);
+    virtual void resume (SAT_ClauseDatabase &clDB);
+    virtual void checkpoint (SAT_ClauseDatabase &clDB, int last);
+
     virtual int backtrack (SAT_ClauseDatabase &clDB, int back_level);
 
     virtual int resources_exceeded (SAT_ClauseDatabase &clDB);
@@ -116,15 +153,26 @@ class GRASP_SAT {
 
     BRE *_BRE;     // Backward reasoning engine
     FRE *_FRE;     // Forward reasoning engine
+    int _growth;   // Growth of the database the BRE is set up for, or NONE
 
     PreprocessEngine *_preprocEng;
+    EliminationEngine *_elimEng;
+    LocalSearchEngine *_localEng;
     DeductionEngine *_deduceEng;
     DiagnosisEngine *_diagnoseEng;
     DecisionEngine *_decideEng;
 
+    SAT_Cache *_cache;           // Cache of the instance, not owned, if any
+    SAT_Learnt *_learnt;         // File of learnt clauses, not owned, if any
+    SAT_Checkpoint *_checkpoint;   // Checkpoints of search, not owned, if any
+
     SAT_Mode &_mode;
 
     Timer _time;
+    SAT_Governor _governor;                    // Limits and progress of search
+
+    int (*_terminate)(void *state);             // Termination callback, if any
+    void *_terminate_state;
 
   private:
 
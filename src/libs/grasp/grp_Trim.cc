@@ -0,0 +1,220 @@
+//-----------------------------------------------------------------------------
+// File: grp_Trim.cc
+//
+// Purpose: Member functions of the trimming of solutions.
+//
+// Remarks: --
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream.h>
+
+#include "grp_Trim.hh"
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+SAT_Trimmer::~SAT_Trimmer()
+{
+    _vars.resize (0);
+    _status.resize (0);
+    _heads.resize (0);
+    _lits.resize (0);
+    _pos.resize (0);
+    _next.resize (0);
+    _kept.resize (0);
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: trim()
+//
+// Purpose: Computes a subset-minimal partial assignment of the solution,
+//          which satisfies the clauses of the database, and those
+//          eliminated by the engine given, if any.
+//
+// Side-effects: The literals of the assignment are kept, in the order of
+//               the variables.
+//
+// Notes: Variables that no clause watches are unassigned at once. A
+//        variable required when tried stays required as others are
+//        unassigned, hence the assignment is subset-minimal.
+//-----------------------------------------------------------------------------
+
+int SAT_Trimmer::trim (SAT_ClauseDatabase &clDB, EliminationEngine *elimEng)
+{
+    _var_number = 0;
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	if (pvar->data()->ID() >= _var_number) {
+	    _var_number = pvar->data()->ID() + 1;
+	}
+    }
+    if (_var_number > _vars.size()) {            // Arrays are reused otherwise
+	_vars.resize (_var_number);
+	_status.resize (_var_number);
+	_heads.resize (_var_number);
+	_kept.resize (_var_number);
+    }
+    for (int k = 0; k < _var_number; k++) {
+	_vars[k] = NULL;
+	_status[k] = TRIM_UNASSIGNED;
+	_heads[k] = NONE;
+    }
+    _assigned_number = 0;
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	SAT_VariablePtr var = (SAT_VariablePtr) pvar->data();
+	_vars[var->ID()] = var;
+	if (var->value() != UNKNOWN) {
+	    _status[var->ID()] = TRIM_ASSIGNED;
+	    _assigned_number++;
+	}
+    }
+
+    // Clauses are copied with the literals of CNF files, and each one
+    // watches its first true literal.
+
+    _lit_number = _clause_number = 0;
+    SAT_ClauseListPtr pcl;
+    for (pcl = (SAT_ClauseListPtr) clDB.clauses().first(); pcl;
+	 pcl = pcl->next()) {
+	SAT_ClausePtr cl = pcl->data();
+	if (cl->learnt()) {
+	    continue;
+	}
+	if (_lit_number + cl->size() + 1 > _lits.size()) {
+	    _lits.resize (2*_lit_number + cl->size() + 1);
+	}
+	int start = _lit_number;
+	for_each(plit, cl->literals(), LiteralPtr) {
+	    LiteralPtr lit = plit->data();
+	    int idx = lit->variable()->ID() + 1;
+	    _lits[_lit_number++] = (lit->sign()) ? -idx : idx;
+	}
+	_lits[_lit_number++] = 0;
+	if (!add_clause (start)) {
+	    return NONE;
+	}
+    }
+    int elim_number = (elimEng) ? elimEng->elim_lit_number() : 0;
+    if (_lit_number + elim_number > _lits.size()) {
+	_lits.resize (_lit_number + elim_number);
+    }
+    for (int k = 0; k < elim_number; k++) {
+	int start = _lit_number;
+	for (; elimEng->elim_lits()[k]; k++) {
+	    _lits[_lit_number++] = elimEng->elim_lits()[k];
+	}
+	_lits[_lit_number++] = 0;
+	if (!add_clause (start)) {
+	    return NONE;
+	}
+    }
+
+    _kept_number = 0;
+    for (int k = 0; k < _var_number; k++) {
+	if (_status[k] == TRIM_ASSIGNED) {
+	    unassign (k);
+	}
+	if (_status[k] == TRIM_REQUIRED) {
+	    _kept[_kept_number++] = (_vars[k]->value() == TRUE) ? k+1 : -(k+1);
+	}
+    }
+    return _kept_number;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: output_assignments()
+//
+// Purpose: Outputs the partial assignment computed by the last trimming.
+//-----------------------------------------------------------------------------
+
+void SAT_Trimmer::output_assignments (ostream &outs)
+{
+    outs << "\n    Variable Assignments of Trimmed Solution:\n\t";
+    for (int k = 0; k < _kept_number; k++) {
+	int lit = _kept[k];
+	SAT_VariablePtr var = _vars[((lit > 0) ? lit : -lit) - 1];
+	outs << ((lit > 0) ? "" : "-") << var->name() << " ";
+    }
+    outs << endl << endl;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: add_clause()
+//
+// Purpose: Watches the first true literal of the clause copied from a
+//          position, ended by 0. Returns FALSE if the clause has none.
+//-----------------------------------------------------------------------------
+
+int SAT_Trimmer::add_clause (int start)
+{
+    int pos = start;
+    while (_lits[pos] && !is_true (_lits[pos])) {
+	pos++;
+    }
+    if (!_lits[pos]) {
+	return FALSE;
+    }
+    if (_clause_number >= _pos.size()) {
+	_pos.resize (2*_clause_number + 16);
+	_next.resize (2*_clause_number + 16);
+    }
+    int idx = ((_lits[pos] > 0) ? _lits[pos] : -_lits[pos]) - 1;
+    _pos[_clause_number] = pos;
+    _next[_clause_number] = _heads[idx];
+    _heads[idx] = _clause_number++;
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: unassign()
+//
+// Purpose: Unassigns a variable, and moves the watches of its clauses to
+//          other true literals. Returns FALSE if some clause has none, in
+//          which case the variable is required.
+//
+// Notes: Watches are only moved once all clauses have another literal,
+//        since a required variable stays assigned, and watches must not
+//        move past its literals.
+//-----------------------------------------------------------------------------
+
+int SAT_Trimmer::unassign (int idx)
+{
+    _status[idx] = TRIM_UNASSIGNED;
+    int cl;
+    for (cl = _heads[idx]; cl != NONE; cl = _next[cl]) {
+	int pos = _pos[cl] + 1;
+	while (_lits[pos] && !is_true (_lits[pos])) {
+	    pos++;
+	}
+	if (!_lits[pos]) {                              // Variable is required
+	    _status[idx] = TRIM_REQUIRED;
+	    return FALSE;
+	}
+    }
+    cl = _heads[idx];
+    while (cl != NONE) {
+	int next = _next[cl];
+	int pos = _pos[cl] + 1;
+	while (!is_true (_lits[pos])) {
+	    pos++;
+	}
+	int widx = ((_lits[pos] > 0) ? _lits[pos] : -_lits[pos]) - 1;
+	_pos[cl] = pos;
+	_next[cl] = _heads[widx];
+	_heads[widx] = cl;
+	cl = next;
+    }
+    _heads[idx] = NONE;
+    return TRUE;
+}
+
+/*****************************************************************************/
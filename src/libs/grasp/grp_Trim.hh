@@ -0,0 +1,109 @@
+//-----------------------------------------------------------------------------
+// File: grp_Trim.hh
+//
+// Purpose: Class declaration of the trimming of solutions, which reduces the
+//          solution found to a subset-minimal partial assignment that still
+//          satisfies all the clauses.
+//
+// Remarks: Each clause watches one of its true literals. Variables are then
+//          unassigned one at a time, and each clause watching one of them
+//          moves its watch to another true literal of an assigned variable.
+//          A variable is required once a clause has no such literal, and
+//          stays assigned. Watches only move forward in clauses, hence the
+//          trimming takes time linear in the size of the clauses.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __GRP_TRIM__
+#define __GRP_TRIM__
+
+#include <iostream.h>
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_CDB.hh"
+#include "grp_Elim.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for the status of variables being trimmed.
+//-----------------------------------------------------------------------------
+
+enum TrimStatus {
+    TRIM_UNASSIGNED = 0,               // Unassigned, or unassigned by trimming
+    TRIM_ASSIGNED,                                        // Not yet unassigned
+    TRIM_REQUIRED                           // Only true literal of some clause
+    };
+
+
+//-----------------------------------------------------------------------------
+// Class: SAT_Trimmer
+//
+// Purpose: Trims the solution held by the clause database, and keeps the
+//          literals of the partial assignment.
+//
+// Notes: Learnt clauses are implied by the others, and are not watched.
+//        Clauses removed by variable elimination are watched, such that the
+//        partial assignment satisfies the formula given. The values of the
+//        variables in the database are not changed. Arrays keep their size
+//        across solutions.
+//-----------------------------------------------------------------------------
+
+class SAT_Trimmer {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    SAT_Trimmer() : _vars(0), _status(0), _heads(0), _lits(0), _pos(0),
+	_next(0), _kept(0) {
+	_var_number = _lit_number = _clause_number = 0;
+	_assigned_number = _kept_number = 0;
+    }
+    virtual ~SAT_Trimmer();
+
+    //-------------------------------------------------------------------------
+    // Interface contract. trim() returns the number of literals kept, or
+    // NONE if some clause is not satisfied. Literals are indices of
+    // variables plus 1, negative if false, as in CNF files.
+    //-------------------------------------------------------------------------
+
+    virtual int trim (SAT_ClauseDatabase &clDB,
+		      EliminationEngine *elimEng = NULL);
+
+    inline int assigned_number() { return _assigned_number; }
+    inline int literal_number() { return _kept_number; }
+    inline int literal (int k) { return _kept[k]; }
+
+    virtual void output_assignments (ostream &outs);
+
+  protected:
+    virtual int add_clause (int start);
+    virtual int unassign (int idx);
+    inline int is_true (int lit) {
+	int idx = ((lit > 0) ? lit : -lit) - 1;
+	return (_status[idx] != TRIM_UNASSIGNED &&
+		_vars[idx]->value() == ((lit > 0) ? TRUE : FALSE));
+    }
+
+    Array<SAT_VariablePtr> _vars;                         // Variables by index
+    Array<char> _status;
+    Array<int> _heads;                   // First clause watching each variable
+    int _var_number;
+    int _assigned_number;
+
+    Array<int> _lits;                               // Clauses, each ended by 0
+    int _lit_number;
+    Array<int> _pos;                          // Literal watched by each clause
+    Array<int> _next;                      // Next clause watching the variable
+    int _clause_number;
+
+    Array<int> _kept;                             // Literals of the assignment
+    int _kept_number;
+};
+
+#endif // __GRP_TRIM__
+
+/*****************************************************************************/
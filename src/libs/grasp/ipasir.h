@@ -0,0 +1,64 @@
+/*----------------------------------------------------------------------------
+ * File: ipasir.h
+ *
+ * Purpose: C interface of incremental SAT solvers (IPASIR), implemented by
+ *          GRASP in grp_Incr.cc.
+ *
+ * Remarks: Literals are non-zero ints as in the DIMACS format, ie +v or -v
+ *          for variable v. Clauses are added one literal at a time, and
+ *          ended with literal 0. Assumptions only hold for the next call
+ *          of ipasir_solve(), which returns 10 if satisfiable, 20 if
+ *          unsatisfiable, and 0 if the search is aborted. GRASP also
+ *          provides groups of clauses, which are pushed and popped. Each
+ *          returns the number of groups pushed afterwards, which
+ *          identifies the group pushed. Once unsatisfiable,
+ *          grasp_group_failed() identifies the groups of the core, and
+ *          grasp_minimize_core() removes failed assumptions and groups
+ *          until each one left is required, and returns the number of
+ *          assumptions left.
+ *          grasp_interrupt() aborts the running call, or else the next
+ *          one, and can be invoked from other threads or signal handlers.
+ *
+ * History: 10/19/26 - agent - created.
+ *          10/19/26 - agent - groups of clauses.
+ *          10/19/26 - agent - minimization of the failed assumptions.
+ *          10/19/26 - agent - interrupts.
+ *          10/19/26 - agent - groups in the core.
+ *          10/19/26 - agent - groups pushed without a name.
+ *---------------------------------------------------------------------------*/
+
+#ifndef __IPASIR__
+#define __IPASIR__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char *ipasir_signature ();
+void *ipasir_init ();
+void ipasir_release (void *solver);
+void ipasir_add (void *solver, int32_t lit_or_zero);
+void ipasir_assume (void *solver, int32_t lit);
+int ipasir_solve (void *solver);
+int32_t ipasir_val (void *solver, int32_t lit);
+int ipasir_failed (void *solver, int32_t lit);
+void ipasir_set_terminate (void *solver, void *data,
+			   int (*terminate)(void *data));
+void ipasir_set_learn (void *solver, void *data, int max_length,
+		       void (*learn)(void *data, int32_t *clause));
+
+int grasp_push (void *solver, const char *name);        /* Unnamed if NULL */
+int grasp_pop (void *solver, const char *name);      /* Last group if NULL */
+int grasp_minimize_core (void *solver);
+int grasp_group_failed (void *solver, int group);
+void grasp_interrupt (void *solver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IPASIR__ */
+
+/*****************************************************************************/
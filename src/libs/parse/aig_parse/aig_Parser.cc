@@ -0,0 +1,543 @@
+//-----------------------------------------------------------------------------
+// File: aig_Parser.cc
+//
+// Purpose: Realization of a parser that reads a circuit from a file in
+//          AIGER format and builds the initial clause database.
+//
+// Remarks: Each AND gate g = a & b in the cone of influence is encoded
+//          with the clauses (-g + a) (-g + b) (g + -a + -b), or with fewer
+//          clauses if a and b are the same variable.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "aig_Parser.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static int compare_lits (const void *lit1, const void *lit2)
+{
+    return *((int*) lit1) - *((int*) lit2);
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: is_aiger
+//
+// Purpose: Checks whether a file starts with the header of an AIGER file,
+//          ie with "aag " or "aig ".
+// ----------------------------------------------------------------------------
+
+int AIG_Parser::is_aiger (char *fname)
+{
+    char magic[4];
+    int fd = open (fname, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    int size = read (fd, magic, 4);
+    close (fd);
+    return (size == 4 &&
+	    (!memcmp (magic, "aag ", 4) || !memcmp (magic, "aig ", 4)));
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: load_CDB
+//
+// Purpose: Given a file specification, in AIGER format, it builds the
+//          internal clause database. Returns FALSE if the file cannot be
+//          read.
+//
+// Side-effects: The database is built, and the gates of the circuit are
+//               defined in the database.
+//
+// Notes: Only nodes in the cone of influence of the outputs checked and of
+//        the constraints are encoded.
+// ----------------------------------------------------------------------------
+
+# define MAX_WORD_LENGTH    32
+
+int AIG_Parser::load_CDB (char *fname, SAT_ClauseDatabase &clDB)
+{
+    DBGn(cout<<"Entering AIG_parser::parse()"<<endl;
+	 cout<<"File name: "<<fname<<endl;);
+
+    if (!read_file (fname)) {
+	return FALSE;
+    }
+    int binary;
+    parse_header (binary);
+    parse_circuit (binary);
+    delete[] text;
+    text = pos = end = NULL;
+
+    int first = 0, last = output_number + bad_number;
+    if (output != NONE) {
+	if (output < 0 || output >= last) {
+	    Abort("Output index exceeds number of outputs");
+	}
+	first = output;
+	last = output+1;
+    }
+    for (int k = first; k < last; k++) {
+	mark_cone (outputs[k]);
+    }
+    for (int k = 0; k < constraint_number; k++) {
+	mark_cone (constraints[k]);
+    }
+    add_variables (clDB);
+    add_gates (clDB);
+
+    for (int k = 0; k < constraint_number; k++) {
+	add_clause (clDB, constraints[k]);
+    }
+    if (last > first) {                     // Some output checked must be 1
+	int *lits = &outputs[first];
+	int size = last - first;
+	qsort (lits, size, sizeof(int), compare_lits);
+	int number = 1;
+	for (int k = 1; k < size; k++) {
+	    if (lits[k] == lits[number-1]) {
+		continue;                                 // Repeated output
+	    }
+	    if ((lits[k] >> 1) == (lits[number-1] >> 1)) {
+		return TRUE;                     // Complementary outputs
+	    }
+	    lits[number++] = lits[k];
+	}
+	SAT_ClausePtr clause = clDB.add_clause();
+	for (int k = 0; k < number; k++) {
+	    clDB.add_literal (clause, variables[lits[k] >> 1], lits[k] & 1);
+	}
+    }
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: read_file
+//
+// Purpose: Reads the contents of a file, which is followed by a null
+//          character. Returns FALSE if the file cannot be read.
+// ----------------------------------------------------------------------------
+
+int AIG_Parser::read_file (char *fname)
+{
+    int fd = open (fname, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    struct stat fstatus;
+    if (fstat (fd, &fstatus) < 0) {
+	close (fd);
+	return FALSE;
+    }
+    size_t size = fstatus.st_size;
+    text = new char[size+1];
+    size_t length = 0;
+    while (length < size) {
+	ssize_t bytes = read (fd, text + length, size - length);
+	if (bytes <= 0) {
+	    break;
+	}
+	length += bytes;
+    }
+    close (fd);
+    if (length < size) {
+	delete[] text;
+	text = NULL;
+	return FALSE;
+    }
+    text[size] = '\0';
+    pos = text;
+    end = text + size;
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: parse_header
+//
+// Purpose: Reads the header of the file, ie M I L O A and optionally
+//          B C J F, and sets up the nodes of the circuit.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::parse_header (int &binary)
+{
+    if (end - pos < 4 ||
+	(memcmp (pos, "aag ", 4) && memcmp (pos, "aig ", 4))) {
+	Abort("Invalid header of AIGER file");
+    }
+    binary = (pos[1] == 'i');
+    pos += 3;
+
+    max_var = read_number();
+    input_number = read_number();
+    latch_number = read_number();
+    output_number = read_number();
+    and_number = read_number();
+    bad_number = read_number();
+    constraint_number = read_number();
+    justice_number = read_number();
+    fairness_number = read_number();
+    end_line();
+
+    if (max_var < 0 || input_number < 0 || latch_number < 0 ||
+	output_number < 0 || and_number < 0 || max_var >= INT_MAX/2) {
+	Abort("Invalid header of AIGER file");
+    }
+    if (binary && (long) max_var !=
+	(long) input_number + latch_number + and_number) {
+	Abort("Invalid header of AIGER file");
+    }
+    if (bad_number < 0)        { bad_number = 0; }
+    if (constraint_number < 0) { constraint_number = 0; }
+    if (justice_number < 0)    { justice_number = 0; }
+    if (fairness_number < 0)   { fairness_number = 0; }
+
+    int size = max_var+1;
+    if (size > kinds.size()) {                  // Arrays are reused otherwise
+	kinds.resize (size);
+	marks.resize (size);
+	variables.resize (size);
+	fanins.resize (2*size);
+    }
+    for (int k = 0; k < size; k++) {
+	kinds[k] = AIG_UNDEF;
+	marks[k] = FALSE;
+	variables[k] = NULL;
+    }
+    if (output_number + bad_number > outputs.size()) {
+	outputs.resize (output_number + bad_number);
+    }
+    if (constraint_number > constraints.size()) {
+	constraints.resize (constraint_number);
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: parse_circuit
+//
+// Purpose: Reads the inputs, latches, outputs, bad states, constraints and
+//          AND gates of the circuit.
+//
+// Notes: In binary files, inputs are implicit, latches only give their
+//        next state, and AND gates are coded as deltas.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::parse_circuit (int binary)
+{
+    for (int k = 0; k < input_number; k++) {
+	int lit = 2*(k+1);
+	if (!binary) {
+	    lit = read_number();
+	    end_line();
+	}
+	define_node (lit, AIG_INPUT, NONE, NONE);
+    }
+    for (int k = 0; k < latch_number; k++) {
+	int lit = (binary) ? 2*(input_number+k+1) : read_number();
+	if (read_number() < 0) {                       // Next state is ignored
+	    Abort("Invalid latch in AIGER file");
+	}
+	end_line();
+	define_node (lit, AIG_LATCH, NONE, NONE);
+    }
+    for (int k = 0; k < output_number + bad_number; k++) {
+	outputs[k] = read_number();
+	end_line();
+	if (outputs[k] < 0 || outputs[k] > 2*max_var+1) {
+	    Abort("Invalid literal in AIGER file");
+	}
+    }
+    for (int k = 0; k < constraint_number; k++) {
+	constraints[k] = read_number();
+	end_line();
+	if (constraints[k] < 0 || constraints[k] > 2*max_var+1) {
+	    Abort("Invalid literal in AIGER file");
+	}
+    }
+    int skipped = fairness_number;              // Justice and fairness lines
+    for (int k = 0; k < justice_number; k++) {
+	int size = read_number();
+	end_line();
+	if (size < 0 || skipped > INT_MAX - size) {
+	    Abort("Invalid justice property in AIGER file");
+	}
+	skipped += size;
+    }
+    for (int k = 0; k < skipped; k++) {
+	end_line();
+    }
+
+    for (int k = 0; k < and_number; k++) {
+	int lit, lit0, lit1;
+	if (binary) {
+	    lit = 2*(input_number+latch_number+k+1);
+	    unsigned int delta0 = read_delta();
+	    unsigned int delta1 = read_delta();
+	    if (delta0 == 0 || delta0 > (unsigned int) lit) {
+		Abort("Invalid AND gate in AIGER file");
+	    }
+	    lit0 = lit - delta0;
+	    if (delta1 > (unsigned int) lit0) {
+		Abort("Invalid AND gate in AIGER file");
+	    }
+	    lit1 = lit0 - delta1;
+	}
+	else {
+	    lit = read_number();
+	    lit0 = read_number();
+	    lit1 = read_number();
+	    end_line();
+	}
+	define_node (lit, AIG_AND, lit0, lit1);
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: read_number
+//
+// Purpose: Reads an unsigned number from the current line. Returns NONE if
+//          there is no number.
+// ----------------------------------------------------------------------------
+
+int AIG_Parser::read_number()
+{
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+	pos++;
+    }
+    if (pos >= end || *pos < '0' || *pos > '9') {
+	return NONE;
+    }
+    int value = 0;
+    for (; pos < end && *pos >= '0' && *pos <= '9'; pos++) {
+	if (value > (INT_MAX - (*pos - '0')) / 10) {
+	    Abort("Number too large in AIGER file");
+	}
+	value = 10*value + (*pos - '0');
+    }
+    return value;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: read_delta
+//
+// Purpose: Reads a delta of a binary AND gate, coded with 7 bits for each
+//          byte, the high bit being set for all bytes but the last.
+// ----------------------------------------------------------------------------
+
+unsigned int AIG_Parser::read_delta()
+{
+    unsigned int value = 0;
+    for (int shift = 0; ; shift += 7) {
+	if (pos >= end || shift > 28) {
+	    Abort("Invalid AND gate in AIGER file");
+	}
+	unsigned char ch = (unsigned char) *pos++;
+	value |= (unsigned int) (ch & 0x7f) << shift;
+	if (!(ch & 0x80)) {
+	    break;
+	}
+    }
+    return value;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: end_line
+//
+// Purpose: Moves the current position past the next newline.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::end_line()
+{
+    char *eol = (char*) memchr (pos, '\n', end - pos);
+    pos = (eol) ? eol+1 : end;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: define_node
+//
+// Purpose: Defines the node of a (positive) literal as an input, a latch
+//          or an AND gate of two literals.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::define_node (int lit, int kind, int lit0, int lit1)
+{
+    int var = lit >> 1;
+    if (lit < 2 || (lit & 1) || var > max_var || kinds[var] != AIG_UNDEF) {
+	Abort("Invalid definition in AIGER file");
+    }
+    if (kind == AIG_AND) {
+	if (lit0 < 0 || lit0 > 2*max_var+1 || (lit0 >> 1) == var ||
+	    lit1 < 0 || lit1 > 2*max_var+1 || (lit1 >> 1) == var) {
+	    Abort("Invalid AND gate in AIGER file");
+	}
+	fanins[2*var] = lit0;
+	fanins[2*var+1] = lit1;
+    }
+    kinds[var] = kind;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: mark_cone
+//
+// Purpose: Marks the nodes in the cone of influence of a literal.
+//
+// Notes: An explicit stack is used, since circuits can be very deep.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::mark_cone (int lit)
+{
+    int top = 0;
+    if (stack.size() == 0) {
+	stack.resize (64);
+    }
+    stack[top++] = lit >> 1;
+    while (top > 0) {
+	int var = stack[--top];
+	if (marks[var]) {
+	    continue;
+	}
+	marks[var] = TRUE;
+	if (var > 0 && kinds[var] == AIG_UNDEF) {
+	    Abort("Undefined literal in AIGER file");
+	}
+	if (kinds[var] == AIG_AND) {
+	    if (top+2 > stack.size()) {
+		stack.resize (2*stack.size());
+	    }
+	    stack[top++] = fanins[2*var] >> 1;
+	    stack[top++] = fanins[2*var+1] >> 1;
+	}
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: add_variables
+//
+// Purpose: Creates the variables of the nodes marked, in increasing order
+//          of index. The constant, if used, is set to 0 with a unit clause.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::add_variables (SAT_ClauseDatabase &clDB)
+{
+    for (int k = 0; k <= max_var; k++) {
+	if (marks[k]) {
+	    char *name = var_name (k);
+
+	    DBGn(cout<<"defining var: "<<name<<" for node "<<k<<endl;);
+	    variables[k] = clDB.add_variable (name);
+	}
+    }
+    if (marks[0]) {
+	add_clause (clDB, 1);
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: add_gates
+//
+// Purpose: Creates the clauses of the AND gates marked, and defines the
+//          gates in the clause database.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::add_gates (SAT_ClauseDatabase &clDB)
+{
+    for (int k = 1; k <= max_var; k++) {
+	if (!marks[k] || kinds[k] != AIG_AND) {
+	    continue;
+	}
+	int lit = 2*k;
+	int lit0 = fanins[2*k];
+	int lit1 = fanins[2*k+1];
+	if (lit0 == lit1) {                                     // Buffer
+	    add_clause (clDB, lit^1, lit0);
+	    add_clause (clDB, lit, lit0^1);
+	}
+	else if (lit0 == (lit1^1)) {                          // Constant 0
+	    add_clause (clDB, lit^1);
+	}
+	else {
+	    add_clause (clDB, lit^1, lit0);
+	    add_clause (clDB, lit^1, lit1);
+	    add_clause (clDB, lit, lit0^1, lit1^1);
+	}
+	clDB.add_gate (variables[k], variables[lit0 >> 1], lit0 & 1,
+		       variables[lit1 >> 1], lit1 & 1);
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: add_clause
+//
+// Purpose: Creates a clause with up to three literals, of distinct
+//          variables.
+// ----------------------------------------------------------------------------
+
+void AIG_Parser::add_clause (SAT_ClauseDatabase &clDB,
+			     int lit0, int lit1, int lit2)
+{
+    SAT_ClausePtr clause = clDB.add_clause();
+    clDB.add_literal (clause, variables[lit0 >> 1], lit0 & 1);
+    if (lit1 != NONE) {
+	clDB.add_literal (clause, variables[lit1 >> 1], lit1 & 1);
+    }
+    if (lit2 != NONE) {
+	clDB.add_literal (clause, variables[lit2 >> 1], lit2 & 1);
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: var_name
+//
+// Purpose: Returns the name of the variable of the node with index idx.
+//
+// Side-effects: Names are created once and shared by all instances loaded
+//               by the parser.
+//
+// Notes: Names are not deleted, since variables may outlive the parser.
+// ----------------------------------------------------------------------------
+
+char *AIG_Parser::var_name (int idx)
+{
+    if (idx >= names.size()) {
+	int orig_size = names.size();
+	names.resize ((idx >= 2*orig_size) ? idx+1 : 2*orig_size);
+	for (int k = orig_size; k < names.size(); k++) {
+	    names[k] = NULL;
+	}
+    }
+    if (!names[idx]) {
+	char word_buffer[MAX_WORD_LENGTH];
+	sprintf (word_buffer, "%d", idx);
+	names[idx] = new char[strlen (word_buffer)+1];
+	strcpy (names[idx], word_buffer);
+    }
+    return names[idx];
+}
+
+/*****************************************************************************/
@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+// File: aig_Parser.hh
+//
+// Purpose: Class declaration of a parser for circuits in AIGER format,
+//          ASCII (aag) or binary (aig). The AND gates in the cone of
+//          influence of the outputs checked are encoded into clauses, and
+//          the definition of each gate is kept by the clause database.
+//
+// Remarks: Latches are taken as free variables, ie only the current state
+//          of the circuit is checked. Justice and fairness properties, and
+//          the symbol table, are ignored.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __AIG_PARSER__
+#define __AIG_PARSER__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_SAT.hh"        // Only requires ability to create clause database
+
+
+//-----------------------------------------------------------------------------
+// Defines for AIGER circuits.
+//-----------------------------------------------------------------------------
+
+enum AIG_Nodes {
+    AIG_UNDEF = 0,
+    AIG_INPUT,
+    AIG_LATCH,
+    AIG_AND
+    };
+
+
+//-----------------------------------------------------------------------------
+// Class: AIG_Parser
+//
+// Purpose: Creates clause databases from AIGER files. The instance is
+//          satisfiable iff some output checked can be 1 while all the
+//          constraints of the circuit are 1. Outputs are numbered as in the
+//          file, with bad state properties following the outputs.
+//
+// Notes: Variables are named by their index in the circuit, and are
+//        created in increasing order of index. The constant is only
+//        created if it is used, with name 0.
+//-----------------------------------------------------------------------------
+
+class AIG_Parser {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    AIG_Parser() : kinds(0), fanins(0), marks(0), variables(0), names(0),
+		   outputs(0), constraints(0), stack(0) {
+	output = NONE; text = NULL; pos = end = NULL;
+    }
+    virtual ~AIG_Parser() {
+	kinds.resize(0);
+	fanins.resize(0);
+	marks.resize(0);
+	variables.resize(0);
+	names.resize(0);                 // Names are still used by variables
+	outputs.resize(0);
+	constraints.resize(0);
+	stack.resize(0);
+    }
+
+    //-------------------------------------------------------------------------
+    // Interface contract: create clause DB from a file in AIGER format.
+    //-------------------------------------------------------------------------
+
+    static int is_aiger (char *fname);           // Checks header of the file
+
+    int load_CDB (char *name, SAT_ClauseDatabase &clDB);
+
+    inline void set_output (int idx) { output = idx; }    // NONE for all
+
+private:
+    int read_file (char *fname);
+    void parse_header (int &binary);
+    void parse_circuit (int binary);
+    int read_number();
+    unsigned int read_delta();
+    void end_line();
+    void define_node (int lit, int kind, int lit0, int lit1);
+    void mark_cone (int lit);
+    void add_variables (SAT_ClauseDatabase &clDB);
+    void add_gates (SAT_ClauseDatabase &clDB);
+    void add_clause (SAT_ClauseDatabase &clDB, int lit0, int lit1 = NONE,
+		     int lit2 = NONE);
+    char *var_name (int idx);
+
+    int max_var;                                 // Header: M I L O A B C J F
+    int input_number;
+    int latch_number;
+    int output_number;
+    int and_number;
+    int bad_number;
+    int constraint_number;
+    int justice_number;
+    int fairness_number;
+
+    Array<int> kinds;                            // Kind of each node
+    Array<int> fanins;                           // Inputs of AND gates
+    Array<int> marks;                            // Nodes in cone of influence
+    Array<SAT_VariablePtr> variables;            // Array for node to pointer
+    Array<char*> names;          // Variable names, reused by loaded instances
+    Array<int> outputs;                          // Outputs and bad states
+    Array<int> constraints;
+    Array<int> stack;                            // Nodes to mark
+    int output;                                  // Output checked, or NONE
+
+    char *text;                                  // Contents of the file
+    char *pos;
+    char *end;
+
+};
+
+#endif // __AIG_PARSER__
+
+/*****************************************************************************/
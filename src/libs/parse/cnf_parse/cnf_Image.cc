@@ -0,0 +1,377 @@
+//-----------------------------------------------------------------------------
+// File: cnf_Image.cc
+//
+// Purpose: Creation and mapping of binary images of CNF formulas.
+//
+// Remarks: Images are written to a temporary file which is then renamed,
+//          hence processes never map partially written images. Checksums
+//          are computed on 32-bit words, as FNV-1a on bytes.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - clause offsets, checksums and source of images.
+//          10/19/26 - agent - checksum of literals verified while loading.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <iostream.h>
+
+#include "cnf_Image.hh"
+
+
+# define IMAGE_BUFFER_SIZE  4096
+# define MAX_PATH_SIZE      1024
+# define CHECKSUM_BASIS     0xcbf29ce484222325UL
+# define CHECKSUM_PRIME     0x100000001b3UL
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static int write_data (int fd, char *data, size_t size)
+{
+    while (size > 0) {
+	ssize_t count = ::write (fd, data, size);
+	if (count <= 0) {
+	    return FALSE;
+	}
+	data += count;
+	size -= count;
+    }
+    return TRUE;
+}
+
+static inline unsigned long checksum_words (unsigned long sum,
+					    unsigned int *words,
+					    unsigned long number)
+{
+    for (unsigned long k = 0; k < number; k++) {
+	sum = (sum ^ words[k]) * CHECKSUM_PRIME;
+    }
+    return sum;
+}
+
+
+//-----------------------------------------------------------------------------
+// Class: ImageOutput
+//
+// Purpose: Buffered output of an image, which computes the checksum of the
+//          data written once checksumming is started.
+//-----------------------------------------------------------------------------
+
+class ImageOutput {
+  public:
+    ImageOutput (int nfd) { _fd = nfd; _count = 0; _ok = TRUE;
+			    _checking = FALSE; _sum = CHECKSUM_BASIS; }
+    virtual ~ImageOutput() {}
+
+    inline void put (void *data, int size) {         // Size multiple of 4
+	if (_checking) {
+	    _sum = checksum_words (_sum, (unsigned int*) data, size / 4);
+	}
+	if (_count + size > IMAGE_BUFFER_SIZE) {
+	    flush();
+	}
+	if (size > IMAGE_BUFFER_SIZE) {
+	    _ok = _ok && write_data (_fd, (char*) data, size);
+	    return;
+	}
+	memcpy (_buffer + _count, data, size);
+	_count += size;
+    }
+    inline void flush() {
+	_ok = _ok && write_data (_fd, _buffer, _count);
+	_count = 0;
+    }
+    inline void start_checksum() { _checking = TRUE; }
+    inline unsigned long checksum() { return _sum; }
+    inline int ok() { return _ok; }
+
+  protected:
+    int _fd;
+    char _buffer[IMAGE_BUFFER_SIZE];
+    int _count;                                   // Bytes in buffer
+    int _ok;                                      // No write errors
+    int _checking;
+    unsigned long _sum;
+};
+
+
+// ----------------------------------------------------------------------------
+// Function: is_image
+//
+// Purpose: Returns TRUE if the file starts with the magic of images.
+// ----------------------------------------------------------------------------
+
+int CNF_Image::is_image (char *fname)
+{
+    char magic[CNF_IMAGE_MAGIC_SIZE];
+    int fd = open (fname, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    int count = read (fd, magic, CNF_IMAGE_MAGIC_SIZE);
+    close (fd);
+    return (count == CNF_IMAGE_MAGIC_SIZE &&
+	    !memcmp (magic, CNF_IMAGE_MAGIC, CNF_IMAGE_MAGIC_SIZE));
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: write
+//
+// Purpose: Writes the image of the clauses of a clause database. Variable
+//          with ID k is written as k+1, as in the CNF format. If a source
+//          file is given, its name, size and time are recorded. If
+//          checksum is TRUE, the checksum is verified whenever the image
+//          is mapped.
+//
+// Side-effects: The file is replaced only once the image is complete.
+//
+// Notes: Intended for databases just loaded, ie before any clause is
+//        added by the search process.
+// ----------------------------------------------------------------------------
+
+int CNF_Image::write (char *fname, ClauseDatabase &clDB, char *source,
+		      int checksum)
+{
+    CNF_ImageHeader header;
+    memset (&header, 0, sizeof(header));
+    memcpy (header.magic, CNF_IMAGE_MAGIC, sizeof(header.magic));
+    header.version = CNF_IMAGE_VERSION;
+    header.header_size = sizeof(header);
+    header.var_number = 0;
+    header.cl_number = clDB.clauses().size();
+    header.lit_number = 0;
+    header.flags = (checksum) ? CNF_IMAGE_CHECKSUM : 0;
+
+    for_each(pvar, clDB.variables(), VariablePtr) {
+	if (pvar->data()->ID() >= header.var_number) {
+	    header.var_number = pvar->data()->ID() + 1;
+	}
+    }
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	header.lit_number += pcl->data()->literals().size();
+    }
+
+    char source_path[PATH_MAX + sizeof(unsigned long)];
+    struct stat sstatus;
+    if (source && stat (source, &sstatus) == 0 &&
+	realpath (source, source_path)) {
+	header.source_name_size = strlen (source_path) + 1;
+	header.source_size = sstatus.st_size;
+	header.source_mtime = sstatus.st_mtime;
+    }
+    int pad_size = (- (header.header_size + header.source_name_size)) &
+	(sizeof(unsigned long) - 1);
+    header.offsets_pos = header.header_size + header.source_name_size +
+	pad_size;
+    header.lits_pos = header.offsets_pos +
+	(header.cl_number + 1) * sizeof(unsigned long);
+    header.image_size = header.lits_pos + header.lit_number * sizeof(int);
+
+    char tmp_name[MAX_PATH_SIZE];
+    if (strlen (fname) + 16 > MAX_PATH_SIZE) {
+	return FALSE;
+    }
+    sprintf (tmp_name, "%s.%d", fname, (int) getpid());
+    int fd = open (tmp_name, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if (fd < 0) {
+	return FALSE;
+    }
+    ImageOutput output (fd);
+    output.put (&header, sizeof(header));          // Rewritten at the end
+    if (header.source_name_size) {
+	memset (source_path + header.source_name_size, 0, pad_size);
+	output.put (source_path, header.source_name_size + pad_size);
+    }
+    output.start_checksum();
+
+    unsigned long offset = 0;
+    output.put (&offset, sizeof(offset));
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	offset += pcl->data()->literals().size();
+	output.put (&offset, sizeof(offset));
+    }
+    for_each(pcl, clDB.clauses(), ClausePtr) {
+	if (!output.ok()) { break; }
+	for_each(plit, pcl->data()->literals(), LiteralPtr) {
+	    LiteralPtr lit = plit->data();
+	    int vID = lit->variable()->ID() + 1;
+	    int code = (lit->sign()) ? -vID : vID;
+	    output.put (&code, sizeof(code));
+	}
+    }
+    output.flush();
+    header.checksum = output.checksum();
+
+    int ok = output.ok() && lseek (fd, 0, SEEK_SET) == 0 &&
+	write_data (fd, (char*) &header, sizeof(header));
+    ok = (close (fd) == 0) && ok;
+
+    if (!ok || rename (tmp_name, fname) < 0) {
+	unlink (tmp_name);
+	return FALSE;
+    }
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: map
+//
+// Purpose: Maps an image read-only, after validating it. Returns FALSE if
+//          the file cannot be mapped, if it is not a valid image, or if
+//          the image is stale.
+//
+// Side-effects: Pages of the image are shared with any other process that
+//               maps the same file.
+// ----------------------------------------------------------------------------
+
+int CNF_Image::map (char *fname)
+{
+    unmap();
+    int fd = open (fname, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    struct stat fstatus;
+    if (fstat (fd, &fstatus) < 0 ||
+	fstatus.st_size < (off_t) sizeof(CNF_ImageHeader)) {
+	close (fd);
+	return FALSE;
+    }
+    void *area = mmap (NULL, fstatus.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close (fd);
+    if (area == MAP_FAILED) {
+	return FALSE;
+    }
+    _header = (CNF_ImageHeader*) area;
+    _map_size = fstatus.st_size;
+
+    if (!valid()) {
+	Warn("Invalid image of CNF formula");
+	unmap();
+	return FALSE;
+    }
+    if (stale()) {
+	Warn("Stale image of CNF formula");
+	unmap();
+	return FALSE;
+    }
+    madvise (area, _map_size, MADV_SEQUENTIAL);
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: valid
+//
+// Purpose: Checks the header and the clause offsets of the image, and
+//          starts its checksum if any.
+//
+// Notes: Literals are checked when clauses are created from the image,
+//        such that the image is read once.
+// ----------------------------------------------------------------------------
+
+int CNF_Image::valid()
+{
+    CNF_ImageHeader &header = *_header;
+    if (memcmp (header.magic, CNF_IMAGE_MAGIC, CNF_IMAGE_MAGIC_SIZE) ||
+	header.version != CNF_IMAGE_VERSION ||
+	header.header_size != sizeof(CNF_ImageHeader) ||
+	header.image_size != _map_size ||
+	header.var_number < 0 || header.cl_number < 0 ||
+	header.source_name_size < 0 ||
+	header.offsets_pos % sizeof(unsigned long) ||
+	header.offsets_pos < (unsigned long) header.header_size +
+	header.source_name_size ||
+	header.lits_pos != header.offsets_pos +
+	(header.cl_number + 1) * sizeof(unsigned long) ||
+	header.image_size != header.lits_pos +
+	header.lit_number * sizeof(int)) {
+	return FALSE;
+    }
+    if (header.source_name_size &&
+	source_name()[header.source_name_size-1] != '\0') {
+	return FALSE;
+    }
+    unsigned long *offs = offsets();
+    if (offs[0] != 0 || offs[header.cl_number] != header.lit_number) {
+	return FALSE;
+    }
+    for (int k = 0; k < header.cl_number; k++) {
+	if (offs[k] > offs[k+1]) {
+	    return FALSE;
+	}
+    }
+    _sum = CHECKSUM_BASIS;
+    if (header.flags & CNF_IMAGE_CHECKSUM) {
+	unsigned long number = (header.lits_pos - header.offsets_pos) / 4;
+	_sum = checksum_words (_sum, (unsigned int*) offs, number);
+    }
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: sum_literals
+//
+// Purpose: Adds literals of the image, read after those already added, to
+//          its checksum.
+// ----------------------------------------------------------------------------
+
+void CNF_Image::sum_literals (int *lits, unsigned long number)
+{
+    if (checked()) {
+	_sum = checksum_words (_sum, (unsigned int*) lits, number);
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: stale
+//
+// Purpose: Returns TRUE if the source of the image was changed after the
+//          image was written.
+//
+// Notes: Images whose source is unknown, or no longer exists, are never
+//        stale, ie images can be used without their sources.
+// ----------------------------------------------------------------------------
+
+int CNF_Image::stale()
+{
+    char *name = source_name();
+    struct stat sstatus;
+    if (!name || stat (name, &sstatus) < 0) {
+	return FALSE;
+    }
+    return (sstatus.st_size != _header->source_size ||
+	    sstatus.st_mtime != _header->source_mtime);
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: unmap
+//
+// Purpose: Unmaps the image, if any.
+// ----------------------------------------------------------------------------
+
+void CNF_Image::unmap()
+{
+    if (_header) {
+	munmap ((char*) _header, _map_size);
+	_header = NULL;
+	_map_size = 0;
+    }
+}
+
+/*****************************************************************************/
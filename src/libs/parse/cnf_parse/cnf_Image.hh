@@ -0,0 +1,135 @@
+//-----------------------------------------------------------------------------
+// File: cnf_Image.hh
+//
+// Purpose: Class declaration of binary images of CNF formulas. An image
+//          holds the original clauses as the offsets of their first
+//          literals and an array of packed literals, and is mapped
+//          read-only. Hence formulas are loaded without parsing text.
+//
+// Remarks: Images only contain offsets, ie they can be mapped at any
+//          address. Images are not portable between architectures. An
+//          image records the size and modification time of the CNF file
+//          it was written from, and is refused once that file changes.
+//          The clause database does *not* use the image in place: its
+//          clauses are linked objects updated by the search, hence each
+//          process still creates one object per literal of the image,
+//          and only the pages of the image itself are shared.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - clause offsets, checksums and source of images.
+//          10/19/26 - agent - images hold normalized clauses.
+//          10/19/26 - agent - checksum of literals verified while loading.
+//          10/19/26 - agent - images described as faster loading only.
+//-----------------------------------------------------------------------------
+
+#ifndef __CNF_IMAGE__
+#define __CNF_IMAGE__
+
+#include <stddef.h>
+
+#include "defs.hh"
+#include "grp_CNF.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for images of CNF formulas.
+//-----------------------------------------------------------------------------
+
+# define CNF_IMAGE_MAGIC      "GRASPCNF"
+# define CNF_IMAGE_MAGIC_SIZE 8
+# define CNF_IMAGE_VERSION    3                  // Normalized clauses
+# define CNF_IMAGE_CHECKSUM   0x1                  // Flag of checked images
+
+
+//-----------------------------------------------------------------------------
+// Header of an image, stored at offset 0 of the file. The header is
+// followed by the name of the source file, the offsets of the clauses
+// (cl_number+1 of them, in literals) and the literals, coded as
+// +/-(ID+1). The checksum covers offsets and literals, in this order.
+//-----------------------------------------------------------------------------
+
+struct CNF_ImageHeader {
+    char magic[CNF_IMAGE_MAGIC_SIZE];            // Always CNF_IMAGE_MAGIC
+    int version;
+    int header_size;
+    int var_number;
+    int cl_number;
+    unsigned long lit_number;                    // Literals of all clauses
+    unsigned long offsets_pos;                   // Position of the offsets
+    unsigned long lits_pos;                      // Position of the literals
+    unsigned long image_size;                    // Size of the file
+    unsigned long checksum;
+    int flags;                                   // CNF_IMAGE_CHECKSUM or 0
+    int source_name_size;                        // 0 if no source is known
+    long source_size;                            // Source when written
+    long source_mtime;
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: CNF_Image
+//
+// Purpose: Creation and (read-only) mapping of images of CNF formulas.
+//-----------------------------------------------------------------------------
+
+class CNF_Image {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    CNF_Image() { _header = NULL; _map_size = 0; _sum = 0; }
+    virtual ~CNF_Image() { unmap(); }
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    static int is_image (char *fname);             // Checks magic of a file
+    static int write (char *fname, ClauseDatabase &clDB,
+		      char *source = NULL, int checksum = TRUE);
+
+    virtual int map (char *fname);
+    virtual void unmap();
+
+    inline int var_number() { return _header->var_number; }
+    inline int cl_number() { return _header->cl_number; }
+    inline unsigned long lit_number() { return _header->lit_number; }
+    inline unsigned long *offsets() {
+	return (unsigned long*) ((char*) _header + _header->offsets_pos);
+    }
+    inline int *literals() {
+	return (int*) ((char*) _header + _header->lits_pos);
+    }
+    inline char *source_name() {
+	return (_header->source_name_size) ?
+	    (char*) _header + _header->header_size : (char*) NULL;
+    }
+
+    //-------------------------------------------------------------------------
+    // map() checks the offsets against the checksum, if any. The literals
+    // are then checked as they are loaded, ie with sum_literals() for all
+    // literals in order, and checksum_valid() once they are all read.
+    //-------------------------------------------------------------------------
+
+    inline int checked() { return (_header->flags & CNF_IMAGE_CHECKSUM); }
+    virtual void sum_literals (int *lits, unsigned long number);
+    inline int checksum_valid() {
+	return (!checked() || _sum == _header->checksum);
+    }
+
+protected:
+    virtual int valid();                        // Checks layout and checksum
+    virtual int stale();                        // Checks source of the image
+
+    CNF_ImageHeader *_header;                    // Mapped image, if any
+    size_t _map_size;
+    unsigned long _sum;                          // Checksum of data read
+
+};
+
+#endif // __CNF_IMAGE__
+
+/*****************************************************************************/
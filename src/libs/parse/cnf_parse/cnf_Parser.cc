@@ -8,6 +8,14 @@
 //
 // History: 6/21/95 - JPMS - created.
 //          3/16/96 - JPMS - repackaged for new version of GRASP.
+//          10/19/26 - agent - files are mapped and scanned in place.
+//          10/19/26 - agent - large files are scanned in chunks by threads.
+//          10/19/26 - agent - compressed files are parsed while decompressed.
+//          10/19/26 - agent - images hold clause offsets and packed literals.
+//          10/19/26 - agent - clauses are normalized when loading.
+//          10/19/26 - agent - projection lines are read.
+//          10/19/26 - agent - checksum of images verified while loading.
+//          10/19/26 - agent - projection lines read in chunks.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -15,9 +23,52 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <fstream.h>
 
 #include "cnf_Parser.hh"
+#include "cnf_Scanner.hh"
+#include "cnf_Stream.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static void *chunk_thread (void *arg)
+{
+    CNF_ChunkPtr chunk = (CNF_ChunkPtr) arg;
+    chunk->parser()->scan_chunk (chunk);
+    return NULL;
+}
+
+static int compare_codes (const void *code1, const void *code2)
+{
+    return *((int*) code1) - *((int*) code2);
+}
+
+static inline void sort_codes (int *codes, int size)
+{
+    if (size > 16) {
+	qsort (codes, size, sizeof(int), compare_codes);
+	return;
+    }
+    for (int k = 1; k < size; k++) {               // Clauses are mostly short
+	int code = codes[k];
+	int j = k;
+	for (; j > 0 && codes[j-1] > code; j--) {
+	    codes[j] = codes[j-1];
+	}
+	codes[j] = code;
+    }
+}
+
+static inline unsigned int hash_codes (int *codes, int size)
+{
+    unsigned int hash = 2166136261U;
+    for (int k = 0; k < size; k++) {
+	hash = (hash ^ (unsigned int) codes[k]) * 16777619U;
+    }
+    return hash;
+}
 
 
 // ----------------------------------------------------------------------------
@@ -28,87 +79,616 @@
 //
 // Side-effects: The database is built.
 //
-// Notes: ---
+// Notes: The file is mapped and scanned in place, hence there is no limit
+//        on the length of lines. Compressed files are decompressed while
+//        they are parsed (see load_stream()).
 // ----------------------------------------------------------------------------
 
-# define MAX_LINE_LENGTH    256
 # define MAX_WORD_LENGTH    32
 
 int CNF_Parser::load_CDB (char *fname, SAT_ClauseDatabase &clDB)
 {
     DBGn(cout<<"Entering CNF_parser::parse()"<<endl;
 	 cout<<"File name: "<<fname<<endl;);
-    char line_buffer[MAX_LINE_LENGTH];
-    char word_buffer[MAX_WORD_LENGTH];
-    SAT_ClausePtr clause = NULL;
 
-    ifstream inp (fname, ios::in|ios::nocreate);
-    if (!inp) {
+    if (CNF_Image::is_image (fname)) {
+	return load_image (fname, clDB);
+    }
+    int format = CNF_Stream::compression (fname);
+    if (format != CNF_PLAIN) {
+	return load_stream (fname, format, clDB);
+    }
+    CNF_Text text;
+    if (!text.map (fname)) {
+	return FALSE;
+    }
+    start_parse();
+    CNF_Scanner scanner (text.begin(), text.end());
+    parse_tokens (scanner, TRUE, clDB);
+    end_parse (clDB);
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: load_stream
+//
+// Purpose: Builds the clause database from a compressed CNF file, which is
+//          parsed in buffers while it is decompressed. Returns FALSE if the
+//          file cannot be decompressed.
+//
+// Side-effects: The database is built.
+//
+// Notes: Each buffer is parsed up to its last newline, or else up to its
+//        last blank, and the remaining text is prepended to the next
+//        buffer. Hence tokens and (but for very long lines) problem lines
+//        are never split.
+// ----------------------------------------------------------------------------
+
+int CNF_Parser::load_stream (char *fname, int format, SAT_ClauseDatabase &clDB)
+{
+    CNF_Stream stream;
+    if (!stream.open (fname, format)) {
 	return FALSE;
     }
-    while (inp.getline(line_buffer, MAX_LINE_LENGTH)) {
-	if (line_buffer[0] == 'c') {
-	    continue;
+    start_parse();
+    char *text = NULL;                        // Text left from previous buffer
+    int text_len = 0;
+    char *data;
+    int length;
+    while ((data = stream.next_buffer (length))) {
+	char *begin = data - text_len;
+	if (text) {
+	    memcpy (begin, text, text_len);
+	    stream.release_buffer();
+	}
+	char *end = data + length;
+	char *cut = end;
+	while (cut > begin && cut[-1] != '\n') { cut--; }
+	if (cut == begin && in_comment) {
+	    cut = end;
 	}
-	else if (line_buffer[0] == 'p') {
-	    int var_num;
-	    int cl_num;
+	else if (cut == begin) {
+	    for (cut = end; cut > begin && (unsigned char) cut[-1] > ' '; cut--);
+	}
+	if (end - cut > CNF_STREAM_BUFFER_SIZE) {
+	    Abort("Token too long in compressed file");
+	}
+	CNF_Scanner scanner (begin, cut);
+	parse_tokens (scanner, FALSE, clDB);
+
+	text = cut;
+	text_len = end - cut;
+	if (!text_len) {
+	    stream.release_buffer();
+	    text = NULL;
+	}
+    }
+    if (text) {
+	CNF_Scanner scanner (text, text + text_len);
+	parse_tokens (scanner, TRUE, clDB);
+	stream.release_buffer();
+    }
+    end_parse (clDB);
+    return stream.close();
+}
 
-	    int arg = sscanf (line_buffer, "p cnf %d %d", &var_num, &cl_num);
-	    if( arg < 2 ) {
+
+// ----------------------------------------------------------------------------
+// Function: parse_tokens
+//
+// Purpose: Adds the clauses in the range of a scanner to the database. If
+//          last is TRUE, the range ends the file, and large ranges of
+//          clauses are loaded in chunks.
+//
+// Side-effects: Clauses are added to the database.
+//
+// Notes: Comment and problem lines are identified by their first token.
+//        The state of the parser is kept between ranges, since clauses
+//        and comments may continue into the next range, unless last is
+//        TRUE. Empty clauses are not created.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::parse_tokens (CNF_Scanner &scanner, int last,
+			       SAT_ClauseDatabase &clDB)
+{
+    if (in_comment) {                          // Comment from previous range
+	if (scanner.line_end() == scanner.range_end()) {
+	    return;
+	}
+	in_comment = FALSE;
+	scanner.skip_line();
+    }
+    char *tok;
+    while ((tok = scanner.next_token())) {
+	if (*tok == 'c') {
+	    in_comment = (!last && scanner.line_end() == scanner.range_end());
+	    if (!in_comment && scanner.token_end() == tok+1) {
+		parse_projection (scanner.token_end(), scanner.line_end(),
+				  proj_vars, proj_number);
+	    }
+	    scanner.skip_line();
+	}
+	else if (*tok == 'p') {                       // p cnf <vars> <clauses>
+	    char *eol = scanner.line_end();
+	    char *fmt = scanner.next_token();
+	    char *vtok = scanner.next_token();
+	    if (vtok) {
+		cur_var_num = CNF_Scanner::token_value (vtok,
+							 scanner.token_end());
+	    }
+	    char *ctok = scanner.next_token();
+	    if (!ctok || ctok >= eol || strncmp (fmt, "cnf", 3)) {
 		Abort("Unable to read number of variables and clauses");
 	    }
-	    DBGn(cout<<"total vars: "<<var_num<<endl;);
-	    variables.resize (var_num);
-	    for (int k = 0; k < var_num; k++) {
-		sprintf( word_buffer, "%d%c", k+1, '\0' );
-		int s_size = strlen( word_buffer );
-		char *name = new char[s_size+1] ;
-		strcpy( name, word_buffer );
-
-		DBGn(cout<<"defining var: "<<name<<" for index "<<k<<endl;);
-		variables[k] = clDB.add_variable (name);
+	    DBGn(cout<<"total vars: "<<cur_var_num<<endl;);
+	    add_variables (cur_var_num, clDB);
+	}
+	else {                                         // Literal of a clause
+	    if (last && load_threads > 1 && cur_size == 0 &&
+		scanner.range_end() - tok >= 2*CNF_CHUNK_SIZE) {
+		load_chunks (tok, scanner.range_end(), clDB);
+		return;
+	    }
+	    int vID = CNF_Scanner::token_value (tok, scanner.token_end());
+
+	    if (vID != 0) {
+		DBGn(cout<<"adding "<<vID<<" to clause\n";);
+		add_literal (vID);
+	    } else {
+		end_clause (clDB);
 	    }
 	}
-	else {                             // Clause definition or continuation
-	    char *lp = line_buffer;
-	    do {
-		char *wp = word_buffer;
-		while (*lp && ((*lp == ' ') || (*lp == '\t'))) {
-		    lp++;
-		}
-		while (*lp && (*lp != ' ') && (*lp != '\t') && (*lp != '\n')) {
-		    *(wp++) = *(lp++);
-		}
-		*wp = '\0';                                 // terminate string
-
-		if (strlen(word_buffer) != 0) {     // check if number is there
-		    if( clause == NULL ) {
-			DBGn(cout<<"creating new clause\n";);
-			clause = clDB.add_clause();
-		    }
-		    int vID = atoi (word_buffer);
-		    int sign = FALSE;
-
-		    if( vID != 0) {
-			if( vID < 0)  { vID = -vID; sign = TRUE; }
-
-			DBGn(cout<<"adding "<<vID<<" to clause w/ sign ";
-			     cout<<sign<<"\n";);
-			clDB.add_literal( clause, variables[vID-1], sign );
-		    } else {
-			if(clause->size() <= 0) {
-			    clDB.del_clause (clause);       // size zero clause
-			}
-			clause = NULL;
-		    }
-		}
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: parse_projection
+//
+// Purpose: Reads the variables of a projection line, ie of a comment line
+//          "c ind <vars> 0" or "c p show <vars> 0", after its first token.
+//          Other comment lines are ignored. The variables are appended to
+//          the first number entries of vars.
+//
+// Notes: Invoked by the threads of chunks as well, and so it only changes
+//        vars and number.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::parse_projection (char *pos, char *eol, Array<int> &vars,
+				   int &number)
+{
+    char *words[2];
+    int lengths[2];
+    for (int k = 0; k < 2; k++) {
+	while (pos < eol && (unsigned char) *pos <= ' ') { pos++; }
+	words[k] = pos;
+	while (pos < eol && (unsigned char) *pos > ' ') { pos++; }
+	lengths[k] = pos - words[k];
+    }
+    if (lengths[0] == 3 && !strncmp (words[0], "ind", 3)) {
+	pos = words[0] + 3;
+    }
+    else if (lengths[0] == 1 && *words[0] == 'p' &&
+	     lengths[1] == 4 && !strncmp (words[1], "show", 4)) {
+	pos = words[1] + 4;
+    }
+    else {
+	return;
+    }
+    for (;;) {
+	while (pos < eol && (unsigned char) *pos <= ' ') { pos++; }
+	char *word = pos;
+	while (pos < eol && (unsigned char) *pos > ' ') { pos++; }
+	int var = CNF_Scanner::token_value (word, pos);
+	if (var <= 0) {
+	    break;
+	}
+	if (number >= vars.size()) {
+	    vars.resize (2*number + 16);
+	}
+	vars[number++] = var;
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: load_image
+//
+// Purpose: Builds the internal clause database from an image of a CNF
+//          formula, which is mapped read-only while loading. Returns FALSE
+//          if the image cannot be mapped, or is found corrupt.
+//
+// Side-effects: The database is built. It must be erased if the image is
+//               found corrupt once loaded.
+//
+// Notes: Clauses are still copied into the database, one object for each
+//        literal, since variables and clauses are linked objects private
+//        to each process, ie images save parsing but not this copy. The
+//        checksum of the literals is computed as they are copied. Clauses
+//        are not normalized, since images are written from databases.
+// ----------------------------------------------------------------------------
+
+int CNF_Parser::load_image (char *fname, SAT_ClauseDatabase &clDB)
+{
+    CNF_Image image;
+    if (!image.map (fname)) {
+	return FALSE;
+    }
+    start_parse();                                 // Images have no projection
+    int var_num = image.var_number();
+    add_variables (var_num, clDB);
+
+    unsigned long *offsets = image.offsets();
+    int *lits = image.literals();
+    for (int k = 0; k < image.cl_number(); k++) {
+	image.sum_literals (lits + offsets[k], offsets[k+1] - offsets[k]);
+	if (offsets[k] == offsets[k+1]) {
+	    continue;                           // Empty clauses are not created
+	}
+	SAT_ClausePtr clause = clDB.add_clause();
+	for (unsigned long j = offsets[k]; j < offsets[k+1]; j++) {
+	    int vID = lits[j];
+	    int sign = FALSE;
+
+	    if (vID < 0)  { vID = -vID; sign = TRUE; }
+	    if (vID == 0 || vID > var_num) {
+		Warn("Invalid literal in image of CNF formula");
+		return FALSE;
 	    }
-	    while (*lp);
+	    clDB.add_literal (clause, variables[vID-1], sign);
 	}
     }
+    if (!image.checksum_valid()) {
+	Warn("Invalid image of CNF formula");
+	return FALSE;
+    }
     return TRUE;
 }
 
+
+// ----------------------------------------------------------------------------
+// Function: load_chunks
+//
+// Purpose: Loads the clauses between begin and end, which are split into
+//          chunks at line boundaries. Chunks are scanned concurrently, one
+//          for each thread, and then their literals and projection
+//          variables are added in the order of the file.
+//
+// Side-effects: The clauses are added to the database.
+//
+// Notes: Chunks start at the beginning of lines, hence comments are found
+//        as in a sequential scan, and clauses split between chunks are
+//        joined when adding literals. Objects of the database are only
+//        created by the calling thread, and so clauses are in the same
+//        order as when loading sequentially.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::load_chunks (char *begin, char *end,
+			      SAT_ClauseDatabase &clDB)
+{
+    int number = load_threads;
+    if ((end - begin) / CNF_CHUNK_SIZE < number) {
+	number = (end - begin) / CNF_CHUNK_SIZE;
+    }
+    if (number > chunks.size()) {                 // Chunks are reused otherwise
+	int orig_size = chunks.size();
+	chunks.resize (number);
+	for (int k = orig_size; k < number; k++) {
+	    chunks[k] = new CNF_Chunk();
+	}
+    }
+    char *start = begin;
+    for (int k = 0; k < number; k++) {
+	char *stop = end;
+	if (k < number-1) {                       // Split after next newline
+	    stop = begin + (end - begin) / number * (k+1);
+	    if (stop < start) { stop = start; }
+	    stop = (char*) memchr (stop, '\n', end - stop);
+	    stop = (stop) ? stop+1 : end;
+	}
+	CNF_ChunkPtr chunk = chunks[k];
+	chunk->parser() = this;
+	chunk->begin() = start;
+	chunk->end() = stop;
+	chunk->lits().resize ((stop - start) / 2 + 1);  // Tokens are separated
+	chunk->lit_number() = 0;
+	chunk->proj_number() = 0;
+	chunk->status() = TRUE;
+	start = stop;
+    }
+
+    int created;
+    for (created = 1; created < number; created++) {
+	CNF_ChunkPtr chunk = chunks[created];
+	if (pthread_create (&chunk->thread(), NULL,
+			    chunk_thread, (void*) chunk)) {
+	    break;
+	}
+    }
+    created--;                                     // Number of threads created
+    scan_chunk (chunks[0]);
+    for (int k = 1; k <= created; k++) {
+	pthread_join (chunks[k]->thread(), NULL);
+    }
+    for (int k = created+1; k < number; k++) {            // Not run by threads
+	scan_chunk (chunks[k]);
+    }
+
+    for (int k = 0; k < number; k++) {
+	CNF_ChunkPtr chunk = chunks[k];
+	if (!chunk->status()) {
+	    Abort("Problem line found after clauses");
+	}
+	int *lits = &chunk->lits()[0];
+	add_literals (lits, lits + chunk->lit_number(), clDB);
+	chunk->lits().resize (0);
+	for (int j = 0; j < chunk->proj_number(); j++) {
+	    if (proj_number >= proj_vars.size()) {
+		proj_vars.resize (2*proj_number + 16);
+	    }
+	    proj_vars[proj_number++] = chunk->proj()[j];
+	}
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: scan_chunk
+//
+// Purpose: Scans the literals of a chunk of a CNF file.
+//
+// Side-effects: The literals, and the variables of projection lines, are
+//               written into the chunk.
+//
+// Notes: Invoked by the thread of the chunk, and so it must not create
+//        objects of the database.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::scan_chunk (CNF_ChunkPtr chunk)
+{
+    CNF_Scanner scanner (chunk->begin(), chunk->end());
+    int *lits = &chunk->lits()[0];
+    int number = 0;
+    char *tok;
+    while ((tok = scanner.next_token())) {
+	if (*tok == 'c') {
+	    if (scanner.token_end() == tok+1) {
+		parse_projection (scanner.token_end(), scanner.line_end(),
+				  chunk->proj(), chunk->proj_number());
+	    }
+	    scanner.skip_line();
+	}
+	else if (*tok == 'p') {
+	    chunk->status() = FALSE;
+	    break;
+	}
+	else {
+	    lits[number++] = CNF_Scanner::token_value (tok, scanner.token_end());
+	}
+    }
+    chunk->lit_number() = number;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: add_literals
+//
+// Purpose: Adds the literals between lits and end_lits, coded as +/-(ID+1)
+//          and with clauses ended by 0, to the clause being read.
+//
+// Side-effects: Clauses are created when they end.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::add_literals (int *lits, int *end_lits,
+			       SAT_ClauseDatabase &clDB)
+{
+    for (; lits < end_lits; lits++) {
+	if (*lits != 0) {
+	    add_literal (*lits);
+	} else {
+	    end_clause (clDB);
+	}
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: end_clause
+//
+// Purpose: Normalizes the clause read, and creates it unless it is empty,
+//          a tautology or a duplicate of a clause already created.
+//
+// Side-effects: The clause is created, and added to the hash set of
+//               clauses.
+//
+// Notes: A clause with repeated literals would otherwise break the
+//        bounds kept for clauses by the clause database.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::end_clause (SAT_ClauseDatabase &clDB)
+{
+    int size = cur_size;
+    cur_size = 0;
+    if (size == 0) {
+	return;                                 // Empty clauses are not created
+    }
+    int *codes = &cur_lits[0];
+    sort_codes (codes, size);
+    int number = 1;
+    for (int k = 1; k < size; k++) {
+	if (codes[k] == codes[number-1]) {
+	    continue;                                     // Repeated literal
+	}
+	if ((codes[k] >> 1) == (codes[number-1] >> 1)) {
+	    DBGn(cout<<"tautology removed\n";);
+	    return;                                             // Tautology
+	}
+	codes[number++] = codes[k];
+    }
+
+    if (2*(cl_entries+1) > cl_table_size) {
+	grow_table();
+    }
+    unsigned int hash = hash_codes (codes, number);
+    int pos = hash & (cl_table_size-1);
+    for (; cl_table[pos]; pos = (pos+1) & (cl_table_size-1)) {
+	if (cl_hashes[pos] == hash &&
+	    same_clause (cl_table[pos], codes, number)) {
+	    DBGn(cout<<"duplicate clause removed\n";);
+	    return;
+	}
+    }
+    DBGn(cout<<"creating new clause\n";);
+    SAT_ClausePtr clause = clDB.add_clause();
+    for (int k = 0; k < number; k++) {
+	clDB.add_literal (clause, variables[codes[k] >> 1], codes[k] & 1);
+    }
+    cl_table[pos] = clause;
+    cl_hashes[pos] = hash;
+    cl_entries++;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: end_parse
+//
+// Purpose: Creates the last clause, if not ended by 0, and releases the
+//          hash set of clauses.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::end_parse (SAT_ClauseDatabase &clDB)
+{
+    end_clause (clDB);
+    clear_table();
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: same_clause
+//
+// Purpose: Returns TRUE if a clause created has exactly the literals of a
+//          normalized clause.
+// ----------------------------------------------------------------------------
+
+int CNF_Parser::same_clause (SAT_ClausePtr clause, int *codes, int size)
+{
+    if (clause->literals().size() != size) {
+	return FALSE;
+    }
+    int k = 0;
+    for_each(plit, clause->literals(), LiteralPtr) {
+	LiteralPtr lit = plit->data();
+	if (lit->variable() != variables[codes[k] >> 1] ||
+	    lit->sign() != (codes[k] & 1)) {
+	    return FALSE;
+	}
+	k++;
+    }
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: grow_table
+//
+// Purpose: Doubles the size of the hash set of clauses.
+//
+// Notes: The hash set uses open addressing, and its size is a power of 2.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::grow_table()
+{
+    int orig_size = cl_table_size;
+    SAT_ClausePtr *orig_table = cl_table;
+    unsigned int *orig_hashes = cl_hashes;
+
+    cl_table_size = (orig_size) ? 2*orig_size : 1024;
+    cl_table = new SAT_ClausePtr[cl_table_size];
+    cl_hashes = new unsigned int[cl_table_size];
+    for (int k = 0; k < cl_table_size; k++) {
+	cl_table[k] = NULL;
+    }
+    for (int k = 0; k < orig_size; k++) {
+	if (orig_table[k]) {
+	    int pos = orig_hashes[k] & (cl_table_size-1);
+	    while (cl_table[pos]) {
+		pos = (pos+1) & (cl_table_size-1);
+	    }
+	    cl_table[pos] = orig_table[k];
+	    cl_hashes[pos] = orig_hashes[k];
+	}
+    }
+    delete[] orig_table;
+    delete[] orig_hashes;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: clear_table
+//
+// Purpose: Releases the hash set of clauses.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::clear_table()
+{
+    delete[] cl_table;
+    delete[] cl_hashes;
+    cl_table = NULL;
+    cl_hashes = NULL;
+    cl_table_size = cl_entries = 0;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: add_variables
+//
+// Purpose: Creates the variables of an instance, with indexes 0 to
+//          var_num-1.
+// ----------------------------------------------------------------------------
+
+void CNF_Parser::add_variables (int var_num, SAT_ClauseDatabase &clDB)
+{
+    if (var_num > variables.size()) {              // Array is reused otherwise
+	variables.resize (var_num);
+    }
+    for (int k = 0; k < var_num; k++) {
+	char *name = var_name (k);
+
+	DBGn(cout<<"defining var: "<<name<<" for index "<<k<<endl;);
+	variables[k] = clDB.add_variable (name);
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: var_name
+//
+// Purpose: Returns the name of the variable with index idx, ie idx+1.
+//
+// Side-effects: Names are created once and shared by all instances loaded
+//               by the parser.
+//
+// Notes: Names are not deleted, since variables may outlive the parser.
+// ----------------------------------------------------------------------------
+
+char *CNF_Parser::var_name (int idx)
+{
+    if (idx >= names.size()) {
+	int orig_size = names.size();
+	names.resize ((idx >= 2*orig_size) ? idx+1 : 2*orig_size);
+	for (int k = orig_size; k < names.size(); k++) {
+	    names[k] = NULL;
+	}
+    }
+    if (!names[idx]) {
+	char word_buffer[MAX_WORD_LENGTH];
+	sprintf (word_buffer, "%d", idx+1);
+	names[idx] = new char[strlen (word_buffer)+1];
+	strcpy (names[idx], word_buffer);
+    }
+    return names[idx];
+}
+
 /*****************************************************************************/
 
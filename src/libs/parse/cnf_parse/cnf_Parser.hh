@@ -7,14 +7,85 @@
 //
 // History: 6/21/95 - JPMS - created.
 //          3/16/96 - JPMS - repackaged for new version of GRASP.
+//          10/19/26 - agent - loading of images of CNF formulas.
+//          10/19/26 - agent - loading of CNF files in chunks, with threads.
+//          10/19/26 - agent - loading of compressed CNF files.
+//          10/19/26 - agent - normalization of clauses when loading.
+//          10/19/26 - agent - projection variables of CNF files.
+//          10/19/26 - agent - projection lines read in chunks.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
 
+#include <pthread.h>
+
 #include "defs.hh"
 #include "array.hh"
 #include "grp_SAT.hh"        // Only requires ability to create clause database
+#include "cnf_Image.hh"
+#include "cnf_Scanner.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for loading CNF files in chunks.
+//-----------------------------------------------------------------------------
 
+# define CNF_CHUNK_SIZE  (1 << 22)     // Min bytes of clauses for each chunk
+
+class CNF_Parser;
+
+
+//-----------------------------------------------------------------------------
+// Class: CNF_Chunk
+//
+// Purpose: Range of a CNF file scanned by a thread. The literals found are
+//          coded as +/-(ID+1), and each clause ends with 0. Variables of
+//          projection lines found are kept as well.
+//-----------------------------------------------------------------------------
+
+class CNF_Chunk {
+  public:
+    CNF_Chunk() : _lits(0), _proj(0) { _parser = NULL; _begin = _end = NULL;
+				       _lit_number = 0; _proj_number = 0;
+				       _status = TRUE; }
+    virtual ~CNF_Chunk() {}
+
+    inline CNF_Parser *&parser() { return _parser; }
+    inline char *&begin() { return _begin; }
+    inline char *&end() { return _end; }
+    inline Array<int> &lits() { return _lits; }
+    inline int &lit_number() { return _lit_number; }
+    inline Array<int> &proj() { return _proj; }
+    inline int &proj_number() { return _proj_number; }
+    inline int &status() { return _status; }
+    inline pthread_t &thread() { return _thread; }
+
+  protected:
+    CNF_Parser *_parser;
+    char *_begin;                                 // Range of the file
+    char *_end;
+    Array<int> _lits;                             // Literals found
+    int _lit_number;                              // Entries of _lits
+    Array<int> _proj;                             // Projection variables
+    int _proj_number;
+    int _status;                                  // FALSE if problem line
+    pthread_t _thread;
+};
+
+typedef CNF_Chunk *CNF_ChunkPtr;
+
+
+//-----------------------------------------------------------------------------
+// Class: CNF_Parser
+//
+// Purpose: Creates clause databases from CNF files or images. Large files
+//          can be scanned by threads, one for each chunk of the file.
+//
+// Notes: Clauses of CNF files are normalized, ie literals are sorted and
+//        repeated literals removed, and tautologies and duplicate clauses
+//        are not created. Literals of clauses being normalized are coded
+//        as 2*ID+sign.
+//-----------------------------------------------------------------------------
 
 class CNF_Parser {
 
@@ -24,19 +95,96 @@ public:
     // Constructor/destructor.
     //-------------------------------------------------------------------------
 
-    CNF_Parser() : variables(0) {}
+    CNF_Parser() : variables(0), names(0), chunks(0), cur_lits(0),
+		   proj_vars(0) {
+	load_threads = 1; cl_table = NULL; cl_hashes = NULL;
+	cl_table_size = cl_entries = 0; start_parse();
+    }
     virtual ~CNF_Parser() {
 	variables.resize(0);
+	names.resize(0);                 // Names are still used by variables
+	for (int k = 0; k < chunks.size(); k++) {
+	    delete chunks[k];
+	}
+	chunks.resize(0);
+	cur_lits.resize(0);
+	proj_vars.resize(0);
+	clear_table();
     }
 
     //-------------------------------------------------------------------------
-    // Interface contract: create clause DB from a file in CNF format.
+    // Interface contract: create clause DB from a file in CNF format,
+    // possibly compressed, or from an image of a CNF formula (see
+    // cnf_Image.hh).
     //-------------------------------------------------------------------------
 
     int load_CDB (char *name, SAT_ClauseDatabase &clDB);
+    int load_image (char *name, SAT_ClauseDatabase &clDB);
+    int load_stream (char *name, int format, SAT_ClauseDatabase &clDB);
+
+    inline void set_threads (int nthreads) {     // Threads for loading files
+	load_threads = (nthreads > 1) ? nthreads : 1;
+    }
+
+    //-------------------------------------------------------------------------
+    // Projection variables, given by comment lines "c ind <vars> 0" or
+    // "c p show <vars> 0" of the file last loaded, as indices.
+    //-------------------------------------------------------------------------
+
+    inline int projection_size() { return proj_number; }
+    inline int projection (int k) { return proj_vars[k]; }
+
+    //-------------------------------------------------------------------------
+    // Function executed by the thread of each chunk.
+    //-------------------------------------------------------------------------
+
+    void scan_chunk (CNF_ChunkPtr chunk);
 
 private:
+    inline void start_parse() {
+	cur_var_num = 0; cur_size = 0; in_comment = FALSE; proj_number = 0;
+    }
+    inline void add_literal (int vID) {           // Literal coded as +/-(ID+1)
+	int sign = FALSE;
+	if (vID < 0)  { vID = -vID; sign = TRUE; }
+	if (vID > cur_var_num) {
+	    Abort("Variable index exceeds number of variables");
+	}
+	if (cur_size >= cur_lits.size()) {
+	    cur_lits.resize (2*cur_size + 16);
+	}
+	cur_lits[cur_size++] = 2*(vID-1) + sign;
+    }
+    void end_clause (SAT_ClauseDatabase &clDB);
+    void end_parse (SAT_ClauseDatabase &clDB);
+    void parse_tokens (CNF_Scanner &scanner, int last,
+		       SAT_ClauseDatabase &clDB);
+    void parse_projection (char *pos, char *eol, Array<int> &vars,
+			   int &number);
+    char *var_name (int idx);
+    void add_variables (int var_num, SAT_ClauseDatabase &clDB);
+    void add_literals (int *lits, int *end_lits, SAT_ClauseDatabase &clDB);
+    void load_chunks (char *begin, char *end, SAT_ClauseDatabase &clDB);
+    int same_clause (SAT_ClausePtr clause, int *codes, int size);
+    void grow_table();
+    void clear_table();
+
     Array<SAT_VariablePtr> variables;     // Array for ID to pointer conversion
+    Array<char*> names;            // Variable names, reused by loaded instances
+    Array<CNF_ChunkPtr> chunks;                  // Chunks of the file loaded
+    int load_threads;                             // Threads for loading files
+
+    int cur_var_num;                   // State of the parser between ranges
+    Array<int> cur_lits;                           // Clause being read
+    int cur_size;
+    int in_comment;                                // Inside a comment line
+    Array<int> proj_vars;                       // Projection variables
+    int proj_number;
+
+    SAT_ClausePtr *cl_table;              // Hash set of the clauses created
+    unsigned int *cl_hashes;                      // Hash of each clause
+    int cl_table_size;
+    int cl_entries;
 
 };
 
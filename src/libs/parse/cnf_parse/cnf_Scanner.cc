@@ -0,0 +1,139 @@
+//-----------------------------------------------------------------------------
+// File: cnf_Scanner.cc
+//
+// Purpose: Mapping and scanning of CNF files.
+//
+// Remarks: With SSE2, a window of 64 bytes is classified with four loads
+//          and comparisons. Windows that extend past the end of the range
+//          are classified byte by byte, since reading past the end of a
+//          mapping is not safe.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "cnf_Scanner.hh"
+
+
+// ----------------------------------------------------------------------------
+// Function: map
+//
+// Purpose: Maps a file read-only. Returns FALSE if the file cannot be
+//          opened or mapped.
+//
+// Notes: Empty files are not mapped, ie begin() and end() are NULL.
+// ----------------------------------------------------------------------------
+
+int CNF_Text::map (char *fname)
+{
+    unmap();
+    int fd = open (fname, O_RDONLY);
+    if (fd < 0) {
+	return FALSE;
+    }
+    struct stat fstatus;
+    if (fstat (fd, &fstatus) < 0) {
+	close (fd);
+	return FALSE;
+    }
+    if (fstatus.st_size == 0) {
+	close (fd);
+	return TRUE;
+    }
+    void *area = mmap (NULL, fstatus.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (area == MAP_FAILED) {
+	return FALSE;
+    }
+    _data = (char*) area;
+    _size = fstatus.st_size;
+    madvise (area, _size, MADV_SEQUENTIAL);
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: unmap
+//
+// Purpose: Unmaps the file, if any.
+// ----------------------------------------------------------------------------
+
+void CNF_Text::unmap()
+{
+    if (_data) {
+	munmap (_data, _size);
+	_data = NULL;
+	_size = 0;
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: line_end
+//
+// Purpose: Returns the position of the next newline, or the end of the
+//          range if there is none.
+// ----------------------------------------------------------------------------
+
+char *CNF_Scanner::line_end()
+{
+    char *eol = (char*) memchr (_pos, '\n', _end - _pos);
+    return (eol) ? eol : _end;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: skip_line
+//
+// Purpose: Moves the current position past the next newline.
+// ----------------------------------------------------------------------------
+
+void CNF_Scanner::skip_line()
+{
+    _pos = line_end();
+    if (_pos < _end) { _pos++; }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: blank_mask
+//
+// Purpose: Returns the mask of blank characters in the window starting at
+//          wstart. Bit k is set if character k is blank or past the end.
+// ----------------------------------------------------------------------------
+
+CNF_Mask CNF_Scanner::blank_mask (char *wstart, char *wend)
+{
+    CNF_Mask mask = 0;
+#ifdef __SSE2__
+    if (wend - wstart >= CNF_WINDOW_SIZE) {
+	const __m128i limit = _mm_set1_epi8 (' ');
+	for (int k = 0; k < CNF_WINDOW_SIZE; k += 16) {
+	    __m128i chars = _mm_loadu_si128 ((__m128i*) (wstart + k));
+	    __m128i blanks =                         // max(c,' ') == ' ' iff blank
+		_mm_cmpeq_epi8 (_mm_max_epu8 (chars, limit), limit);
+	    mask |= ((CNF_Mask) (unsigned) _mm_movemask_epi8 (blanks)) << k;
+	}
+	return mask;
+    }
+#endif
+    for (int k = 0; k < CNF_WINDOW_SIZE; k++) {
+	if (wstart + k >= wend || (unsigned char) wstart[k] <= ' ') {
+	    mask |= ((CNF_Mask) 1) << k;
+	}
+    }
+    return mask;
+}
+
+/*****************************************************************************/
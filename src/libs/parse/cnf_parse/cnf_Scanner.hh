@@ -0,0 +1,151 @@
+//-----------------------------------------------------------------------------
+// File: cnf_Scanner.hh
+//
+// Purpose: Class declarations for scanning CNF files mapped in memory.
+//          Tokens are found from masks of blank characters, computed for
+//          windows of 64 bytes (with SSE2 if available), and integers are
+//          converted in place, ie without copying tokens.
+//
+// Remarks: Blank characters are all characters not above ' ', hence lines
+//          can have any length.
+//
+// History: 10/19/26 - agent - created.
+//          10/19/26 - agent - end of range is available to the parser.
+//-----------------------------------------------------------------------------
+
+#ifndef __CNF_SCANNER__
+#define __CNF_SCANNER__
+
+#include <stddef.h>
+
+#include "defs.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for scanning CNF files.
+//-----------------------------------------------------------------------------
+
+# define CNF_WINDOW_SIZE  64                   // Bits of a mask of blanks
+
+typedef unsigned long long CNF_Mask;
+
+
+//-----------------------------------------------------------------------------
+// Class: CNF_Text
+//
+// Purpose: Read-only mapping of a (text) CNF file.
+//-----------------------------------------------------------------------------
+
+class CNF_Text {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    CNF_Text() { _data = NULL; _size = 0; }
+    virtual ~CNF_Text() { unmap(); }
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    virtual int map (char *fname);
+    virtual void unmap();
+
+    inline char *begin() { return _data; }
+    inline char *end() { return _data + _size; }
+    inline size_t size() { return _size; }
+
+protected:
+    char *_data;                                 // Mapped file, if any
+    size_t _size;
+
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: CNF_Scanner
+//
+// Purpose: Splits a range of characters into tokens.
+//-----------------------------------------------------------------------------
+
+class CNF_Scanner {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    CNF_Scanner (char *nbegin, char *nend) {
+	_pos = nbegin; _end = nend; load_window (nbegin);
+    }
+    virtual ~CNF_Scanner() {}
+
+    //-------------------------------------------------------------------------
+    // Interface contract. next_token() returns the start of the next token,
+    // or NULL if there are no more tokens, and token_end() then points
+    // right after the token.
+    //-------------------------------------------------------------------------
+
+    inline char *next_token() {
+	for (;;) {                                   // Find start of token
+	    if (_pos >= _end) {
+		return NULL;
+	    }
+	    if (_pos >= _window + CNF_WINDOW_SIZE) { load_window (_pos); }
+	    CNF_Mask chars = ~_blanks >> (_pos - _window);
+	    if (chars) {
+		_pos += __builtin_ctzll (chars);
+		break;
+	    }
+	    _pos = _window + CNF_WINDOW_SIZE;
+	}
+	char *start = _pos;
+	for (;;) {                                     // Find end of token
+	    if (_pos >= _window + CNF_WINDOW_SIZE) { load_window (_pos); }
+	    CNF_Mask blanks = _blanks >> (_pos - _window);
+	    if (blanks) {
+		_pos += __builtin_ctzll (blanks);
+		break;
+	    }
+	    _pos = _window + CNF_WINDOW_SIZE;
+	}
+	if (_pos > _end) { _pos = _end; }
+	return start;
+    }
+    inline char *token_end() { return _pos; }
+    inline char *range_end() { return _end; }
+
+    char *line_end();                        // End of the current line
+    void skip_line();                              // Skip rest of the line
+
+    static inline int token_value (char *tok, char *tok_end) {
+	int sign = FALSE, value = 0;                   // As atoi() would do
+	if (tok < tok_end && (*tok == '-' || *tok == '+')) {
+	    sign = (*tok++ == '-');
+	}
+	for (; tok < tok_end && *tok >= '0' && *tok <= '9'; tok++) {
+	    value = 10*value + (*tok - '0');
+	}
+	return (sign) ? -value : value;
+    }
+
+protected:
+    inline void load_window (char *wstart) {
+	_window = wstart; _blanks = blank_mask (wstart, _end);
+    }
+    static CNF_Mask blank_mask (char *wstart, char *wend);
+
+    char *_pos;                                  // Current position
+    char *_end;
+    char *_window;                               // Start of current window
+    CNF_Mask _blanks;                            // Blanks of current window
+
+};
+
+#endif // __CNF_SCANNER__
+
+/*****************************************************************************/
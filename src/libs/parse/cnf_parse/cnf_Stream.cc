@@ -0,0 +1,301 @@
+//-----------------------------------------------------------------------------
+// File: cnf_Stream.cc
+//
+// Purpose: Member functions of streams of compressed CNF files.
+//
+// Remarks: The reading thread only fills free buffers, and the parser only
+//          uses buffers handed to it, hence buffers are never shared.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+
+#include "cnf_Stream.hh"
+
+
+//-----------------------------------------------------------------------------
+// Local functions.
+//-----------------------------------------------------------------------------
+
+static void *stream_thread (void *arg)
+{
+    ((CNF_Stream*) arg)->read_buffers();
+    return NULL;
+}
+
+static const char *decompressor (int format)
+{
+    switch (format) {
+    case CNF_GZIP:   return "gzip";
+    case CNF_XZ:     return "xz";
+    case CNF_BZIP2:  return "bzip2";
+    case CNF_ZSTD:   return "zstd";
+    }
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+CNF_Stream::CNF_Stream() : _buffers(0), _lengths(0)
+{
+    _fd = NONE;
+    _pid = NONE;
+    _running = FALSE;
+    _failed = FALSE;
+    pthread_mutex_init (&_lock, NULL);
+    pthread_cond_init (&_filled_cond, NULL);
+    pthread_cond_init (&_free_cond, NULL);
+}
+
+CNF_Stream::~CNF_Stream()
+{
+    close();
+    for (int k = 0; k < _buffers.size(); k++) {
+	delete[] _buffers[k];
+    }
+    _buffers.resize (0);
+    _lengths.resize (0);
+    pthread_mutex_destroy (&_lock);
+    pthread_cond_destroy (&_filled_cond);
+    pthread_cond_destroy (&_free_cond);
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: compression
+//
+// Purpose: Identifies the compression format of a file from its magic
+//          bytes. Returns CNF_PLAIN if the file is not compressed, or if
+//          it cannot be read.
+// ----------------------------------------------------------------------------
+
+int CNF_Stream::compression (char *fname)
+{
+    unsigned char magic[6];
+    int fd = ::open (fname, O_RDONLY);
+    if (fd < 0) {
+	return CNF_PLAIN;
+    }
+    int size = read (fd, magic, 6);
+    ::close (fd);
+
+    if (size >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+	return CNF_GZIP;
+    }
+    if (size >= 6 && !memcmp (magic, "\xfd" "7zXZ\0", 6)) {
+	return CNF_XZ;
+    }
+    if (size >= 3 && !memcmp (magic, "BZh", 3)) {
+	return CNF_BZIP2;
+    }
+    if (size >= 4 && !memcmp (magic, "\x28\xb5\x2f\xfd", 4)) {
+	return CNF_ZSTD;
+    }
+    return CNF_PLAIN;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: open
+//
+// Purpose: Starts the decompressor of a file, and the thread that reads its
+//          output. Returns FALSE if either cannot be started.
+// ----------------------------------------------------------------------------
+
+int CNF_Stream::open (char *fname, int format)
+{
+    close();
+    const char *prog = decompressor (format);
+    int out_pipe[2];
+    if (!prog || pipe (out_pipe) < 0) {
+	return FALSE;
+    }
+    int pid = fork();
+    if (pid < 0) {
+	::close (out_pipe[0]);
+	::close (out_pipe[1]);
+	return FALSE;
+    }
+    else if (pid == 0) {                                  // Decompressor process
+	dup2 (out_pipe[1], 1);
+	::close (out_pipe[0]);
+	::close (out_pipe[1]);
+	execlp (prog, prog, "-dc", fname, (char*) NULL);
+	_exit (127);
+    }
+    ::close (out_pipe[1]);
+    _fd = out_pipe[0];
+    _pid = pid;
+
+    if (_buffers.size() == 0) {                // Buffers are reused otherwise
+	_buffers.resize (CNF_STREAM_BUFFERS);
+	_lengths.resize (CNF_STREAM_BUFFERS);
+	for (int k = 0; k < CNF_STREAM_BUFFERS; k++) {
+	    _buffers[k] = new char[2*CNF_STREAM_BUFFER_SIZE];
+	}
+    }
+    _fill_pos = _use_pos = 0;
+    _filled = 0;
+    _free = CNF_STREAM_BUFFERS;
+    _eof = _stop = _failed = FALSE;
+
+    if (pthread_create (&_thread, NULL, stream_thread, (void*) this)) {
+	close();
+	return FALSE;
+    }
+    _running = TRUE;
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: close
+//
+// Purpose: Stops the reading thread and waits for the decompressor. Returns
+//          FALSE if the decompressor failed, or if the output was not read
+//          to the end.
+// ----------------------------------------------------------------------------
+
+int CNF_Stream::close()
+{
+    if (_pid == NONE) {
+	return TRUE;
+    }
+    int complete = TRUE;
+    if (_running) {
+	pthread_mutex_lock (&_lock);
+	_stop = TRUE;
+	complete = _eof && !_filled;
+	pthread_cond_broadcast (&_free_cond);
+	pthread_mutex_unlock (&_lock);
+	if (!complete) {
+	    kill (_pid, SIGTERM);                      // Reader may be blocked
+	}
+	pthread_join (_thread, NULL);
+	_running = FALSE;
+    }
+    ::close (_fd);
+    int status;
+    if (waitpid (_pid, &status, 0) < 0 ||
+	!WIFEXITED (status) || WEXITSTATUS (status) != 0) {
+	complete = FALSE;
+    }
+    _fd = NONE;
+    _pid = NONE;
+    return complete && !_failed;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: next_buffer
+//
+// Purpose: Returns the next filled buffer, and its length, waiting for
+//          the reading thread if necessary. Returns NULL at the end of the
+//          output of the decompressor.
+// ----------------------------------------------------------------------------
+
+char *CNF_Stream::next_buffer (int &length)
+{
+    char *data = NULL;
+    pthread_mutex_lock (&_lock);
+    while (!_filled && !_eof) {
+	pthread_cond_wait (&_filled_cond, &_lock);
+    }
+    if (_filled) {
+	length = _lengths[_use_pos];
+	data = _buffers[_use_pos] + CNF_STREAM_BUFFER_SIZE;
+	_use_pos = (_use_pos + 1) % CNF_STREAM_BUFFERS;
+	_filled--;
+	if (length == 0) {                           // Last buffer is empty
+	    _free++;
+	    data = NULL;
+	}
+    }
+    pthread_mutex_unlock (&_lock);
+    return data;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: release_buffer
+//
+// Purpose: Returns the oldest buffer handed to the parser to the ring.
+// ----------------------------------------------------------------------------
+
+void CNF_Stream::release_buffer()
+{
+    pthread_mutex_lock (&_lock);
+    _free++;
+    pthread_cond_signal (&_free_cond);
+    pthread_mutex_unlock (&_lock);
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: read_buffers
+//
+// Purpose: Reads the output of the decompressor into free buffers, until
+//          the end of the output or until the stream is closed.
+//
+// Notes: A buffer is handed once it is full, hence the first buffer that
+//        is not full is the last one.
+// ----------------------------------------------------------------------------
+
+void CNF_Stream::read_buffers()
+{
+    for (;;) {
+	pthread_mutex_lock (&_lock);
+	while (!_free && !_stop) {
+	    pthread_cond_wait (&_free_cond, &_lock);
+	}
+	int pos = _fill_pos;
+	int stop = _stop;
+	pthread_mutex_unlock (&_lock);
+	if (stop) {
+	    break;
+	}
+
+	char *data = _buffers[pos] + CNF_STREAM_BUFFER_SIZE;
+	int length = 0;
+	while (length < CNF_STREAM_BUFFER_SIZE) {
+	    int size = read (_fd, data + length, CNF_STREAM_BUFFER_SIZE - length);
+	    if (size < 0 && errno == EINTR) {
+		continue;
+	    }
+	    if (size < 0) {
+		_failed = TRUE;
+	    }
+	    if (size <= 0) {
+		break;
+	    }
+	    length += size;
+	}
+
+	pthread_mutex_lock (&_lock);
+	_lengths[pos] = length;
+	_fill_pos = (pos + 1) % CNF_STREAM_BUFFERS;
+	_free--;
+	_filled++;
+	if (length < CNF_STREAM_BUFFER_SIZE) {
+	    _eof = TRUE;
+	}
+	pthread_cond_signal (&_filled_cond);
+	pthread_mutex_unlock (&_lock);
+	if (length < CNF_STREAM_BUFFER_SIZE) {
+	    break;
+	}
+    }
+}
+
+/*****************************************************************************/
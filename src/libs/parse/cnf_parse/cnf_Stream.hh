@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// File: cnf_Stream.hh
+//
+// Purpose: Class declaration of streams of compressed CNF files. A stream
+//          runs the decompressor of the file in a child process, and a
+//          thread reads its output into a ring of fixed-size buffers, which
+//          are handed to the parser as they are filled. Hence decompression
+//          and parsing overlap, and no temporary files are created.
+//
+// Remarks: The format of a file is identified by its magic bytes. The
+//          decompressors (gzip, xz, bzip2 and zstd) are found in the PATH.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __CNF_STREAM__
+#define __CNF_STREAM__
+
+#include <sys/types.h>
+#include <pthread.h>
+
+#include "defs.hh"
+#include "array.hh"
+
+
+//-----------------------------------------------------------------------------
+// Defines for streams of compressed files.
+//-----------------------------------------------------------------------------
+
+# define CNF_STREAM_BUFFER_SIZE  (1 << 20)        // Bytes read into a buffer
+# define CNF_STREAM_BUFFERS      4                // Buffers in the ring
+
+enum CNF_Compression {
+    CNF_PLAIN = 0,
+    CNF_GZIP,
+    CNF_XZ,
+    CNF_BZIP2,
+    CNF_ZSTD
+    };
+
+
+//-----------------------------------------------------------------------------
+// Class: CNF_Stream
+//
+// Purpose: Output of the decompressor of a file, split into buffers. Each
+//          buffer is preceded by CNF_STREAM_BUFFER_SIZE free bytes, which
+//          the parser may use to prepend text left over from the previous
+//          buffer.
+//
+// Notes: Buffers are handed in order, and are released in the same order.
+//-----------------------------------------------------------------------------
+
+class CNF_Stream {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    CNF_Stream();
+    virtual ~CNF_Stream();
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    static int compression (char *fname);        // CNF_PLAIN if not compressed
+
+    virtual int open (char *fname, int format);
+    virtual int close();                       // FALSE if decompression failed
+
+    virtual char *next_buffer (int &length);           // NULL at end of file
+    virtual void release_buffer();                    // Oldest buffer handed
+
+    //-------------------------------------------------------------------------
+    // Function executed by the reading thread.
+    //-------------------------------------------------------------------------
+
+    virtual void read_buffers();
+
+protected:
+    int _fd;                                     // Output of decompressor
+    pid_t _pid;                                  // Decompressor process
+    pthread_t _thread;
+    int _running;                                // Whether thread was created
+    int _failed;                                 // Read errors
+
+    Array<char*> _buffers;                       // Ring of buffers
+    Array<int> _lengths;                         // Bytes in filled buffers
+    int _fill_pos;                               // Next buffer to fill
+    int _use_pos;                                // Next buffer to hand
+    int _filled;                                 // Buffers filled, not handed
+    int _free;                                   // Buffers free for reading
+    int _eof;                                    // End of output was read
+    int _stop;                                   // Thread must terminate
+
+    pthread_mutex_t _lock;                       // Protects the ring
+    pthread_cond_t _filled_cond;
+    pthread_cond_t _free_cond;
+
+};
+
+#endif // __CNF_STREAM__
+
+/*****************************************************************************/
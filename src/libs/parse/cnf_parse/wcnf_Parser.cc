@@ -0,0 +1,230 @@
+//-----------------------------------------------------------------------------
+// File: wcnf_Parser.cc
+//
+// Purpose: Realization of a parser that reads a MaxSAT instance from a file
+//          in wcnf format, and gives its clauses to the MaxSAT engine.
+//
+// Remarks: Files are scanned as CNF files (see cnf_Scanner.hh).
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "wcnf_Parser.hh"
+#include "cnf_Stream.hh"
+
+
+// ----------------------------------------------------------------------------
+// Function: is_wcnf
+//
+// Purpose: Returns TRUE if the name of the file has the extension .wcnf,
+//          possibly followed by that of compression.
+// ----------------------------------------------------------------------------
+
+int WCNF_Parser::is_wcnf (char *fname)
+{
+    char *ext = strstr (fname, ".wcnf");
+    return (ext && (ext[5] == '\0' || ext[5] == '.'));
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: load
+//
+// Purpose: Gives the clauses of a wcnf file to the MaxSAT engine.
+//
+// Side-effects: Hard and soft clauses are added to the engine.
+//
+// Notes: Malformed files abort, as CNF files do.
+// ----------------------------------------------------------------------------
+
+int WCNF_Parser::load (char *fname, SAT_MaxSAT &maxsat)
+{
+    var_num = lit_number = 0;
+    top = weight = NONE;
+    in_clause = FALSE;
+
+    int format = CNF_Stream::compression (fname);
+    if (format != CNF_PLAIN) {
+	int length = read_stream (fname, format);
+	if (length < 0) {
+	    return FALSE;
+	}
+	CNF_Scanner scanner (&text[0], &text[0] + length);
+	parse_tokens (scanner, maxsat);
+    }
+    else {
+	CNF_Text file;
+	if (!file.map (fname)) {
+	    return FALSE;
+	}
+	CNF_Scanner scanner (file.begin(), file.end());
+	parse_tokens (scanner, maxsat);
+    }
+    if (in_clause) {                              // Last clause not ended by 0
+	end_clause (maxsat);
+    }
+    return TRUE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: read_stream
+//
+// Purpose: Decompresses a file into memory, and returns its length, or -1
+//          if the file cannot be decompressed.
+// ----------------------------------------------------------------------------
+
+int WCNF_Parser::read_stream (char *fname, int format)
+{
+    CNF_Stream stream;
+    if (!stream.open (fname, format)) {
+	return -1;
+    }
+    int length = 0;
+    char *data;
+    int size;
+    while ((data = stream.next_buffer (size))) {
+	if (length + size + 1 > text.size()) {
+	    text.resize (2*text.size() + size + 1);
+	}
+	memcpy (&text[length], data, size);
+	length += size;
+	stream.release_buffer();
+    }
+    if (!stream.close()) {
+	return -1;
+    }
+    if (!text.size()) {
+	text.resize (1);
+    }
+    return length;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: parse_tokens
+//
+// Purpose: Reads the clauses in the range of a scanner.
+//
+// Side-effects: Clauses are added to the engine as they end.
+//
+// Notes: Comment, problem and hard lines are identified by their first
+//        token, which must then start a clause. Clauses of cnf files
+//        start with their first literal.
+// ----------------------------------------------------------------------------
+
+void WCNF_Parser::parse_tokens (CNF_Scanner &scanner, SAT_MaxSAT &maxsat)
+{
+    char *tok;
+    while ((tok = scanner.next_token())) {
+	if (!in_clause && *tok == 'c') {
+	    scanner.skip_line();
+	}
+	else if (!in_clause && *tok == 'p') {    // p wcnf <vars> <cls> [<top>]
+	    char *eol = scanner.line_end();
+	    char *fmt = scanner.next_token();
+	    char *vtok = scanner.next_token();
+	    if (vtok) {
+		var_num = CNF_Scanner::token_value (vtok, scanner.token_end());
+	    }
+	    char *ctok = scanner.next_token();
+	    if (!ctok || ctok >= eol || var_num < 0) {
+		Abort("Unable to read number of variables and clauses");
+	    }
+	    if (!strncmp (fmt, "wcnf", 4)) {
+		top = LONG_MAX;
+		char *ttok = scanner.token_end();
+		while (ttok < eol && (unsigned char) *ttok <= ' ') { ttok++; }
+		if (ttok < eol) {                           // Top weight given
+		    ttok = scanner.next_token();
+		    top = token_weight (ttok, scanner.token_end());
+		}
+	    }
+	    else if (!strncmp (fmt, "cnf", 3)) {
+		top = 0;                             // Clauses have no weights
+	    }
+	    else {
+		Abort("Unknown format of problem line");
+	    }
+	}
+	else {
+	    if (!in_clause) {                              // Start of a clause
+		in_clause = TRUE;
+		if (top != 0) {                          // Token is the weight
+		    if (*tok == 'h' && top == NONE) {
+			weight = NONE;
+		    }
+		    else {
+			weight = token_weight (tok, scanner.token_end());
+			if (top != NONE && weight >= top) {
+			    weight = NONE;
+			}
+		    }
+		    continue;
+		}
+		weight = 1;
+	    }
+	    int lit = CNF_Scanner::token_value (tok, scanner.token_end());
+	    if (lit == 0) {
+		end_clause (maxsat);
+		continue;
+	    }
+	    if (var_num && (lit > var_num || -lit > var_num)) {
+		Abort("Variable index exceeds number of variables");
+	    }
+	    if (lit_number >= lits.size()) {
+		lits.resize (2*lit_number + 16);
+	    }
+	    lits[lit_number++] = lit;
+	}
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: end_clause
+//
+// Purpose: Adds the clause read to the engine, as hard or soft.
+// ----------------------------------------------------------------------------
+
+void WCNF_Parser::end_clause (SAT_MaxSAT &maxsat)
+{
+    if (weight == NONE) {
+	maxsat.add_hard (&lits[0], lit_number);
+    }
+    else {
+	maxsat.add_soft (weight, &lits[0], lit_number);
+    }
+    lit_number = 0;
+    in_clause = FALSE;
+}
+
+
+// ----------------------------------------------------------------------------
+// Function: token_weight
+//
+// Purpose: Returns the weight given by a token, which must be a non-negative
+//          integer.
+// ----------------------------------------------------------------------------
+
+long WCNF_Parser::token_weight (char *tok, char *tok_end)
+{
+    long value = 0;
+    if (!tok || tok >= tok_end) {
+	Abort("Missing weight of clause");
+    }
+    for (; tok < tok_end; tok++) {
+	if (*tok < '0' || *tok > '9' || value > (LONG_MAX - 9) / 10) {
+	    Abort("Invalid weight of clause");
+	}
+	value = 10*value + (*tok - '0');
+    }
+    return value;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,76 @@
+//-----------------------------------------------------------------------------
+// File: wcnf_Parser.hh
+//
+// Purpose: Class declaration of a parser for MaxSAT instances in wcnf
+//          format, which gives the clauses to the MaxSAT engine (see
+//          grp_MaxSAT.hh).
+//
+// Remarks: Three formats are read. Files with a problem line "p wcnf
+//          <vars> <clauses> <top>" give the weight of each clause first,
+//          and clauses of weight top or more are hard. Files without a
+//          problem line give the weight of each soft clause first, and
+//          hard clauses start with h. Files with a problem line "p cnf
+//          <vars> <clauses>" only have soft clauses of weight 1.
+//
+// History: 10/19/26 - agent - created.
+//-----------------------------------------------------------------------------
+
+#ifndef __WCNF_PARSER__
+#define __WCNF_PARSER__
+
+#include "defs.hh"
+#include "array.hh"
+#include "grp_MaxSAT.hh"
+#include "cnf_Scanner.hh"
+
+
+//-----------------------------------------------------------------------------
+// Class: WCNF_Parser
+//
+// Purpose: Reads the hard and soft clauses of a wcnf file, possibly
+//          compressed.
+//
+// Notes: Compressed files are decompressed into memory before parsing,
+//        since wcnf files are seldom large. Clauses are not normalized,
+//        which the incremental solver does.
+//-----------------------------------------------------------------------------
+
+class WCNF_Parser {
+
+public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    WCNF_Parser() : lits(16), text(0) {
+	var_num = lit_number = 0; top = weight = NONE; in_clause = FALSE;
+    }
+    virtual ~WCNF_Parser() { lits.resize(0); text.resize(0); }
+
+    //-------------------------------------------------------------------------
+    // Interface contract. load() returns FALSE if the file cannot be read.
+    //-------------------------------------------------------------------------
+
+    static int is_wcnf (char *fname);                     // From the file name
+    int load (char *fname, SAT_MaxSAT &maxsat);
+
+private:
+    int read_stream (char *fname, int format);
+    void parse_tokens (CNF_Scanner &scanner, SAT_MaxSAT &maxsat);
+    void end_clause (SAT_MaxSAT &maxsat);
+    static long token_weight (char *tok, char *tok_end);
+
+    Array<int> lits;                                       // Clause being read
+    int lit_number;
+    Array<char> text;                              // Decompressed file, if any
+    int var_num;                                        // 0 if no problem line
+    long top;                                // Weight of hard clauses, or NONE
+    long weight;                      // Of the clause being read, NONE if hard
+    int in_clause;                                 // Weight of clause was read
+
+};
+
+#endif // __WCNF_PARSER__
+
+/*****************************************************************************/
@@ -20,14 +20,16 @@ void CmdLine::parse (char *str) {
     //
     DBGn(cout<<"\t-> Processing string: "<<str<<endl;);
     char buf[256];
+    char *pos;                         // Reentrant, as threads parse commands
     strncpy (buf,str,256);
-    char *c = strtok (buf, " ");
-    if(!c) c = strtok(0,"\n");
+    buf[255] = '\0';
+    char *c = strtok_r (buf, " ", &pos);
+    if(!c) c = strtok_r(0,"\n",&pos);
     if (c) {
 	_size = 1;
 	args [0] = c;
 	DBGn(cout<<"\t-> String read: "<<args[0].string()<<endl;);
-	while ((c = strtok (0, " ")) || (c = strtok(0,"\n"))) {
+	while ((c = strtok_r (0, " ", &pos)) || (c = strtok_r(0,"\n",&pos))) {
 	    if (_size == MAXARGS) {
 		cout << "Too many command arguments.  "
 		    << "Increase MAXARGS in CmdLine.h" << endl;
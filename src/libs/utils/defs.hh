@@ -7,6 +7,7 @@
 // Remarks: --
 //
 // History: 6/16/95 - JPMS - created, using definitions commont other programs.
+//          10/19/26 - agent - messages given as constant strings.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -31,9 +32,11 @@ typedef unsigned int Boolean;
 //
 //-----------------------------------------------------------------------------
 
-extern void setTrailString(char*), Abort(char*), Warn(char*), Info(char*);
-extern void printItem(), printItem(char*, int), printItem(char*, double);
-extern void printTime(char *msg, double time, char *tmsg);
+extern void setTrailString(char*);
+extern void Abort(const char*), Warn(const char*), Info(const char*);
+extern void printItem(), printItem(const char*, int);
+extern void printItem(const char*, double);
+extern void printTime(const char *msg, double time, const char *tmsg);
 
 
 //-----------------------------------------------------------------------------
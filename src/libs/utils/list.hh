@@ -59,33 +59,17 @@ public:
     inline T& data(const T& n_data) { _data = n_data; return _data; }
 
     //-------------------------------------------------------------------------
-    // Memory management of objects of class ListItem<T>. External variables
-    // have to be used since gcc 2.7.2 does not yet support static variables
-    // in templates.
+    // Memory management of objects of class ListItem<T>. Items are allocated
+    // from the pool bound to the running thread (see memory.hh).
     //-------------------------------------------------------------------------
 
     DMEM(
     inline void *operator new(size_t _size) {
 	// *** if(!mem_defined) init_memory(); DONE BEFORE ALLOCATING ITEMs ***
-	if( !::newList[_size] ) {
-	    STAT(::memblock_allocs[_size]++;)
-	    ::newList[_size] = (void*) new char[ALLOC_BLOCK_SIZE * _size];
-	    register int k;
-	    for( k = 0; k < ALLOC_BLOCK_SIZE-1; k++ ) {
-		((ListItem*)::newList[_size])[k]._next =
-		    &(((ListItem*)::newList[_size])[k+1]);
-	    }
-	    ((ListItem*)::newList[_size])[k]._next = NULL;
-	}
-	STAT(::new_count[_size]++;)
-	ListItem *ret_ptr = (ListItem*) ::newList[_size];
-	::newList[_size] = (void*) ((ListItem*)::newList[_size])->_next;
-	return ret_ptr;
+	return MemPool::current()->alloc (_size);
     }
-    inline void operator delete(void *ptr) {
-	STAT(::del_count[sizeof(ListItem)]++;)
-	((ListItem*)ptr)->_next = (ListItem*) ::newList[sizeof(ListItem)];
-	::newList[sizeof(ListItem)] = ptr;
+    inline void operator delete(void *ptr, size_t _size) {
+	MemPool::release (ptr, _size);
     })
 
 protected:
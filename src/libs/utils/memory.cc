@@ -1,59 +1,248 @@
 //-----------------------------------------------------------------------------
 // File: memory.cc
 //
-// Purpose: Memory management functions for ListItems.
+// Purpose: Memory management functions for ListItems and for classes
+//          declared with MEM_MNG_DECL.
 //
-// Remarks: Required because templates do not permit static variables in
-//          gcc 2.7.2
+// Remarks: Blocks are obtained with mmap, so that empty blocks are really
+//          given back to the operating system.
 //
 // History: 7/2/94 - JPMS - created.
+//          10/19/26 - agent - pools of blocks.
+//          10/19/26 - agent - initialization run once.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
 
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <pthread.h>
 #include <iostream.h>
 
 #include "defs.hh"
 #include "memory.hh"
 
 
-void *newList[MEM_DIM_SIZE];
+MemPool *mem_default_pool = NULL;
+MEM_THREAD_LOCAL MemPool *mem_bound_pool = NULL;
 unsigned long mem_defined = 0;
-unsigned long memblock_allocs[MEM_DIM_SIZE];
-unsigned long new_count[MEM_DIM_SIZE];
-unsigned long del_count[MEM_DIM_SIZE];
+unsigned long mem_block_bytes[MEM_SIZE_NUMBER];
 
+static pthread_once_t mem_once = PTHREAD_ONCE_INIT;
 
-void init_memory()
+
+#define MEM_HEADER_SIZE \
+    ((sizeof(MemBlock) + MEM_ALIGN_SIZE - 1) / MEM_ALIGN_SIZE * MEM_ALIGN_SIZE)
+
+
+//-----------------------------------------------------------------------------
+// Function: setup_memory()
+//
+// Purpose: Computes the size of the blocks for each size of entries, and
+//          creates the default pool.
+//
+// Side-effects: The default pool is used by threads not bound to a pool.
+//-----------------------------------------------------------------------------
+
+static void setup_memory()
 {
     DBG1(cout << "Clearing memory" << endl;);
-    for( register int k = 0; k < MEM_DIM_SIZE; k++ ) {
-	newList[k] = (void*) NULL;
-	memblock_allocs[k] = 0;
-	new_count[k] = 0;
-	del_count[k] = 0;
+    for( register int k = 0; k < MEM_SIZE_NUMBER; k++ ) {
+	unsigned long size = MEM_HEADER_SIZE +
+	    (unsigned long) ALLOC_BLOCK_SIZE * (k * MEM_ALIGN_SIZE);
+	unsigned long bytes = 1;
+	while( bytes < size ) { bytes <<= 1; }
+	mem_block_bytes[k] = bytes;
+    }
+    if( !mem_default_pool ) {
+	mem_default_pool = new MemPool();
     }
     mem_defined = 1;
 }
 
-DMEM(
-STAT(
+
+//-----------------------------------------------------------------------------
+// Function: init_memory()
+//
+// Purpose: Initializes memory management, once.
+//
+// Notes: Threads may invoke it concurrently, eg when creating solvers
+//        through ipasir_init(). Those not running setup_memory() wait
+//        until it completes.
+//-----------------------------------------------------------------------------
+
+void init_memory()
+{
+    pthread_once( &mem_once, setup_memory );
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: print_mem_stats()
+//
+// Purpose: Prints stats of the default pool.
+//-----------------------------------------------------------------------------
+
 void print_mem_stats()
 {
-    cout << "\n  UTILS memory allocation stats:\n";
-    for( register int k = 0; k < MEM_DIM_SIZE; k++ ) {
-	if( memblock_allocs[k] ) {
+    if( mem_default_pool ) {
+	mem_default_pool->print_stats( "default" );
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Constructor/destructor.
+//-----------------------------------------------------------------------------
+
+MemPool::MemPool()
+{
+    _blocks = NULL;
+    for( register int k = 0; k < MEM_SIZE_NUMBER; k++ ) {
+	_avail[k] = NULL;
+    }
+    _retain = FALSE;
+    _block_number = 0;
+    _allocated_bytes = 0;
+    _max_allocated_bytes = 0;
+    STAT(_new_count = 0;
+	 _del_count = 0;)
+}
+
+MemPool::~MemPool()
+{
+    release_all();
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: release_all()
+//
+// Purpose: Gives back all blocks of the pool to the operating system.
+//
+// Side-effects: All objects allocated from the pool become invalid. Their
+//               destructors are *not* invoked.
+//-----------------------------------------------------------------------------
+
+void MemPool::release_all()
+{
+    while( _blocks ) {
+	del_block( _blocks );
+    }
+    for( register int k = 0; k < MEM_SIZE_NUMBER; k++ ) {
+	_avail[k] = NULL;
+    }
+}
 
-	    cout << "    Size of each new: " << k << "    Number of ";
-	    cout << ALLOC_BLOCK_SIZE << " blocks allocated: ";
-	    cout << memblock_allocs[k] << endl;
 
-	    cout << "    Number of NEW calls:    " << new_count[k] << endl;
-	    cout << "    Number of DELETE calls: " << del_count[k] << endl;
+//-----------------------------------------------------------------------------
+// Function: trim()
+//
+// Purpose: Gives back empty blocks to the operating system, even if blocks
+//          are retained. Returns the number of blocks given back.
+//-----------------------------------------------------------------------------
+
+int MemPool::trim()
+{
+    int count = 0;
+    MemBlockPtr block = _blocks;
+    while( block ) {
+	MemBlockPtr next_block = block->_next;
+	if( !block->used() ) {
+	    del_block( block );
+	    count++;
 	}
+	block = next_block;
     }
-}))
+    return count;
+}
 
-/*****************************************************************************/
 
+//-----------------------------------------------------------------------------
+// Function: new_block()
+//
+// Purpose: Creates a new block for entries of a given size. The block is
+//          aligned on its size, by mapping twice the size and unmapping the
+//          excess.
+//
+// Side-effects: The block becomes the first available block for the size.
+//-----------------------------------------------------------------------------
+
+MemBlockPtr MemPool::new_block( int idx )
+{
+    unsigned long bytes = mem_block_bytes[idx];
+    char *area = (char*) mmap( NULL, 2 * bytes, PROT_READ | PROT_WRITE,
+			       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( area == (char*) MAP_FAILED ) {
+	Abort( "Unable to allocate memory block" );
+    }
+    char *start = (char*)
+	(((unsigned long) area + bytes - 1) & ~(bytes - 1));
+    if( start > area ) {
+	munmap( area, start - area );
+    }
+    if( area + 2 * bytes > start + bytes ) {
+	munmap( start + bytes, area + 2 * bytes - (start + bytes) );
+    }
+    MemBlockPtr block = (MemBlockPtr) start;
+    block->_pool = this;
+    block->_prev = NULL;
+    block->_next = _blocks;
+    if( _blocks ) { _blocks->_prev = block; }
+    _blocks = block;
+    block->_free = NULL;
+    block->_fresh = start + MEM_HEADER_SIZE;
+    block->_end = start + bytes;
+    block->_size = idx * MEM_ALIGN_SIZE;
+    block->_used = 0;
+    link_avail( block, idx );
+
+    _block_number++;
+    _allocated_bytes += bytes;
+    if( _allocated_bytes > _max_allocated_bytes ) {
+	_max_allocated_bytes = _allocated_bytes;
+    }
+    return block;
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: del_block()
+//
+// Purpose: Gives back a block to the operating system.
+//-----------------------------------------------------------------------------
+
+void MemPool::del_block( MemBlockPtr block )
+{
+    int idx = block->_size / MEM_ALIGN_SIZE;
+    unsigned long bytes = mem_block_bytes[idx];
+    if( !block->full() ) {
+	unlink_avail( block, idx );
+    }
+    if( block->_prev ) { block->_prev->_next = block->_next; }
+    else               { _blocks = block->_next; }
+    if( block->_next ) { block->_next->_prev = block->_prev; }
+
+    _block_number--;
+    _allocated_bytes -= bytes;
+    munmap( (char*) block, bytes );
+}
+
+
+//-----------------------------------------------------------------------------
+// Function: print_stats()
+//
+// Purpose: Prints stats of the pool.
+//-----------------------------------------------------------------------------
+
+void MemPool::print_stats( const char *name )
+{
+    cout << "\n  Memory stats for pool " << name << ":\n";
+    cout << "    Number of blocks:        " << _block_number << endl;
+    cout << "    Allocated bytes:         " << _allocated_bytes << endl;
+    cout << "    Max allocated bytes:     " << _max_allocated_bytes << endl;
+    STAT(cout << "    Number of NEW calls:     " << _new_count << endl;
+	 cout << "    Number of DELETE calls:  " << _del_count << endl;)
+}
+
+/*****************************************************************************/
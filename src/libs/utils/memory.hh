@@ -2,13 +2,17 @@
 // File: memory.hh
 //
 // Purpose: Basic definitions for memory management in basic data types.
-//          A global list of free storage is maintained, which is accessed
-//          by the allocation methods of basic data types.
+//          Objects are allocated from pools of blocks, each block holding
+//          entries of the same size. Each thread can be bound to its own
+//          pool, and each clause database owns a pool.
 //
 // Remarks: Several ideas for memory management are taken from an early
 //          version of the LEDA software (developed by Stephan Naher).
 //
 // History: 7/2/94 - JPMS - created.
+//          10/19/26 - agent - global free lists replaced by pools of blocks.
+//          10/19/26 - agent - initialization safe across threads.
+//          10/19/26 - agent - atomic counts of stats.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -16,50 +20,242 @@
 #ifndef _MEM_DEF
 #define _MEM_DEF
 
+#include <stddef.h>
 
 #include "defs.hh"
 
 
 //-----------------------------------------------------------------------------
-// Memory management for classes derived from the template ListItem. Size
-// of entries stored in each ListItem must be less then MEM_DIM_SIZE = 4096.
-// I have not been able to compile a cleaner implementation of memory
-// management (see macro definitions below), which does not use external
-// variables.
+// Memory management for ListItems and for classes declared with
+// MEM_MNG_DECL. Size of objects must be less than MEM_DIM_SIZE = 4096,
+// otherwise the global operators new and delete are used. Each block has
+// at least ALLOC_BLOCK_SIZE entries.
 //-----------------------------------------------------------------------------
 
 
 #define ALLOC_BLOCK_SIZE  512
 #define MEM_DIM_SIZE      4096
+#define MEM_ALIGN_SIZE    8                // Sizes are rounded to multiples
+#define MEM_SIZE_NUMBER   (MEM_DIM_SIZE/MEM_ALIGN_SIZE+1)
 
+#define MEM_THREAD_LOCAL  __thread
+#define MEM_COUNT(count)  __sync_fetch_and_add (&(count), 1)
 
-extern void *newList[];
+
+class MemPool;
+
+extern MemPool *mem_default_pool;
+extern MEM_THREAD_LOCAL MemPool *mem_bound_pool;
 extern unsigned long mem_defined;
-extern unsigned long memblock_allocs[];
-extern unsigned long new_count[];
-extern unsigned long del_count[];
+extern unsigned long mem_block_bytes[];
 
 
 extern void init_memory();
 extern void print_mem_stats();
 
 
+//-----------------------------------------------------------------------------
+// Class: MemBlock
+//
+// Purpose: Header of a block of entries of the same size. The size of a
+//          block is a power of 2 and blocks are aligned on their size.
+//          Hence the block of an entry is found by masking its address.
+//-----------------------------------------------------------------------------
+
+class MemBlock {
+    friend class MemPool;
+  public:
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    inline MemPool *pool() { return _pool; }
+    inline int used() { return _used; }
+    inline int full() { return (!_free && _fresh + _size > _end); }
+
+    inline void *get_entry() {
+	void *ptr;
+	if (_free) { ptr = _free; _free = *((void**) ptr); }
+	else       { ptr = _fresh; _fresh += _size; }
+	_used++;
+	return ptr;
+    }
+    inline void put_entry (void *ptr) {
+	*((void**) ptr) = _free;
+	_free = ptr;
+	_used--;
+    }
+
+  protected:
+    MemPool *_pool;                              // Pool that owns the block
+    MemBlock *_prev;                             // Blocks of the pool
+    MemBlock *_next;
+    MemBlock *_prev_avail;                       // Blocks with free entries
+    MemBlock *_next_avail;
+    void *_free;                                 // Released entries
+    char *_fresh;                                // Entries never allocated
+    char *_end;                                  // End of the block
+    int _size;                                   // Size of each entry
+    int _used;                                   // Number of entries in use
+};
+
+typedef MemBlock *MemBlockPtr;
+
+
+//-----------------------------------------------------------------------------
+// Class: MemPool
+//
+// Purpose: Pool of blocks. Entries are allocated from the pool bound to the
+//          running thread (or from the default pool), and are released to
+//          the pool owning their block. Empty blocks are given back to the
+//          operating system, unless blocks are to be retained.
+//
+// Notes: A pool must only be used by one thread at a time. Threads other
+//        than the main one must be bound to their own pool before objects
+//        are allocated.
+//-----------------------------------------------------------------------------
+
+class MemPool {
+  public:
+
+    //-------------------------------------------------------------------------
+    // Constructor/destructor.
+    //-------------------------------------------------------------------------
+
+    MemPool();
+    virtual ~MemPool();
+
+    //-------------------------------------------------------------------------
+    // Interface contract.
+    //-------------------------------------------------------------------------
+
+    inline void *alloc (size_t size) {
+	if (size > MEM_DIM_SIZE) { return ::operator new (size); }
+	int idx = (size + MEM_ALIGN_SIZE - 1) / MEM_ALIGN_SIZE;
+	MemBlockPtr block = _avail[idx];
+	if (!block) { block = new_block (idx); }
+	void *ptr = block->get_entry();
+	if (block->full()) { unlink_avail (block, idx); }
+	STAT(MEM_COUNT (_new_count);)
+	return ptr;
+    }
+    static inline void release (void *ptr, size_t size) {
+	if (size > MEM_DIM_SIZE) { ::operator delete (ptr); return; }
+	int idx = (size + MEM_ALIGN_SIZE - 1) / MEM_ALIGN_SIZE;
+	MemBlockPtr block = (MemBlockPtr)
+	    ((unsigned long) ptr & ~(mem_block_bytes[idx] - 1));
+	block->pool()->put_entry (block, ptr, idx);
+    }
+
+    virtual void release_all();         // Give back all blocks, in use or not
+    virtual int trim();                   // Give back empty blocks, if any
+
+    inline int &retain() { return _retain; }      // Whether to keep empty blocks
+    inline unsigned long block_number() { return _block_number; }
+    inline unsigned long allocated_bytes() { return _allocated_bytes; }
+
+    virtual void print_stats (const char *name);
+
+    //-------------------------------------------------------------------------
+    // Binding of pools to threads. bind() returns the previous binding.
+    //-------------------------------------------------------------------------
+
+    static inline MemPool *current() {
+	return (mem_bound_pool) ? mem_bound_pool : mem_default_pool;
+    }
+    static inline MemPool *bind (MemPool *pool) {
+	MemPool *prev_pool = mem_bound_pool;
+	mem_bound_pool = pool;
+	return prev_pool;
+    }
+
+  protected:
+
+    //-------------------------------------------------------------------------
+    // Internal functions for managing blocks.
+    //-------------------------------------------------------------------------
+
+    MemBlockPtr new_block (int idx);
+    void del_block (MemBlockPtr block);
+
+    inline void link_avail (MemBlockPtr block, int idx) {
+	block->_prev_avail = NULL;
+	block->_next_avail = _avail[idx];
+	if (_avail[idx]) { _avail[idx]->_prev_avail = block; }
+	_avail[idx] = block;
+    }
+    inline void unlink_avail (MemBlockPtr block, int idx) {
+	if (block->_prev_avail) { block->_prev_avail->_next_avail =
+				      block->_next_avail; }
+	else                    { _avail[idx] = block->_next_avail; }
+	if (block->_next_avail) { block->_next_avail->_prev_avail =
+				      block->_prev_avail; }
+	block->_prev_avail = block->_next_avail = NULL;
+    }
+    inline void put_entry (MemBlockPtr block, void *ptr, int idx) {
+	STAT(MEM_COUNT (_del_count);)
+	int was_full = block->full();
+	block->put_entry (ptr);
+	if (was_full) {
+	    link_avail (block, idx);
+	}
+	else if (!block->used() && !_retain &&
+		 (_avail[idx] != block || block->_next_avail)) {
+	    del_block (block);               // Another block has free entries
+	}
+    }
+
+    //-------------------------------------------------------------------------
+    // Internal variable definition.
+    //-------------------------------------------------------------------------
+
+    MemBlockPtr _blocks;                               // All blocks of pool
+    MemBlockPtr _avail[MEM_SIZE_NUMBER];    // Blocks w/ free entries, by size
+    int _retain;                             // Whether empty blocks are kept
+
+  protected:                                   // Variables for stats gathering
+    unsigned long _block_number;
+    unsigned long _allocated_bytes;
+    unsigned long _max_allocated_bytes;
+    STAT(unsigned long _new_count;
+	 unsigned long _del_count;)
+};
+
+
+//-----------------------------------------------------------------------------
+// Class: MemPoolScope
+//
+// Purpose: Binds a pool to the running thread while in scope.
+//-----------------------------------------------------------------------------
+
+class MemPoolScope {
+  public:
+    MemPoolScope (MemPool &pool) { _prev_pool = MemPool::bind (&pool); }
+    ~MemPoolScope() { MemPool::bind (_prev_pool); }
+
+  protected:
+    MemPool *_prev_pool;
+};
+
+#define MEM_POOL_SCOPE(pool) DMEM(MemPoolScope _mem_pool_scope (pool);)
+
+
 //-----------------------------------------------------------------------------
 // Calls memory initilization. ANY program using this software *MUST* call
-// this macro before executing any other instructions.
+// this macro before executing any other instructions. Initialization is
+// run once, even if threads call this macro concurrently.
 //-----------------------------------------------------------------------------
 
-#define MEM_MNG_INIT() \
-if(!mem_defined) { \
-   init_memory(); \
-}
+#define MEM_MNG_INIT() init_memory()
 
 
 //-----------------------------------------------------------------------------
 // Macro definitions for implementing memory management in classes of known
 // fixed size. New and delete operators are redefined. Some statistics can
 // optionally be recorded. Need to compile with option -DMEM for dedicated
-// memory management and -DSTAT for accessing stats.
+// memory management and -DSTAT for accessing stats. Counts are updated
+// atomically, as threads share classes and may share pools.
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -70,32 +266,16 @@ if(!mem_defined) { \
 DMEM( \
 public: \
     inline void *operator new(size_t _size) { \
-	if( !newList ) { \
-	    STAT(memblock_allocs++;) \
-	    newList = (ClassType*) new char[ALLOC_BLOCK_SIZE * _size]; \
-	    register int k; \
-	    for( k = 0; k < ALLOC_BLOCK_SIZE-1; k++ ) { \
-		newList[k].freePtr = &(newList[k+1]); \
-	    } \
-	    newList[k].freePtr = NULL; \
-	} \
-	STAT(new_count++;) \
-	ClassType *ret_ptr = newList; \
-	newList = newList->freePtr; \
-	return ret_ptr; \
+	STAT(MEM_COUNT (new_count);) \
+	return MemPool::current()->alloc (_size); \
     } \
-    inline void operator delete(void *ptr) { \
-	STAT(del_count++;) \
-	ClassType *ref_ptr = (ClassType*) ptr; \
-	ref_ptr->freePtr = newList; \
-	newList = ref_ptr; \
+    inline void operator delete(void *ptr, size_t _size) { \
+	STAT(MEM_COUNT (del_count);) \
+	MemPool::release (ptr, _size); \
     } \
     STAT(static void print_mem_stats();) \
 private: \
-    ClassType *freePtr; \
-    static ClassType *newList; \
     STAT( \
-	static unsigned long memblock_allocs; \
 	static unsigned long new_count; \
 	static unsigned long del_count;))
 
@@ -106,18 +286,14 @@ private: \
 
 #define MEM_MNG_DEF(ClassType, ClassName) \
 DMEM( \
-ClassType *ClassType::newList = NULL; \
 STAT( \
-unsigned long ClassType::memblock_allocs = 0; \
 unsigned long ClassType::new_count = 0; \
 unsigned long ClassType::del_count = 0;) \
 STAT( \
 void ClassType::print_mem_stats() \
 { \
     cout << "\n  Memory stats for class " << ClassName << ":\n"; \
-    cout << "    Size of class: " << sizeof(ClassType); \
-    cout << "    Number of " << ALLOC_BLOCK_SIZE << " blocks allocated: "; \
-    cout << memblock_allocs << endl; \
+    cout << "    Size of class: " << sizeof(ClassType) << endl; \
     cout << "    Number of NEW calls:    " << new_count << endl; \
     cout << "    Number of DELETE calls: " << del_count << endl; \
 }))
@@ -125,4 +301,3 @@ void ClassType::print_mem_stats() \
 #endif
 
 /*****************************************************************************/
-
@@ -6,6 +6,7 @@
 // Remarks: --
 //
 // History: 6/16/95 - JPMS - created -- adapted from other utils files.
+//          10/19/26 - agent - messages given as constant strings.
 //
 // Copyright (c) 1996 Joao P. Marques Silva.
 //-----------------------------------------------------------------------------
@@ -33,7 +34,7 @@ void setTrailString( char *str )
 //
 // Abort: Exits the program if error conditions are detected.
 //
-void Abort( char *s )
+void Abort( const char *s )
 {
     cout << "\n    " << trailer << " Error: " << s << endl;
     cout << "\tAborting Execution....\n\n" << endl;
@@ -44,7 +45,7 @@ void Abort( char *s )
 //
 // Warn: Gives a warning on an unexpected condition.
 //
-void Warn( char *s )
+void Warn( const char *s )
 {
     cout << "\n    " << trailer << " Warning: " << s << endl;
     cout << "\tContinuing Execution....\n\n" << endl;
@@ -54,7 +55,7 @@ void Warn( char *s )
 //
 // Warn: Gives a run-time information message.
 //
-void Info( char *s )
+void Info( const char *s )
 {
     cout << "\n    " << trailer << " Information: " << s << endl;
 }
@@ -75,7 +76,7 @@ void Info( char *s )
 void printItem() { cout << endl; }
 
 
-void printItem(char *str, int num)
+void printItem(const char *str, int num)
 {
     cout << "  ";
     cout.setf(ios::left,ios::adjustfield);
@@ -88,7 +89,7 @@ void printItem(char *str, int num)
 }
 
 
-void printItem(char *str, double rnum)
+void printItem(const char *str, double rnum)
 {
     cout << "  ";
     cout.setf(ios::left,ios::adjustfield);
@@ -106,7 +107,7 @@ void printItem(char *str, double rnum)
 // Prints timing information, either elapsed time or (optionally) the total
 // time.
 //
-void printTime( char *msg, double time, char *tmsg )
+void printTime( const char *msg, double time, const char *tmsg )
 {
     cout.precision(5);
     cout << "\t" << msg << ". " << tmsg << " time: " << time << endl;